@@ -105,6 +105,28 @@ unmanaged_start(command* cmd)
     sws::unmanaged_start(cmd);
 }
 
+// Schedule a list of commands for execution on either sws or kds
+// using push execution.
+size_t
+managed_start(const std::vector<command*>& cmds, std::exception_ptr& eptr)
+{
+  if (kds_enabled())
+    return kds::managed_start(cmds, eptr);
+  else
+    return sws::managed_start(cmds, eptr);
+}
+
+// Schedule a list of commands for execution on either sws or kds
+// using poll execution.
+size_t
+unmanaged_start(const std::vector<command*>& cmds, std::exception_ptr& eptr)
+{
+  if (kds_enabled())
+    return kds::unmanaged_start(cmds, eptr);
+  else
+    return sws::unmanaged_start(cmds, eptr);
+}
+
 // Wait for a command to complete execution.  This function must be
 // called in poll mode scheduling, and is safe to call in push mode.
 void
@@ -18,6 +18,7 @@
 #define xrt_core_exec_h_
 
 #include "core/common/config.h"
+#include <exception>
 #include <vector>
 #include <memory>
 
@@ -40,6 +41,28 @@ unmanaged_start(command* cmd)
   managed_start(cmd);
 }
 
+inline size_t
+managed_start(const std::vector<command*>& cmds, std::exception_ptr& eptr)
+{
+  size_t submitted = 0;
+  try {
+    for (auto cmd : cmds) {
+      managed_start(cmd);
+      ++submitted;
+    }
+  }
+  catch (...) {
+    eptr = std::current_exception();
+  }
+  return submitted;
+}
+
+inline size_t
+unmanaged_start(const std::vector<command*>& cmds, std::exception_ptr& eptr)
+{
+  return managed_start(cmds, eptr);
+}
+
 void
 unmanaged_wait(const command* cmd);
 
@@ -65,6 +88,12 @@ managed_start(command* cmd);
 void
 unmanaged_start(command* cmd);
 
+size_t
+managed_start(const std::vector<command*>& cmds, std::exception_ptr& eptr);
+
+size_t
+unmanaged_start(const std::vector<command*>& cmds, std::exception_ptr& eptr);
+
 void
 unmanaged_wait(const command* cmd);
 
@@ -97,6 +126,23 @@ XRT_CORE_COMMON_EXPORT
 void
 unmanaged_start(command* cmd);
 
+// Schedule a list of commands for execution on either sws or kds
+// using push execution.  Commands are submitted in list order and,
+// when supported by the shim, with one shim call per device.
+// Returns number of commands submitted.  If submission fails, the
+// exception is captured in @eptr and the remaining commands are not
+// submitted.
+XRT_CORE_COMMON_EXPORT
+size_t
+managed_start(const std::vector<command*>& cmds, std::exception_ptr& eptr);
+
+// Schedule a list of commands for execution on either sws or kds
+// using poll execution.  Same submission order and error handling as
+// managed_start() of a list.
+XRT_CORE_COMMON_EXPORT
+size_t
+unmanaged_start(const std::vector<command*>& cmds, std::exception_ptr& eptr);
+
 // Wait for a command to complete execution.  This function must be
 // called in poll mode (unmanaged) scheduling, and is safe to call in
 // push mode.  The function provides a thread safe interface to
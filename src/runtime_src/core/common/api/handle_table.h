@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021, Xilinx Inc - All rights reserved
+ * Xilinx Runtime (XRT) Experimental APIs
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _XRT_COMMON_HANDLE_TABLE_H_
+#define _XRT_COMMON_HANDLE_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xrt_core {
+
+// class handle_table - Thread safe table of C API handles
+//
+// Maps opaque C API handles (xrtBufferHandle, xrtRunHandle, etc.)
+// to implementation objects.  The table is split in shards each
+// with its own lock, insertions are distributed round robin over
+// the shards.
+//
+// A handle encodes the shard, the slot within the shard, and the
+// generation of the slot.  Lookup indexes the slot directly and
+// compares the generation, so lookup is constant time and a stale
+// handle, whose slot has been freed or reused, is detected rather
+// than resolving to a different object.
+//
+// Handle layout (least significant bits first):
+//   [shard:4][slot:28][generation:32]   64-bit pointers
+//   [shard:4][slot:16][generation:12]   32-bit pointers
+//
+// A handle is never nullptr.  Lookup of an unknown handle returns a
+// default constructed value (nullptr for smart pointers).
+template <typename ValueType>
+class handle_table
+{
+  static constexpr unsigned int pointer_bits = sizeof(uintptr_t) * 8;
+  static constexpr unsigned int shard_bits = 4;
+  static constexpr unsigned int slot_bits = (pointer_bits == 64) ? 28 : 16;
+  static constexpr unsigned int generation_bits = pointer_bits - shard_bits - slot_bits;
+
+  static constexpr size_t num_shards = size_t(1) << shard_bits;
+  static constexpr uintptr_t shard_mask = (uintptr_t(1) << shard_bits) - 1;
+  static constexpr uintptr_t slot_mask = (uintptr_t(1) << slot_bits) - 1;
+  static constexpr uintptr_t generation_mask = (uintptr_t(1) << generation_bits) - 1;
+
+  struct slot
+  {
+    uintptr_t generation = 1;  // never 0, so handle is never nullptr
+    bool used = false;
+    ValueType value {};
+  };
+
+  // Padded to avoid false sharing between shard locks
+  struct alignas(64) shard
+  {
+    mutable std::mutex mutex;
+    std::vector<slot> slots;
+    std::vector<uint32_t> free_slots;
+  };
+
+  std::array<shard, num_shards> m_shards;
+  std::atomic<unsigned int> m_next {0};
+
+  static void*
+  encode(uintptr_t shard, uintptr_t idx, uintptr_t generation)
+  {
+    return reinterpret_cast<void*>
+      ((generation << (shard_bits + slot_bits)) | (idx << shard_bits) | shard);
+  }
+
+  static void
+  decode(const void* handle, uintptr_t& shard, uintptr_t& idx, uintptr_t& generation)
+  {
+    auto value = reinterpret_cast<uintptr_t>(handle);
+    shard = value & shard_mask;
+    idx = (value >> shard_bits) & slot_mask;
+    generation = (value >> (shard_bits + slot_bits)) & generation_mask;
+  }
+
+public:
+  // insert() - Insert value and return its handle
+  //
+  // Throws std::length_error if the shard has no more free slots
+  void*
+  insert(ValueType value)
+  {
+    auto sidx = m_next++ & shard_mask;
+    auto& s = m_shards[sidx];
+    std::lock_guard<std::mutex> lk(s.mutex);
+
+    uintptr_t idx = 0;
+    if (!s.free_slots.empty()) {
+      idx = s.free_slots.back();
+      s.free_slots.pop_back();
+    }
+    else {
+      if (s.slots.size() > slot_mask)
+        throw std::length_error("handle table is full");
+      idx = s.slots.size();
+      s.slots.emplace_back();
+    }
+
+    auto& entry = s.slots[idx];
+    entry.used = true;
+    entry.value = std::move(value);
+    return encode(sidx, idx, entry.generation);
+  }
+
+  // find() - Look up value for handle
+  //
+  // Returns a copy of the stored value, which for shared pointers
+  // keeps the object alive even if the handle is concurrently erased.
+  // Returns default constructed value if handle is unknown or stale.
+  ValueType
+  find(const void* handle) const
+  {
+    uintptr_t sidx = 0, idx = 0, generation = 0;
+    decode(handle, sidx, idx, generation);
+    auto& s = m_shards[sidx];
+    std::lock_guard<std::mutex> lk(s.mutex);
+    if (idx >= s.slots.size())
+      return ValueType{};
+    auto& entry = s.slots[idx];
+    if (!entry.used || entry.generation != generation)
+      return ValueType{};
+    return entry.value;
+  }
+
+  // contains() - Check if handle is known
+  bool
+  contains(const void* handle) const
+  {
+    uintptr_t sidx = 0, idx = 0, generation = 0;
+    decode(handle, sidx, idx, generation);
+    auto& s = m_shards[sidx];
+    std::lock_guard<std::mutex> lk(s.mutex);
+    return idx < s.slots.size() && s.slots[idx].used && s.slots[idx].generation == generation;
+  }
+
+  // erase() - Remove handle from table
+  //
+  // Returns the removed value, or default constructed value if the
+  // handle is unknown or stale.  The value is returned so that the
+  // object is destructed by the caller outside the shard lock.
+  ValueType
+  erase(const void* handle)
+  {
+    uintptr_t sidx = 0, idx = 0, generation = 0;
+    decode(handle, sidx, idx, generation);
+    auto& s = m_shards[sidx];
+    std::lock_guard<std::mutex> lk(s.mutex);
+    if (idx >= s.slots.size())
+      return ValueType{};
+    auto& entry = s.slots[idx];
+    if (!entry.used || entry.generation != generation)
+      return ValueType{};
+
+    ValueType value = std::move(entry.value);
+    entry.value = ValueType{};
+    entry.used = false;
+    entry.generation = (entry.generation + 1) & generation_mask;
+    if (!entry.generation)
+      entry.generation = 1;
+    s.free_slots.push_back(static_cast<uint32_t>(idx));
+    return value;
+  }
+};
+
+} // xrt_core
+
+#endif
@@ -31,6 +31,8 @@
 #include <condition_variable>
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////
 // Main command execution interface for scheduling commands for
@@ -68,6 +70,36 @@ notify_host(xrt_core::command* cmd)
   notify_host(cmd, get_command_state(cmd));
 }
 
+// Check if shim can report what commands completed in exec_wait.
+// The probe uses zero timeout and does not block.  Any completions
+// reported by the probe are for commands not yet known to kds.
+static bool
+has_completion_reporting(const xrt_core::device* device)
+{
+  try {
+    std::vector<xclBufferHandle> completed;
+    device->exec_wait_completed(0, completed);
+    return true;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
+// Check if shim can submit a list of exec buffers in one call.  The
+// probe submits an empty list.
+static bool
+has_batch_submit(xrt_core::device* device)
+{
+  try {
+    device->exec_buf_list({});
+    return true;
+  }
+  catch (const std::exception&) {
+    return false;
+  }
+}
+
   
 // class kds_device - kds book keeping data for command scheduling
 //
@@ -76,13 +108,25 @@ notify_host(xrt_core::command* cmd)
 // @work_mutex: Syncrhonize monitor thread with launched commands
 // @work_cond: Kick off monitor thread when there are new commands
 // @monitor_thread: Thread for asynchronous monitoring of command execution
+// @submitted_cmds: Managed commands not yet seen by monitor thread
+// @tracked_cmds: Managed commands by exec buffer handle (completion reporting)
+// @completed_cmds: Managed commands reported completed by shim
+// @completed_handles: Scratch vector for shim completion reporting
 // @exec_wait_call_count:  Count of number of calls to exec wait
+// @completion_reporting: Shim reports exec buffer handles of completed commands
+// @batch_submit: Shim can submit a list of exec buffers in one call
 // @stop: Stop the monitor thread
 //
 // This class is per xrt_core::device. The class constructor starts a
 // command monitor thread that manages command execution.  It also
 // provides a thread safe interface to shim level exec_wait which can
 // be called explicitly to wait for command completion.
+//
+// If the shim supports completion reporting, then managed commands
+// are tracked by exec buffer handle and the monitor thread touches
+// only the commands that the shim reports as completed.  Otherwise
+// the monitor thread must check the state of every running command
+// each time exec_wait returns.
 class kds_device
 {
   xrt_core::device* device;
@@ -90,12 +134,62 @@ class kds_device
   std::mutex work_mutex;
   std::condition_variable work_cond;
   command_queue_type submitted_cmds;
+  std::unordered_map<xclBufferHandle, xrt_core::command*> tracked_cmds;
+  command_queue_type completed_cmds;
+  std::vector<xclBufferHandle> completed_handles;
   uint64_t exec_wait_call_count = 0;
+  bool completion_reporting = false;
+  bool batch_submit = false;
   bool stop = false;
 
   // thread can be constructed only after data members are initialized
   std::thread monitor_thread;  
 
+  // monitor_reported_loop() - Notify commands reported completed
+  //
+  // Used when the shim supports completion reporting.  The commands
+  // for which exec_wait returned have already been moved from
+  // tracked_cmds to completed_cmds by exec_wait, possibly by a thread
+  // other than the monitor thread.  Cost per wakeup is proportional
+  // to number of completed commands rather than number of running
+  // commands.
+  void
+  monitor_reported_loop()
+  {
+    command_queue_type notify_cmds;
+
+    while (1) {
+
+      // Larger wait synchronized with launch() and exec_wait()
+      bool wait = false;
+      {
+        std::unique_lock<std::mutex> lk(work_mutex);
+        while (!stop && tracked_cmds.empty() && completed_cmds.empty())
+          work_cond.wait(lk);
+        wait = completed_cmds.empty();
+      }
+
+      if (stop)
+        return;
+
+      // Finer wait, only if some other thread has not already
+      // collected completed commands
+      if (wait)
+        exec_wait();
+
+      {
+        std::lock_guard<std::mutex> lk(work_mutex);
+        notify_cmds.swap(completed_cmds);
+      }
+
+      // Preserve order of processing
+      for (auto cmd : notify_cmds)
+        notify_host(cmd);
+
+      notify_cmds.clear();
+    } // while (1)
+  }
+
   // monitor_loop() - Manage running commands and notify on completion
   //
   // The monitor thread services managed command and asynchronously
@@ -106,6 +200,11 @@ class kds_device
   void
   monitor_loop()
   {
+    if (completion_reporting) {
+      monitor_reported_loop();
+      return;
+    }
+
     std::vector<xrt_core::command*> busy_cmds;
     std::vector<xrt_core::command*> running_cmds;
 
@@ -182,7 +281,10 @@ class kds_device
 public:
   // Constructor starts monitor thread
   kds_device(xrt_core::device* dev)
-      : device(dev), monitor_thread(xrt_core::thread(&kds_device::monitor, this))
+      : device(dev)
+      , completion_reporting(has_completion_reporting(dev))
+      , batch_submit(has_batch_submit(dev))
+      , monitor_thread(xrt_core::thread(&kds_device::monitor, this))
   {}
 
   // Destructor stops and joins monitor thread
@@ -208,6 +310,11 @@ public:
   // local call count is different from the global count, then this
   // function resets the thread local call count and return without
   // calling shim exec_wait.
+  //
+  // With completion reporting, the managed commands reported by the
+  // shim are moved to completed_cmds for the monitor thread to
+  // notify.  Reported handles that are not managed by kds are
+  // unmanaged commands, which are checked by their waiters directly.
   void
   exec_wait()
   {
@@ -222,12 +329,43 @@ public:
       return;
     }
 
-    while (device->exec_wait(1000)==0) {}
+    if (completion_reporting)
+      exec_wait_reported();
+    else
+      while (device->exec_wait(1000)==0) {}
 
     // synchronize this thread with total call count
     thread_exec_wait_call_count = ++exec_wait_call_count;
   }
 
+  // exec_wait_reported() - Wait for shim to report completed commands
+  //
+  // Must be called with exec_wait_mutex locked.
+  void
+  exec_wait_reported()
+  {
+    while (device->exec_wait_completed(1000, completed_handles)==0) {}
+
+    bool notify = false;
+    {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      for (auto handle : completed_handles) {
+        auto itr = tracked_cmds.find(handle);
+        if (itr == tracked_cmds.end())
+          continue;
+        completed_cmds.push_back((*itr).second);
+        tracked_cmds.erase(itr);
+        notify = true;
+      }
+    }
+    completed_handles.clear();
+
+    // Kick monitor thread in case exec_wait was called by another
+    // thread while monitor is waiting on work_cond
+    if (notify)
+      work_cond.notify_one();
+  }
+
   // exec_wait() - Wait for specific command completion
   //
   // This function is safe to call for managed and unmanaged commands.
@@ -255,6 +393,38 @@ public:
     device->exec_buf(cmd->get_exec_bo());
   }
 
+  // exec_buf() - Submit a list of commands for execution
+  //
+  // Returns number of commands submitted.  If the shim supports batch
+  // submission, then all commands are submitted in one shim call,
+  // otherwise the commands are submitted one at a time.  If a command
+  // fails to submit, then the exception is captured in @eptr and the
+  // remaining commands are not submitted.
+  size_t
+  exec_buf(const command_queue_type& cmds, std::exception_ptr& eptr)
+  {
+    size_t submitted = 0;
+    try {
+      if (batch_submit) {
+        std::vector<xclBufferHandle> handles;
+        handles.reserve(cmds.size());
+        for (auto cmd : cmds)
+          handles.push_back(cmd->get_exec_bo());
+        device->exec_buf_list(handles);
+        return cmds.size();
+      }
+
+      for (auto cmd : cmds) {
+        exec_buf(cmd);
+        ++submitted;
+      }
+    }
+    catch (...) {
+      eptr = std::current_exception();
+    }
+    return submitted;
+  }
+
   // launch() - Submit a command for managed execution
   //
   // This function is used to schedule managed commands for
@@ -271,7 +441,10 @@ public:
     // See detailed explanation in monitor loop.
     {
       std::lock_guard<std::mutex> lk(work_mutex);
-      submitted_cmds.push_back(cmd);
+      if (completion_reporting)
+        tracked_cmds.emplace(cmd->get_exec_bo(), cmd);
+      else
+        submitted_cmds.push_back(cmd);
     }
 
     // Submit the command
@@ -282,7 +455,9 @@ public:
       // Remove the pending command
       std::lock_guard<std::mutex> lk(work_mutex);
       assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
-      if (!submitted_cmds.empty())
+      if (completion_reporting)
+        tracked_cmds.erase(cmd->get_exec_bo());
+      else if (!submitted_cmds.empty())
         submitted_cmds.pop_back();
       throw;
     }
@@ -291,6 +466,49 @@ public:
     // exec_buf call so that actual execution doesn't have to wait.
     work_cond.notify_one();
   }
+
+  // launch() - Submit a list of commands for managed execution
+  //
+  // Returns number of commands submitted.  All commands are recorded
+  // for completion tracking under one lock and the monitor thread is
+  // notified once for the entire list.  If submission fails part way,
+  // then the commands that were not submitted are removed from
+  // tracking and the exception is captured in @eptr.
+  size_t
+  launch(const command_queue_type& cmds, std::exception_ptr& eptr)
+  {
+    XRT_DEBUGF("xrt_core::kds::launch(%zu cmds) [new->submitted->running]\n", cmds.size());
+
+    {
+      std::lock_guard<std::mutex> lk(work_mutex);
+      for (auto cmd : cmds) {
+        if (completion_reporting)
+          tracked_cmds.emplace(cmd->get_exec_bo(), cmd);
+        else
+          submitted_cmds.push_back(cmd);
+      }
+    }
+
+    auto submitted = exec_buf(cmds, eptr);
+
+    if (eptr) {
+      // Remove the pending commands that were not submitted
+      std::lock_guard<std::mutex> lk(work_mutex);
+      for (auto itr = cmds.begin() + submitted; itr != cmds.end(); ++itr) {
+        auto cmd = (*itr);
+        assert(get_command_state(cmd)==ERT_CMD_STATE_NEW);
+        if (completion_reporting)
+          tracked_cmds.erase(cmd->get_exec_bo());
+        else
+          submitted_cmds.erase(std::remove(submitted_cmds.begin(), submitted_cmds.end(), cmd), submitted_cmds.end());
+      }
+    }
+
+    if (submitted)
+      work_cond.notify_one();
+
+    return submitted;
+  }
 }; // kds_device
 
 // Statically allocated kds_device object for each core deviced
@@ -327,6 +545,41 @@ get_kds_device(const xrt_core::command* cmd)
   return get_kds_device_or_error(cmd->get_device());
 }
 
+// Split a list of commands into runs of consecutive commands that
+// target the same device and call @submit for each run.  Returns
+// number of commands submitted, submission stops at the first run
+// that fails with the exception captured in @eptr.
+template <typename SubmitFunction>
+static size_t
+for_each_device(const command_queue_type& cmds, std::exception_ptr& eptr, SubmitFunction submit)
+{
+  if (cmds.empty())
+    return 0;
+
+  size_t submitted = 0;
+  try {
+    auto device = cmds.front()->get_device();
+    if (std::all_of(cmds.begin(), cmds.end(), [device](auto cmd) { return cmd->get_device() == device; }))
+      return submit(get_kds_device_or_error(device), cmds, eptr);
+
+    command_queue_type dcmds;
+    for (auto cmd : cmds) {
+      if (!dcmds.empty() && dcmds.front()->get_device() != cmd->get_device()) {
+        submitted += submit(get_kds_device(dcmds.front()), dcmds, eptr);
+        if (eptr)
+          return submitted;
+        dcmds.clear();
+      }
+      dcmds.push_back(cmd);
+    }
+    submitted += submit(get_kds_device(dcmds.front()), dcmds, eptr);
+  }
+  catch (...) {
+    eptr = std::current_exception();
+  }
+  return submitted;
+}
+
 } // namespace
 
 
@@ -362,6 +615,26 @@ managed_start(xrt_core::command* cmd)
   kdev->launch(cmd);
 }
 
+// Start unmanaged execution of a list of commands.  Commands are
+// submitted to their device in list order.
+size_t
+unmanaged_start(const std::vector<xrt_core::command*>& cmds, std::exception_ptr& eptr)
+{
+  return for_each_device(cmds, eptr, [](kds_device* kdev, const command_queue_type& dcmds, std::exception_ptr& ep) {
+    return kdev->exec_buf(dcmds, ep);
+  });
+}
+
+// Start managed execution of a list of commands.  Commands are
+// submitted to their device in list order.
+size_t
+managed_start(const std::vector<xrt_core::command*>& cmds, std::exception_ptr& eptr)
+{
+  return for_each_device(cmds, eptr, [](kds_device* kdev, const command_queue_type& dcmds, std::exception_ptr& ep) {
+    return kdev->launch(dcmds, ep);
+  });
+}
+
 // Alias for managed_start
 void
 schedule(xrt_core::command* cmd)
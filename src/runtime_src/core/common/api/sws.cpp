@@ -31,11 +31,15 @@
 #include "core/common/task.h"
 #include "core/common/thread.h"
 #include "core/common/xclbin_parser.h"
+#include <algorithm>
 #include <limits>
+#include <atomic>
 #include <bitset>
 #include <vector>
-#include <list>
+#include <deque>
+#include <queue>
 #include <map>
+#include <unordered_map>
 #include <mutex>
 #include <condition_variable>
 #include <cstring>
@@ -92,9 +96,12 @@ static bool cu_trace_enabled = false;
 
 ////////////////////////////////////////////////////////////////
 // Command completion for unmanaged commands
+//
+// Threads waiting in unmanaged_wait() register with the command
+// packet they wait for, so that completion wakes only those threads
 ////////////////////////////////////////////////////////////////
 static std::mutex s_cmd_complete_mutex;
-static std::condition_variable s_cmd_complete_cond;
+static std::unordered_multimap<const ert_packet*, std::condition_variable*> s_cmd_waiters;
 
 ////////////////////////////////////////////////////////////////
 // Forward declarations
@@ -142,7 +149,7 @@ public:
   xocl_cmd(exec_core* ec, cmd_ptr cmd)
     : m_cmd(cmd), m_ecmd(m_cmd->get_ert_packet()), m_exec(ec), m_state(ERT_CMD_STATE_NEW)
   {
-    static size_type count = 0;
+    static std::atomic<size_type> count {0};
     m_uid = count++;
     if (m_ecmd->type==ERT_CU) {
       m_cus |= m_kcmd->cu_mask;
@@ -171,7 +178,11 @@ public:
   {
     auto retain = m_cmd->shared_from_this();
     m_cmd->notify(ERT_CMD_STATE_COMPLETED);
-    s_cmd_complete_cond.notify_one();
+
+    std::lock_guard<std::mutex> lk(s_cmd_complete_mutex);
+    auto range = s_cmd_waiters.equal_range(m_ecmd);
+    for (auto itr = range.first; itr != range.second; ++itr)
+      itr->second->notify_one();
   }
 
   // Notify of start of cu with idx
@@ -278,6 +289,13 @@ public:
     return m_cus.test(cu_idx);
   }
 
+  // Bitset of CUs this command can execute on
+  const cu_bitset_type&
+  get_cus() const
+  {
+    return m_cus;
+  }
+
   // Get the execution core for this command object
   exec_core*
   get_exec() const
@@ -295,18 +313,6 @@ public:
 
 using xcmd_ptr = std::shared_ptr<xocl_cmd>;
 
-////////////////////////////////////////////////////////////////
-// List of new pending xocl_cmd objects
-//
-// @s_pending_cmds: populated from user space with new commands for buffer objects
-// @s_num_pending: number of pending commands
-//
-// Scheduler copies pending commands to its private queue when necessary
-////////////////////////////////////////////////////////////////
-static std::vector<xcmd_ptr> s_pending_cmds;
-static std::mutex s_pending_mutex;
-static std::atomic<unsigned int> s_num_pending {0};
-
 ////////////////////////////////////////////////////////////////
 // class xocl_cu represents a compute unit on a device
 //
@@ -329,7 +335,7 @@ static std::atomic<unsigned int> s_num_pending {0};
 class xocl_cu
 {
 private:
-  std::queue<xocl_cmd*> running_queue;
+  std::queue<xcmd_ptr> running_queue;
   xrt_core::device* xdev = nullptr;
   size_type cuidx = 0;
   addr_type addr = 0;
@@ -393,27 +399,39 @@ public:
     }
 
     return done_cnt
-      ? running_queue.front()
+      ? running_queue.front().get()
       : nullptr;
   }
 
   // Pop the first completed command off of the running queue
-  void
+  //
+  // @return
+  //   The popped command or nullptr if none
+  xcmd_ptr
   pop_done()
   {
     if (!done_cnt)
-      return;
+      return nullptr;
 
+    auto xcmd = std::move(running_queue.front());
     running_queue.pop();
     --done_cnt;
     XRT_DEBUGF("sws pop_done() popped cu(%d) done(%d) run(%d)\n",cuidx,done_cnt,run_cnt);
+    return xcmd;
+  }
+
+  // Check if there are no commands running on this CU
+  bool
+  empty() const
+  {
+    return running_queue.empty();
   }
 
   // Start the CU with a new command.
   //
   // The command is pushed onto the running queue
   void
-  start(xocl_cmd* xcmd)
+  start(xcmd_ptr xcmd)
   {
     XRT_ASSERT(!(ctrlreg & AP_START),"cu not ready");
 
@@ -446,9 +464,9 @@ public:
     else
       xdev->xwrite(addr,regmap,4);
 
-    running_queue.push(xcmd);
+    XRT_DEBUGF("started cu(%d) xcmd(%d) done(%d) run(%d)\n",cuidx,xcmd->get_uid(),done_cnt,run_cnt+1);
+    running_queue.push(std::move(xcmd));
     ++run_cnt;
-    XRT_DEBUGF("started cu(%d) xcmd(%d) done(%d) run(%d)\n",cuidx,xcmd->get_uid(),done_cnt,run_cnt);
   }
 };
 
@@ -458,11 +476,15 @@ public:
 //
 // @xdev: the xrt device on which to execute
 // @scheduler: scheduler that manages this execution core
-// @submit_queue: queue holding command that have been submitted by scheduler
+// @queued: commands waiting for a free slot in the submit queue
+// @submitted: commands in the submit queue waiting for a ready CU
 // @slot_status: bitset representing free/busy slots in submit_queue
 // @cu_usage: list of CUs managed by this execution core (device)
+// @cu_busy: bitset of CUs that were not ready when last checked
+// @cu_running: bitset of CUs with started commands
 // @num_slots: number of slots in submit queue
 // @num_cus: number of CUs on device
+// @num_active: number of commands not yet completed
 //
 // The submit queue reflects the hardware command queue such that
 // number of slots is limitted.  Once submit queue is full, the
@@ -472,9 +494,11 @@ public:
 // affect performance.
 //
 // Once a command is started on a CU it is removed from the submit
-// queue.  The command is annotated with the CU on which is has been
-// started, so scheduler will revisit the command and check for its
-// completion.
+// queue and moved to the running queue of the CU.  Completion is
+// checked per CU, and only for CUs that have running commands, so
+// the cost of scheduling does not grow with the number of queued
+// commands.  Likewise only CUs that were busy are polled when looking
+// for a ready CU.
 ////////////////////////////////////////////////////////////////
 class exec_core
 {
@@ -484,16 +508,21 @@ class exec_core
   // scheduler for this device
   xocl_scheduler* m_scheduler = nullptr;
 
-  // Commands submitted to this device, the queue is slot based
-  // and a slot becomes free when its command is started on a CU
-  xocl_cmd* submit_queue[MAX_SLOTS] = {nullptr}; // reflects ERT CQ # slots
-  std::bitset<MAX_SLOTS> slot_status;
+  // Commands waiting for a slot, and commands submitted to this
+  // device.  The submit queue is slot based and a slot becomes free
+  // when its command is started on a CU
+  std::deque<xcmd_ptr> queued;
+  std::deque<xcmd_ptr> submitted;
+  std::bitset<MAX_SLOTS> slot_status; // reflects ERT CQ # slots
 
   // Compute units on this device
   std::vector<std::unique_ptr<xocl_cu>> cu_usage;
+  cu_bitset_type cu_busy;
+  cu_bitset_type cu_running;
 
   size_type num_slots = 0;
   size_type num_cus = 0;
+  size_type num_active = 0;
 
 public:
   exec_core(xrt_core::device* xdev, xocl_scheduler* xs, size_t slots, const std::vector<addr_type>& cu_amap)
@@ -511,6 +540,14 @@ public:
     return m_scheduler;
   }
 
+  // Number of commands managed by this execution core that have
+  // not yet completed
+  size_type
+  active() const
+  {
+    return num_active;
+  }
+
   // Get a free slot index into submit queue
   //
   // @return
@@ -536,95 +573,136 @@ public:
     slot_status.reset(slot_idx);
   }
 
-  // Submit a command to this exec core
-  //
-  // Submit fails if there is no room in submit queue
-  //
-  // @return
-  //   True if submitted successfully, false otherwise
-  bool
-  submit(xocl_cmd* xcmd)
+  // Queue a new command on this exec core
+  void
+  queue(xcmd_ptr xcmd)
   {
-    if (slot_status.all())
-      return false;
-
-    auto slot_idx = acquire_slot_idx();
-    if (slot_idx==no_index)
-      return false;
+    XRT_DEBUGF("xcmd(%d) [new->queued]\n",xcmd->get_uid());
+    xcmd->set_int_state(ERT_CMD_STATE_QUEUED);
+    queued.push_back(std::move(xcmd));
+    ++num_active;
+  }
 
-    xcmd->slotidx = slot_idx;
-    submit_queue[slot_idx]=xcmd;
+  // Submit queued commands in order while there are free slots
+  void
+  submit()
+  {
+    while (!queued.empty()) {
+      auto slot_idx = acquire_slot_idx();
+      if (slot_idx==no_index)
+        return;
 
-    return true;
+      auto& xcmd = queued.front();
+      XRT_DEBUGF("xcmd(%d) [queued->submitted]\n",xcmd->get_uid());
+      xcmd->slotidx = slot_idx;
+      xcmd->set_int_state(ERT_CMD_STATE_SUBMITTED);
+      submitted.push_back(std::move(xcmd));
+      queued.pop_front();
+    }
   }
 
-  // Start a command on first available ready CU
+  // Bitset of CUs that are ready to start a command
   //
-  // @return
-  //  True if started successfully, false otherwise
-  bool
-  penguin_start(xocl_cmd* xcmd)
+  // Only CUs that were busy when last checked are polled
+  cu_bitset_type
+  ready_cus()
   {
-    // Find a ready CU
-    for (size_type cuidx=0; cuidx<num_cus; ++cuidx) {
-      auto& cu = cu_usage[cuidx];
-      if (xcmd->has_cu(cuidx) && cu->ready()) {
-        xcmd->cuidx = cuidx;
-        cu->start(xcmd);
-        return true;
-      }
+    for (size_type cuidx=0; cuidx<num_cus && cu_busy.any(); ++cuidx) {
+      if (cu_busy.test(cuidx) && cu_usage[cuidx]->ready())
+        cu_busy.reset(cuidx);
     }
-    return false;
+
+    cu_bitset_type ready;
+    for (size_type cuidx=0; cuidx<num_cus; ++cuidx)
+      ready.set(cuidx);
+    return ready & ~cu_busy;
   }
 
-  // Start a command on first available ready CU
-  //
-  // @return
-  //  True if started successfully, false otherwise
-  bool
-  start(xocl_cmd* xcmd)
+  // Start submitted commands in order, each on the first
+  // available ready CU
+  void
+  start()
   {
-    if (penguin_start(xcmd)) {
-      submit_queue[xcmd->slotidx]=nullptr;
+    if (submitted.empty())
+      return;
+
+    auto ready = ready_cus();
+    for (auto itr=submitted.begin(); itr!=submitted.end() && ready.any(); ) {
+      auto& xcmd = (*itr);
+      auto cus = xcmd->get_cus() & ready;
+      if (cus.none()) {
+        ++itr;
+        continue;
+      }
+
+      size_type cuidx = 0;
+      while (!cus.test(cuidx))
+        ++cuidx;
+
+      XRT_DEBUGF("xcmd(%d) [submitted->running]\n",xcmd->get_uid());
       release_slot_idx(xcmd->slotidx);
-      return true;
+      xcmd->cuidx = cuidx;
+      xcmd->set_int_state(ERT_CMD_STATE_RUNNING);
+      cu_usage[cuidx]->start(std::move(xcmd));
+      itr = submitted.erase(itr);
+
+      ready.reset(cuidx);
+      cu_busy.set(cuidx);
+      cu_running.set(cuidx);
     }
-    return false;
   }
 
-  // Check if a command has completed execution
+  // Complete all commands that are done on their CU.
   //
-  // It is precond that command has been started, so the CU that executes
-  // the command is indicated by the cuidx in the command.  Simply check
-  // if the first completed command in the CU is the argument command
-  // and if so pop it off the CU.
+  // Each CU completes its commands in the order they were started
   //
   // @return
-  //   True if completed, false otherwise
-  bool
-  penguin_query(xocl_cmd* xcmd)
+  //   Number of commands completed
+  size_type
+  complete()
   {
-    // no point to query a command
-    auto& cu = cu_usage[xcmd->cuidx];
-    if (cu->get_done()==xcmd) {
-      cu->pop_done();
-      return true;
+    size_type completed = 0;
+    for (size_type cuidx=0; cuidx<num_cus && cu_running.any(); ++cuidx) {
+      if (!cu_running.test(cuidx))
+        continue;
+
+      auto& cu = cu_usage[cuidx];
+      while (!cu->empty() && cu->get_done()) {
+        auto xcmd = cu->pop_done();
+        XRT_DEBUGF("xcmd(%d) [running->complete]\n",xcmd->get_uid());
+        xcmd->set_state(ERT_CMD_STATE_COMPLETED);
+        xcmd->notify_host();
+        ++completed;
+      }
+
+      if (cu->empty())
+        cu_running.reset(cuidx);
     }
-    return false;
+
+    num_active -= completed;
+    return completed;
   }
 
-  // Check if a command has completed execution
-  bool
-  query(xocl_cmd* xcmd)
+  // Advance all commands of this exec core as far as possible
+  //
+  // @return
+  //   Number of commands completed
+  size_type
+  schedule()
   {
-    return penguin_query(xcmd);
+    auto completed = complete();
+    submit();
+    start();
+    return completed;
   }
 };
 
 ////////////////////////////////////////////////////////////////
 // class xocl_scheduler: The scheduler data structure
 //
-// @m_command_queue: all the commands managed by scheduler
+// @m_pending: new commands from user threads
+// @m_execs: execution cores managed by this scheduler
+// @m_active: commands queued on the execution cores and not completed
 //
 // The scheduler babysits all commands launched by user. It
 // transitions the commands from state to state until the command
@@ -635,9 +713,10 @@ public:
 // a scheduler can manage any number of cores.  Because the scheduler
 // is the only client of an exec_core, and exec_core is the only
 // client of xocl_cu, no locking is necessary is any of the data
-// structures.  Exception is the pending command list which is copied
-// to the scheduler command queue, the pending list is populated by
-// user thread, and harvested by scheduler thread.
+// structures.  Exception is the pending command list which is moved
+// to the execution cores, the pending list is populated by user
+// thread, and harvested by scheduler thread, and the list of
+// execution cores which is modified when a device is initialized.
 ////////////////////////////////////////////////////////////////
 class xocl_scheduler
 {
@@ -645,112 +724,42 @@ class xocl_scheduler
   std::condition_variable    m_work;
 
   bool                       m_stop = false;
-  std::list<xcmd_ptr>        m_command_queue;
+  std::vector<xcmd_ptr>      m_pending;
+  std::vector<xcmd_ptr>      m_queue; // harvested pending commands
+
+  std::mutex                 m_exec_mutex;
+  std::vector<exec_core*>    m_execs;
+  std::atomic<size_t>        m_active {0};
 
   // if command has completed in the iteration
   bool                       m_cmd_completed = false;
 
-  // Copy pending commands into command queue.
+  // Move pending commands to their execution cores.
   void
   queue_cmds()
   {
-    std::lock_guard<std::mutex> lk(s_pending_mutex);
-    for (auto itr=s_pending_cmds.begin(); itr!=s_pending_cmds.end(); ) {
-      auto xcmd = (*itr);
-      auto exec = xcmd->get_exec();
-      if (exec->get_scheduler()==this) {
-        XRT_DEBUGF("xcmd(%d) [new->queued]\n",xcmd->get_uid());
-        itr = s_pending_cmds.erase(itr);
-        xcmd->set_int_state(ERT_CMD_STATE_QUEUED);
-        m_command_queue.push_back(std::move(xcmd));
-      }
-      else {
-        ++itr;
-      }
-    }
-    s_num_pending = s_pending_cmds.size();
-  }
-
-  // Transition command to submitted state if possible
-  bool
-  queued_to_submitted(const xcmd_ptr& xcmd)
-  {
-    bool retval = false;
-    auto exec = xcmd->get_exec();
-    if (exec->submit(xcmd.get())) {
-      XRT_DEBUGF("xcmd(%d) [queued->submitted]\n",xcmd->get_uid());
-      xcmd->set_int_state(ERT_CMD_STATE_SUBMITTED);
-      retval = true;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      std::swap(m_pending, m_queue);
     }
-    return retval;
-  }
 
-  // Transition command to running state if possible
-  bool
-  submitted_to_running(const xcmd_ptr& xcmd)
-  {
-    bool retval = false;
-    auto exec = xcmd->get_exec();
-    if (exec->start(xcmd.get())) {
-      XRT_DEBUGF("xcmd(%d) [submitted->running]\n",xcmd->get_uid());
-      xcmd->set_int_state(ERT_CMD_STATE_RUNNING);
-      retval = true;
+    for (auto& xcmd : m_queue) {
+      xcmd->get_exec()->queue(std::move(xcmd));
+      ++m_active;
     }
-    return retval;
-  }
-
-  // Transition command to complete state if command has completed
-  bool
-  running_to_complete(const xcmd_ptr& xcmd)
-  {
-    bool retval = false;
-    auto exec = xcmd->get_exec();
-    if (exec->query(xcmd.get())) {
-      XRT_DEBUGF("xcmd(%d) [running->complete]\n",xcmd->get_uid());
-      xcmd->set_state(ERT_CMD_STATE_COMPLETED);
-      xcmd->notify_host();
-      retval = true;
-    }
-    return retval;
-  }
-
-  // Free a command
-  bool
-#ifdef XRT_VERBOSE
-  complete_to_free(const xcmd_ptr& xcmd)
-#else
-  complete_to_free(const xcmd_ptr&)
-#endif
-  {
-    XRT_DEBUGF("xcmd(%d) [complete->free]\n",xcmd->get_uid());
-    return true;
+    m_queue.clear();
   }
 
-  // Iterate command queue and baby sit all commands
+  // Iterate execution cores and baby sit their commands
   void
   iterate_cmds()
   {
-    auto end = m_command_queue.end();
-    auto nitr = m_command_queue.begin();
-    m_cmd_completed = false;
-    for (auto itr=nitr; itr!=end; itr=nitr) {
-      auto& xcmd = (*itr);
-      if (xcmd->get_state() == ERT_CMD_STATE_QUEUED)
-        queued_to_submitted(xcmd);
-      if (xcmd->get_state() == ERT_CMD_STATE_SUBMITTED)
-        submitted_to_running(xcmd);
-      if (xcmd->get_state() == ERT_CMD_STATE_RUNNING)
-        running_to_complete(xcmd);
-      if (xcmd->get_state() == ERT_CMD_STATE_COMPLETED) {
-        complete_to_free(xcmd);
-        nitr = m_command_queue.erase(itr);
-        end = m_command_queue.end();
-        m_cmd_completed = true;
-        continue;
-      }
-
-      nitr = ++itr;
-    }
+    std::lock_guard<std::mutex> lk(m_exec_mutex);
+    size_t completed = 0;
+    for (auto exec : m_execs)
+      completed += exec->schedule();
+    m_active -= completed;
+    m_cmd_completed = completed > 0;
   }
 
   // Wait until something interesting happens
@@ -758,17 +767,19 @@ class xocl_scheduler
   wait()
   {
     std::unique_lock<std::mutex> lk(m_mutex);
-    while (!m_stop && !s_num_pending && m_command_queue.empty())
+    while (!m_stop && m_pending.empty() && !m_active)
       m_work.wait(lk);
 
     if (m_stop) {
-      if (!m_command_queue.empty() || s_num_pending)
+      if (m_active || !m_pending.empty())
         throw std::runtime_error("software scheduler stopping while there are active commands");
     }
 
-    if (s_num_pending || m_cmd_completed)
+    if (!m_pending.empty() || m_cmd_completed)
       return;
 
+    lk.unlock();
+
     // Sleep if no new pending commands or no running command have completed
     // throttle polling for cu completion
     if (auto us = xrt_core::config::get_polling_throttle())
@@ -787,13 +798,43 @@ class xocl_scheduler
 
 public:
 
-  // Wake up the scheduler if it is waiting
+  // Add a new command to this scheduler and wake it up
   void
-  notify()
+  add_cmd(xcmd_ptr xcmd)
   {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_pending.push_back(std::move(xcmd));
     m_work.notify_one();
   }
 
+  // Add an execution core to this scheduler
+  void
+  add_exec(exec_core* exec)
+  {
+    std::lock_guard<std::mutex> lk(m_exec_mutex);
+    m_execs.push_back(exec);
+  }
+
+  // Remove an execution core from this scheduler
+  void
+  remove_exec(exec_core* exec)
+  {
+    std::lock_guard<std::mutex> lk(m_exec_mutex);
+    auto itr = std::find(m_execs.begin(), m_execs.end(), exec);
+    if (itr == m_execs.end())
+      return;
+    m_active -= exec->active();
+    m_execs.erase(itr);
+  }
+
+  // Number of execution cores managed by this scheduler
+  size_t
+  num_execs()
+  {
+    std::lock_guard<std::mutex> lk(m_exec_mutex);
+    return m_execs.size();
+  }
+
   // Run the scheduler until it is stopped
   void
   run()
@@ -814,9 +855,10 @@ public:
 };
 
 ////////////////////////////////////////////////////////////////
-// One static scheduler currently on a single thread
-static xocl_scheduler s_global_scheduler;
-static std::thread s_scheduler_thread;
+// Schedulers each on their own thread, execution cores are
+// distributed over the schedulers
+static std::vector<std::unique_ptr<xocl_scheduler>> s_schedulers;
+static std::vector<std::thread> s_scheduler_threads;
 static bool s_running=false;
 
 // Each device has a execution core
@@ -824,9 +866,20 @@ static std::map<const xrt_core::device*, std::unique_ptr<exec_core>> s_device_ex
 
 // Thread routine for scheduler loop
 static void
-scheduler_loop()
+scheduler_loop(xocl_scheduler* scheduler)
+{
+  scheduler->run();
+}
+
+// Scheduler with fewest execution cores
+static xocl_scheduler*
+get_scheduler()
 {
-  s_global_scheduler.run();
+  xocl_scheduler* retval = nullptr;
+  for (auto& scheduler : s_schedulers)
+    if (!retval || scheduler->num_execs() < retval->num_execs())
+      retval = scheduler.get();
+  return retval;
 }
 
 } // namespace
@@ -840,12 +893,7 @@ managed_start(xrt_core::command* cmd)
 
   auto& exec = s_device_exec_core[device];
   auto xcmd = xocl_cmd::create(exec.get(),cmd);
-  auto scheduler = exec->get_scheduler();
-
-  std::lock_guard<std::mutex> lk(s_pending_mutex);
-  s_pending_cmds.push_back(xcmd);
-  ++s_num_pending;
-  scheduler->notify();
+  exec->get_scheduler()->add_cmd(std::move(xcmd));
 }
 
 // The software scheduler manages all command execution but upper
@@ -857,8 +905,14 @@ unmanaged_wait(const xrt_core::command* cmd)
 {
   auto ert_pkt = cmd->get_ert_packet();
   std::unique_lock<std::mutex> lk(s_cmd_complete_mutex);
+  if (ert_pkt->state >= ERT_CMD_STATE_COMPLETED)
+    return;
+
+  std::condition_variable cmd_complete;
+  auto itr = s_cmd_waiters.emplace(ert_pkt, &cmd_complete);
   while (ert_pkt->state < ERT_CMD_STATE_COMPLETED)
-    s_cmd_complete_cond.wait(lk);
+    cmd_complete.wait(lk);
+  s_cmd_waiters.erase(itr);
 }
 
 void
@@ -867,7 +921,11 @@ start()
   if (s_running)
     throw std::runtime_error("software command scheduler is already started");
 
-  s_scheduler_thread = xrt_core::thread(scheduler_loop);
+  auto threads = std::max(1u, xrt_core::config::get_sws_threads());
+  for (unsigned int idx=0; idx<threads; ++idx) {
+    s_schedulers.push_back(std::make_unique<xocl_scheduler>());
+    s_scheduler_threads.push_back(xrt_core::thread(scheduler_loop, s_schedulers.back().get()));
+  }
   s_running = true;
 }
 
@@ -877,9 +935,12 @@ stop()
   if (!s_running)
     return;
 
-  s_global_scheduler.stop();
-  s_scheduler_thread.join();
+  for (auto& scheduler : s_schedulers)
+    scheduler->stop();
+  for (auto& thread : s_scheduler_threads)
+    thread.join();
 
+  s_scheduler_threads.clear();
   s_running = false;
 }
 
@@ -910,10 +971,19 @@ init(xrt_core::device* xdev)
   // create execution core for this device
   cu_trace_enabled = xrt_core::config::get_profile() || xrt_core::config::get_opencl_summary();
 
-  s_device_exec_core.erase(xdev);
-  s_device_exec_core.insert
-    (std::make_pair
-     (xdev,std::make_unique<exec_core>(xdev,&s_global_scheduler,slots,amap)));
+  auto itr = s_device_exec_core.find(xdev);
+  if (itr != s_device_exec_core.end()) {
+    itr->second->get_scheduler()->remove_exec(itr->second.get());
+    s_device_exec_core.erase(itr);
+  }
+
+  auto scheduler = get_scheduler();
+  if (!scheduler)
+    throw std::runtime_error("software command scheduler is not started");
+
+  auto exec = std::make_unique<exec_core>(xdev,scheduler,slots,amap);
+  scheduler->add_exec(exec.get());
+  s_device_exec_core.insert(std::make_pair(xdev,std::move(exec)));
 }
 
 }} // sws,xrt
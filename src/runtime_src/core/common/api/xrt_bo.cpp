@@ -25,18 +25,27 @@
 #include "bo.h"
 
 #include "device_int.h"
+#include "enqueue.h"
+#include "handle_table.h"
 #include "kernel_int.h"
+#include "core/common/config_reader.h"
 #include "core/common/device.h"
 #include "core/common/memalign.h"
 #include "core/common/message.h"
 #include "core/common/query_requests.h"
 #include "core/common/system.h"
+#include "core/common/task.h"
+#include "core/common/thread.h"
 #include "core/common/unistd.h"
 #include "core/common/xclbin_parser.h"
 
+#include <condition_variable>
 #include <cstdlib>
 #include <map>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 # pragma warning( disable : 4244 4100 4996 4505 )
@@ -620,24 +629,105 @@ public:
   }
 };
 
+// class bo_async_impl - Asynchronous sync of a buffer object
+//
+// The sync is executed by a DMA worker thread.  Upon completion the
+// handle is marked done and an event, if any, is notified.  The impl
+// object retains ownership of the buffer until the sync completes.
+class bo_async_impl
+{
+  std::shared_ptr<bo_impl> m_bo;
+  xclBOSyncDirection m_dir;
+  size_t m_size;
+  size_t m_offset;
+
+  mutable std::mutex m_mutex;
+  mutable std::condition_variable m_done_cond;
+  mutable std::shared_ptr<event_impl> m_event;
+  std::exception_ptr m_exception;
+  bool m_done = false;
+
+public:
+  bo_async_impl(std::shared_ptr<bo_impl> bo, xclBOSyncDirection dir, size_t sz, size_t offset)
+    : m_bo(std::move(bo)), m_dir(dir), m_size(sz), m_offset(offset)
+  {}
+
+  // Execute the sync, called by DMA worker thread
+  void
+  run()
+  {
+    std::exception_ptr eptr;
+    try {
+      m_bo->sync(m_dir, m_size, m_offset);
+    }
+    catch (...) {
+      eptr = std::current_exception();
+    }
+
+    std::shared_ptr<event_impl> event;
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_exception = eptr;
+      m_done = true;
+      m_bo.reset();
+      std::swap(event, m_event);
+      m_done_cond.notify_all();
+    }
+
+    // lock must not be held while notifying event
+    if (event)
+      xrt_core::enqueue::done(event.get());
+  }
+
+  void
+  wait() const
+  {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    while (!m_done)
+      m_done_cond.wait(lk);
+    if (m_exception)
+      std::rethrow_exception(m_exception);
+  }
+
+  bool
+  ready() const
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_done;
+  }
+
+  void
+  set_event(const std::shared_ptr<event_impl>& event) const
+  {
+    {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      if (!m_done) {
+        m_event = event;
+        return;
+      }
+    }
+    xrt_core::enqueue::done(event.get());
+  }
+};
+
 } // namespace xrt
 
 // Implementation details
 namespace {
 
 // C-API handles that must be explicitly closed. Corresponding managed
-// handles are inserted in this map.  When the unmanaged handle is
-// closed, it is removed from this map and underlying buffer is
+// handles are inserted in this table.  When the unmanaged handle is
+// closed, it is removed from this table and underlying buffer is
 // deleted if no other shared ptrs exists for this buffer
-static std::map<xrtBufferHandle, std::shared_ptr<xrt::bo_impl>> bo_cache;
+static xrt_core::handle_table<std::shared_ptr<xrt::bo_impl>> bo_cache;
 
-static const std::shared_ptr<xrt::bo_impl>&
+static std::shared_ptr<xrt::bo_impl>
 get_boh(xrtBufferHandle bhdl)
 {
-  auto itr = bo_cache.find(bhdl);
-  if (itr == bo_cache.end())
+  auto boh = bo_cache.find(bhdl);
+  if (!boh)
     throw xrt_core::error(-EINVAL, "No such buffer handle");
-  return (*itr).second;
+  return boh;
 }
 
 static xclBufferHandle
@@ -659,7 +749,7 @@ alloc_bo(xclDeviceHandle dhdl, size_t sz, xrtBufferFlags flags, xrtMemoryGroup g
 static void
 free_bo(xrtBufferHandle bhdl)
 {
-  if (bo_cache.erase(bhdl) == 0)
+  if (!bo_cache.erase(bhdl))
     throw std::runtime_error("Unexpected internal error");
 }
 
@@ -809,7 +899,79 @@ adjust_buffer_flags(xclDeviceHandle dhdl, xrt::bo::flags flags, xrt::memory_grou
     return adjust_buffer_flags(xrt::device{dhdl}, flags, grp);
   return static_cast<xrtBufferFlags>(flags);
 }
-  
+
+} // namespace
+
+namespace xrt_core {
+
+// class dma_queues - Per device DMA worker queues for async sync
+//
+// One task queue per sync direction, each serviced by the number
+// of worker threads specified by Runtime.dma_channels (default 2).
+// The queues are created on first async sync for a device and are
+// owned by the device.
+//
+// The workers share ownership of the task queues.  A worker that
+// completes an async sync can release the last reference to the
+// device, in which case the worker is detached rather than joined
+// and exits once it finds its queue stopped.
+class dma_queues
+{
+  std::shared_ptr<task::queue> m_to_device;
+  std::shared_ptr<task::queue> m_from_device;
+  std::vector<std::thread> m_workers;
+
+  static std::thread
+  start_worker(std::shared_ptr<task::queue> queue, const char* id)
+  {
+    return xrt_core::thread([queue, id] { task::worker2(*queue, id); });
+  }
+
+public:
+  dma_queues()
+    : m_to_device(std::make_shared<task::queue>())
+    , m_from_device(std::make_shared<task::queue>())
+  {
+    auto threads = xrt_core::config::get_dma_threads();
+    if (!threads)
+      threads = 2;
+
+    for (unsigned int i = 0; i < threads; ++i) {
+      m_workers.emplace_back(start_worker(m_to_device, "write"));
+      m_workers.emplace_back(start_worker(m_from_device, "read"));
+    }
+  }
+
+  ~dma_queues()
+  {
+    m_to_device->stop();
+    m_from_device->stop();
+    for (auto& t : m_workers) {
+      if (t.get_id() == std::this_thread::get_id())
+        t.detach();
+      else
+        t.join();
+    }
+  }
+
+  void
+  add(const std::shared_ptr<xrt::bo_async_impl>& impl, xclBOSyncDirection dir)
+  {
+    auto& queue = (dir == XCL_BO_SYNC_BO_TO_DEVICE) ? m_to_device : m_from_device;
+    queue->addWork(task::task([impl] { impl->run(); }));
+  }
+};
+
+} // namespace xrt_core
+
+namespace {
+
+// Get or create DMA queues for a device
+static std::shared_ptr<xrt_core::dma_queues>
+get_dma_queues(const xrt_core::device* device)
+{
+  return device->get_dma_queues([] { return std::make_shared<xrt_core::dma_queues>(); });
+}
 
 } // namespace
 
@@ -943,6 +1105,44 @@ sync(xclBOSyncDirection dir, size_t size, size_t offset)
     });
 }
 
+bo::async_handle
+bo::
+async(xclBOSyncDirection dir, size_t size, size_t offset)
+{
+  return xdp::native::profiling_wrapper("xrt::bo::async", [this, dir, size, offset]{
+    auto impl = std::make_shared<bo_async_impl>(handle, dir, size, offset);
+    get_dma_queues(handle->get_device())->add(impl, dir);
+    return async_handle(impl);
+  });
+}
+
+void
+bo::async_handle::
+wait() const
+{
+  if (handle)
+    handle->wait();
+}
+
+bool
+bo::async_handle::
+ready() const
+{
+  return handle ? handle->ready() : true;
+}
+
+void
+bo::async_handle::
+set_event(const std::shared_ptr<event_impl>& event) const
+{
+  // An empty handle has nothing to wait for
+  if (!handle) {
+    xrt_core::enqueue::done(event.get());
+    return;
+  }
+  handle->set_event(event);
+}
+
 void*
 bo::
 map()
@@ -1009,8 +1209,7 @@ xrtBOAllocUserPtr(xrtDeviceHandle dhdl, void* userptr, size_t size, xrtBufferFla
     return xdp::native::profiling_wrapper(__func__,
     [dhdl, userptr, size, flags, grp]{
       auto boh = alloc_userptr(get_xcl_device_handle(dhdl), userptr, size, flags, grp);
-      bo_cache[boh.get()] = boh;
-      return boh.get();
+      return bo_cache.insert(std::move(boh));
     });
   }
   catch (const xrt_core::error& ex) {
@@ -1031,8 +1230,7 @@ xrtBOAlloc(xrtDeviceHandle dhdl, size_t size, xrtBufferFlags flags, xrtMemoryGro
     return xdp::native::profiling_wrapper(__func__,
     [dhdl, size, flags, grp]{
       auto boh = alloc(get_xcl_device_handle(dhdl), size, flags, grp);
-      bo_cache[boh.get()] = boh;
-      return boh.get();
+      return bo_cache.insert(std::move(boh));
     });
   }
   catch (const xrt_core::error& ex) {
@@ -1052,8 +1250,7 @@ xrtBOSubAlloc(xrtBufferHandle phdl, size_t sz, size_t offset)
     return xdp::native::profiling_wrapper(__func__, [phdl, sz, offset]{
       const auto& parent = get_boh(phdl);
       auto boh = alloc_sub(parent, sz, offset);
-      bo_cache[boh.get()] = boh;
-      return boh.get();
+      return bo_cache.insert(std::move(boh));
     });
   }
   catch (const xrt_core::error& ex) {
@@ -1072,8 +1269,7 @@ xrtBOImport(xrtDeviceHandle dhdl, xclBufferExportHandle ehdl)
   try {
     return xdp::native::profiling_wrapper(__func__, [dhdl, ehdl]{
       auto boh = alloc_import(get_xcl_device_handle(dhdl), ehdl);
-      bo_cache[boh.get()] = boh;
-      return boh.get();
+      return bo_cache.insert(std::move(boh));
     });
   }
   catch (const xrt_core::error& ex) {
@@ -30,9 +30,11 @@
 #include "core/common/query_requests.h"
 
 #include "xclbin_int.h" // Non public xclbin APIs
+#include "handle_table.h"
 #include "native_profile.h"
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include <fstream>
 
@@ -43,26 +45,56 @@
 namespace {
 
 // C-API handles that must be explicitly closed. Corresponding managed
-// handles are inserted in this map.  When the unmanaged handle is
-// closed, it is removed from this map and underlying buffer is
-// deleted if no other shared ptrs exists for this buffer
-static std::map<xrtDeviceHandle, std::shared_ptr<xrt_core::device>> device_cache;
+// handles are inserted in this table.  When the unmanaged handle is
+// closed, it is removed from this table and underlying device is
+// deleted if no other shared ptrs exists for this device
+static xrt_core::handle_table<std::shared_ptr<xrt_core::device>> device_cache;
+
+// There is at most one C-API handle per core device.  This map is
+// used only when opening and closing handles, lookup of a handle
+// goes through the handle table.
+static std::map<const xrt_core::device*, xrtDeviceHandle> device_handles;
+static std::mutex device_handles_mutex;
 
 static std::shared_ptr<xrt_core::device>
 get_device(xrtDeviceHandle dhdl)
 {
-  auto itr = device_cache.find(dhdl);
-  if (itr == device_cache.end())
+  auto device = device_cache.find(dhdl);
+  if (!device)
     throw xrt_core::error(-EINVAL, "No such device handle");
-  return (*itr).second;
+  return device;
 }
 
+// Get handle for core device, allocate new handle if none exists.
+// Throws if @exclusive and a handle already exists.
+static xrtDeviceHandle
+insert_device_handle(std::shared_ptr<xrt_core::device> device, bool exclusive)
+{
+  std::lock_guard<std::mutex> lk(device_handles_mutex);
+  auto itr = device_handles.find(device.get());
+  if (itr != device_handles.end()) {
+    if (exclusive)
+      throw xrt_core::error(EINVAL, "Handle is already in use");
+    return (*itr).second;
+  }
+
+  auto key = device.get();
+  auto dhdl = device_cache.insert(std::move(device));
+  device_handles.emplace(key, dhdl);
+  return dhdl;
+}
 
 static void
 free_device(xrtDeviceHandle dhdl)
 {
-  if (device_cache.erase(dhdl) == 0)
-    throw xrt_core::error(-EINVAL, "No such device handle");
+  std::shared_ptr<xrt_core::device> device;
+  {
+    std::lock_guard<std::mutex> lk(device_handles_mutex);
+    device = device_cache.erase(dhdl);
+    if (!device)
+      throw xrt_core::error(-EINVAL, "No such device handle");
+    device_handles.erase(device.get());
+  }
 }
 
 inline void
@@ -333,8 +365,7 @@ xrtDeviceOpen(unsigned int index)
   try {
     return xdp::native::profiling_wrapper(__func__, [index]{
       auto device = xrt_core::get_userpf_device(index);
-      device_cache[device.get()] = device;
-      return device.get();
+      return insert_device_handle(std::move(device), false);
     });
   }
   catch (const xrt_core::error& ex) {
@@ -515,10 +546,7 @@ xrtDeviceOpenFromXcl(xclDeviceHandle dhdl)
 
       // Only one xrt unmanaged device per xclDeviceHandle
       // xrtDeviceClose removes the handle from the cache
-      if (device_cache.count(device.get()))
-        throw xrt_core::error(EINVAL, "Handle is already in use");
-      device_cache[device.get()] = device;
-      return device.get();
+      return insert_device_handle(std::move(device), true);
     });
   }
   catch (const xrt_core::error& ex) {
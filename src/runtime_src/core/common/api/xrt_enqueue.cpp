@@ -22,11 +22,12 @@
 
 #include "core/common/debug.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <vector>
-#include <queue>
-#include <unordered_set>
-#include <set>
 #include <functional>
 #include <algorithm>
 #include <thread>
@@ -38,6 +39,90 @@
 
 namespace {
 
+// class mpmc_queue - bounded lock free multi producer multi consumer queue
+//
+// Each cell carries a sequence number that tells producers and
+// consumers whether the cell is free for the current lap of the
+// ring.  Producers and consumers claim positions with a CAS on their
+// own counter, so neither side takes a lock.
+template <typename ValueType>
+class mpmc_queue
+{
+  struct cell
+  {
+    std::atomic<size_t> m_seq;
+    ValueType m_value;
+  };
+
+  std::unique_ptr<cell[]> m_cells;
+  size_t m_mask;
+  alignas(64) std::atomic<size_t> m_push_pos {0};
+  alignas(64) std::atomic<size_t> m_pop_pos {0};
+
+public:
+  // Capacity must be a power of two
+  explicit
+  mpmc_queue(size_t capacity)
+    : m_cells(new cell[capacity])
+    , m_mask(capacity - 1)
+  {
+    for (size_t i = 0; i < capacity; ++i)
+      m_cells[i].m_seq.store(i, std::memory_order_relaxed);
+  }
+
+  // Return false if the queue is full
+  bool
+  try_push(ValueType value)
+  {
+    auto pos = m_push_pos.load(std::memory_order_relaxed);
+    cell* c = nullptr;
+    while (true) {
+      c = &m_cells[pos & m_mask];
+      auto seq = c->m_seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = m_push_pos.load(std::memory_order_relaxed);
+      }
+    }
+    c->m_value = value;
+    c->m_seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Return false if the queue is empty
+  bool
+  try_pop(ValueType& value)
+  {
+    auto pos = m_pop_pos.load(std::memory_order_relaxed);
+    cell* c = nullptr;
+    while (true) {
+      c = &m_cells[pos & m_mask];
+      auto seq = c->m_seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (m_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0) {
+        return false;
+      }
+      else {
+        pos = m_pop_pos.load(std::memory_order_relaxed);
+      }
+    }
+    value = c->m_value;
+    c->m_seq.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+  }
+};
+
 }
 
 namespace xrt {
@@ -48,9 +133,10 @@ namespace xrt {
 // objects, e.g. kernel run objects such that the event can be
 // notified upon completion of the asynchronous operation.
 // 
-// Objects of event_impl are inserted into an event_queue_impl
-// which participates in the ownership of the event.  The event
-// is removed from the queue when it is complete.
+// An event that waits for dependencies is owned by the events it
+// depends on, which release it when they complete.  Once submitted
+// for execution the event owns itself until it is complete, such
+// that no central list of pending events is needed.
 //
 // An enqueued run object holds a reference to an event, which only
 // goes away once the run object is deleted.
@@ -60,8 +146,9 @@ class event_impl : public std::enable_shared_from_this<event_impl>
   mutable std::condition_variable m_wait_done;
   event_queue::task m_task;
   event_queue_impl* m_event_queue = nullptr;
-  std::vector<event_impl*> m_chain;
-  unsigned int m_wait_count = 0;
+  std::shared_ptr<event_impl> m_self;  // ownership while submitted
+  std::vector<std::shared_ptr<event_impl>> m_chain;
+  std::atomic<unsigned int> m_wait_count {0};
   unsigned int m_uid = 0;
   bool m_done = false;
 
@@ -70,7 +157,7 @@ public:
   // the wait count on the argument event, which cannot
   // proceed to execute before this event has completed.
   void
-  chain(event_impl* ev)
+  chain(const std::shared_ptr<event_impl>& ev)
   {
     std::lock_guard<std::mutex> lk(m_mutex);
     if (m_done)
@@ -79,6 +166,16 @@ public:
     ++ev->m_wait_count;
   }
 
+  // Chain this event to the events it depends on.  Called once
+  // the event is constructed and owned by a shared_ptr.
+  void
+  wait_for(const std::vector<event_queue::event>& deps)
+  {
+    for (auto& ev : deps)
+      if (auto& impl = ev.get_impl())
+        impl->chain(get_shared_from_this());
+  }
+
   // Try to submit this event for execution.  This function
   // decrements the wait_count and if zero, submits the event
   // for execution through its associated event queue, where
@@ -93,9 +190,7 @@ public:
   // with argument event queue.
   //
   // This function is called when the event is enqueued on the
-  // event queue.  
-  //
-  // This event is removed from the event queue when it completes.
+  // event queue.
   bool
   submit(event_queue_impl* evq)
   {
@@ -103,6 +198,14 @@ public:
     return submit();
   }
 
+  // Release the ownership of a submitted event that will never be
+  // executed.  Called when the event queue is destroyed.
+  void
+  release()
+  {
+    auto self = std::move(m_self);
+  }
+
   // Execute this event.
   //
   // Function is called by an event handler that wants to
@@ -155,17 +258,14 @@ public:
   // decrement the default wait count.
   //
   // The wait count of this event is incremented per number of active
-  // dependencies, this forming an event graph.
-  event_impl(event_queue::task&& t, const std::vector<event_queue::event>& deps)
+  // dependencies, this forming an event graph, see wait_for().
+  event_impl(event_queue::task&& t)
     : m_task(std::move(t))
     , m_wait_count(1)
   {
-    static unsigned int count = 0;
+    static std::atomic<unsigned int> count {0};
     m_uid = count++;
     XRT_DEBUGF("event_impl::event_impl(%d)\n", m_uid);
-    for (auto& ev : deps)
-      if (auto& impl = ev.get_impl())
-        impl->chain(this);
   }
 
   // Event destructor added for debuggability.
@@ -180,44 +280,80 @@ public:
 // Manages enqueued tasks in form of events that form an event graph
 // based on dependencies between the events.
 //
-// When an event is enqueued it is added to the set of events to
-// retain ownership of the event. As part of enqueuing the event, the
-// event is associated with the event queue by attempting to submit
-// it.
+// When an event is enqueued, it is associated with the event queue
+// by attempting to submit it.  The queue does not own the events,
+// but events that were submitted and never executed are released
+// when the queue is destroyed.
 //
 // If all event dependencies have been satisfied, the event moves to
 // submitted state where it added the event queues task queue.  The
 // task queue is serviced by one or more event handlers that execute
 // the events in first-in-first-out order.
 //
+// The task queue is a lock free ring buffer.  If the ring is full,
+// events go to an overflow queue under a lock until the overflow
+// queue has been drained, which keeps the first-in-first-out order.
+// The lock in the event queue is otherwise only taken to put
+// event handlers to sleep when there is no work, and to wake them
+// up again.
+//
 // An event queue is associated with one or more event handlers, which
 // participate in ownership of the queue.
 class event_queue_impl
 {
-  // Event comparator for heterogenous lookup of events
-  struct event_cmp
-  {
-    using event_ptr = std::shared_ptr<event_impl>;
-    using is_transparent = void;
-    bool operator() (const event_ptr& lhs, const event_ptr& rhs) const { return lhs < rhs; }
-    bool operator() (const event_ptr& lhs, const event_impl* rhs) const { return lhs.get() < rhs; }
-    bool operator() (const event_impl* lhs, const event_ptr& rhs) const { return lhs < rhs.get(); }
-  };
-  
-  std::queue<event_impl*> m_queue;                           // task queue
-  std::set<std::shared_ptr<event_impl>, event_cmp> m_events; // enqueued events
+  static constexpr size_t ring_size = 4096;
+
+  mpmc_queue<event_impl*> m_ring;             // task queue
+  std::deque<event_impl*> m_overflow;         // task queue when ring is full
+  std::atomic<size_t> m_overflow_size {0};
+  std::atomic<unsigned int> m_sleepers {0};   // handlers waiting for work
+  unsigned int m_notify_count = 0;            // incremented by notify()
   std::mutex m_mutex;
   std::condition_variable m_work;
 
+  // Caller must hold m_mutex
+  event_impl*
+  pop_overflow()
+  {
+    if (m_overflow.empty())
+      return nullptr;
+    auto ev = m_overflow.front();
+    m_overflow.pop_front();
+    --m_overflow_size;
+    return ev;
+  }
+
+  event_impl*
+  try_pop()
+  {
+    event_impl* ev = nullptr;
+    if (m_ring.try_pop(ev))
+      return ev;
+
+    if (m_overflow_size.load() == 0)
+      return nullptr;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return pop_overflow();
+  }
+
 public:
+  event_queue_impl()
+    : m_ring(ring_size)
+  {}
+
+  // No event handlers are left, release events that will never be
+  // executed
+  ~event_queue_impl()
+  {
+    while (auto ev = try_pop())
+      ev->release();
+  }
+
   // Enqueue an event and try submit it.
   void
   enqueue(const std::shared_ptr<event_impl>& event)
   {
-    {
-      std::lock_guard<std::mutex> lk(m_mutex);
-      m_events.insert(event);
-    }
     event->submit(this);
   }
 
@@ -227,21 +363,21 @@ public:
   void
   submit(event_impl* ev)
   {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    m_queue.push(ev);
-    m_work.notify_one();
-  }
+    if (m_overflow_size.load() || !m_ring.try_push(ev)) {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_overflow.push_back(ev);
+      ++m_overflow_size;
+    }
 
-  // Upon completion, the event is removed from the ownership
-  // retaining set, which effectively deletes the event if no
-  // other objects participate in the events ownership.
-  void
-  remove(event_impl* ev)
-  {
-    std::lock_guard<std::mutex> lk(m_mutex);
-    auto itr = m_events.find(ev);
-    if (itr != m_events.end())
-      m_events.erase(itr);
+    // Pairs with the fence in get_work(), either this thread sees
+    // the sleeping handler or the handler sees the new event.  The
+    // handler checks for work and waits while holding the mutex, so
+    // the notification cannot be lost
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lk(m_mutex);
+      m_work.notify_one();
+    }
   }
 
   // Notify any waiting for work from this queue. Used by event
@@ -251,6 +387,7 @@ public:
   notify()
   {
     std::lock_guard<std::mutex> lk(m_mutex);
+    ++m_notify_count;
     m_work.notify_all();
   }
 
@@ -261,20 +398,25 @@ public:
   event_impl*
   get_work()
   {
-    std::unique_lock<std::mutex> lk(m_mutex);
-    // notify() need to be able to wake up handlers waiting
-    // for tasks, so wait is deliberately not using 'while'
-    if (m_queue.empty())
-      m_work.wait(lk);
-
-    // return null task if no real ones
-    if (m_queue.empty())
-      return nullptr;
+    if (auto ev = try_pop())
+      return ev;
 
-    // first in first out
-    auto e = std::move(m_queue.front());
-    m_queue.pop();
-    return e;
+    std::unique_lock<std::mutex> lk(m_mutex);
+    ++m_sleepers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Check again now that submit() will notify.  notify() need to
+    // be able to wake up handlers waiting for tasks, in which case
+    // a null task is returned if there are no real ones
+    event_impl* ev = nullptr;
+    auto notify_count = m_notify_count;
+    m_work.wait(lk, [this, &ev, notify_count] {
+      if (m_ring.try_pop(ev) || (ev = pop_overflow()))
+        return true;
+      return notify_count != m_notify_count;
+    });
+    --m_sleepers;
+    return ev;
   }
 };
   
@@ -283,10 +425,12 @@ bool
 event_impl::
 submit()
 {
-  std::lock_guard<std::mutex> lk(m_mutex);
   if (--m_wait_count)
     return false;
-  
+
+  // Owned by itself until done, the event is referenced only by raw
+  // pointer while in the task queue
+  m_self = shared_from_this();
   m_event_queue->submit(this);
   return true;
 }
@@ -307,8 +451,11 @@ done()
 
   for (auto& ev : m_chain)
     ev->submit();
+  m_chain.clear();
 
-  m_event_queue->remove(this);
+  // Release ownership, which effectively deletes the event if no
+  // other objects participate in the events ownership
+  auto self = std::move(m_self);
 }
 
 // class event_handler_impl - insulated implementation of xrt::event_handler
@@ -401,8 +548,10 @@ add_event(const event& ev)
 event_queue::
 event::
 event(task&& t, const std::vector<event>& deps)
-  : m_impl(std::make_shared<event_impl>(std::move(t), deps))
-{}
+  : m_impl(std::make_shared<event_impl>(std::move(t)))
+{
+  m_impl->wait_for(deps);
+}
 
 void
 event_queue::
@@ -29,6 +29,7 @@
 #include "bo.h"
 #include "device_int.h"
 #include "enqueue.h"
+#include "handle_table.h"
 #include "core/common/bo_cache.h"
 #include "core/common/config_reader.h"
 #include "core/common/device.h"
@@ -36,15 +37,18 @@
 #include "core/common/error.h"
 #include "core/common/message.h"
 #include "core/common/system.h"
+#include "core/common/time.h"
 #include "core/common/xclbin_parser.h"
 #include "core/include/ert.h"
 #include "core/include/ert_fa.h"
 #include "core/include/xclbin.h"
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <condition_variable>
 #include <chrono>
+#include <cinttypes>
 #include <cstdarg>
 #include <cstdlib>
 #include <map>
@@ -277,7 +281,9 @@ struct device_type
   xrt_core::bo_cache exec_buffer_cache;
   uint32_t uid; // internal unique id for debug
 
-  static constexpr unsigned int cache_size = 128;
+  // Initial number of exec buffers retained by the cache, the
+  // cache grows on demand up to configured max size.
+  static constexpr unsigned int initial_cache_size = 16;
 
   static uint32_t
   create_uid()
@@ -286,19 +292,10 @@ struct device_type
     return count++;
   }
 
-  explicit
-  device_type(xrtDeviceHandle dhdl)
-    : core_device(xrt_core::device_int::get_core_device(dhdl))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
-    , uid(create_uid())
-  {
-    XRT_DEBUGF("device_type::device_type(%d)\n", uid);
-  }
-
   explicit
   device_type(std::shared_ptr<xrt_core::device> cdev)
     : core_device(std::move(cdev))
-    , exec_buffer_cache(core_device->get_device_handle(), cache_size)
+    , exec_buffer_cache(core_device->get_device_handle(), initial_cache_size, xrt_core::config::get_exec_buffer_cache_size())
     , uid(create_uid())
   {
     XRT_DEBUGF("device_type::device_type(%d)\n", uid);
@@ -307,7 +304,11 @@ struct device_type
   // NOLINTNEXTLINE(modernize-use-equals-default)
   ~device_type()
   {
-    XRT_DEBUGF("device_type::~device_type(%d)\n", uid);
+    XRT_DEBUGF("device_type::~device_type(%d) exec_buffer_cache hits(%" PRIu64 ") misses(%" PRIu64 ") limit(%u)\n"
+               , uid
+               , exec_buffer_cache.get_stats().hits
+               , exec_buffer_cache.get_stats().misses
+               , exec_buffer_cache.get_stats().limit);
   }
 
   device_type(const device_type&) = delete;
@@ -763,27 +764,93 @@ public:
       (*cb)(state);
   }
 
+  // Mark the command as running prior to submission.  Returns true
+  // if the command must be submitted for managed execution.
+  bool
+  submit()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_done)
+      throw std::runtime_error("bad command state, can't launch");
+    m_managed = (m_callbacks && !m_callbacks->empty());
+    m_done = false;
+    return m_managed;
+  }
+
+  // Undo submit() of a command that was never started
+  void
+  cancel_submit()
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_done = true;
+  }
+
+  // True if the command is not running
+  bool
+  is_done() const
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_done;
+  }
+
   // Submit the command for execution
   void
   run()
   {
-    {
-      std::lock_guard<std::mutex> lk(m_mutex);
-      if (!m_done)
-        throw std::runtime_error("bad command state, can't launch");
-      m_managed = (m_callbacks && !m_callbacks->empty());
-      m_done = false;
-    }
-    if (m_managed)
+    if (submit())
       xrt_core::exec::managed_start(this);
     else
       xrt_core::exec::unmanaged_start(this);
   }
 
+  // Read the state of the command packet.  The packet is written by
+  // the scheduler or the device, so force a load on every call and
+  // order subsequent reads of the packet after it.
+  ert_cmd_state
+  read_packet_state() const
+  {
+    auto header = *reinterpret_cast<const volatile uint32_t*>(&get_ert_packet()->header);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return static_cast<ert_cmd_state>(header & 0xF); // ert_packet::state [3-0]
+  }
+
+  // Busy poll for command completion for at most @spin_ns.  Returns
+  // true if the command completed within the spin budget.
+  //
+  // Managed commands are done when the execution monitor has notified
+  // the command.  Unmanaged commands are done when the command packet
+  // state has been updated by the scheduler, the subsequent call to
+  // unmanaged_wait() then returns without blocking.
+  bool
+  spin_wait(unsigned long spin_ns) const
+  {
+    if (!spin_ns)
+      return false;
+
+    auto managed = m_managed.load();
+    auto deadline = xrt_core::time_ns() + spin_ns;
+    do {
+      if (managed ? m_done.load(std::memory_order_acquire) : read_packet_state() >= ERT_CMD_STATE_COMPLETED)
+        return true;
+    } while (xrt_core::time_ns() < deadline);
+
+    return false;
+  }
+
+  // Spin budget from ini setting Runtime.cmd_wait_spin_us
+  static unsigned long
+  spin_budget_ns()
+  {
+    static unsigned long spin_ns = xrt_core::config::get_cmd_wait_spin_us() * 1000UL;
+    return spin_ns;
+  }
+
   // Wait for command completion
   ert_cmd_state
   wait() const
   {
+    spin_wait(spin_budget_ns());
+
     if (m_managed) {
       std::unique_lock<std::mutex> lk(m_mutex);
       while (!m_done)
@@ -800,6 +867,12 @@ public:
   ert_cmd_state
   wait(const std::chrono::milliseconds& timeout_ms) const
   {
+    // Zero timeout means no timeout
+    if (!timeout_ms.count())
+      return wait();
+
+    spin_wait(std::min<unsigned long>(spin_budget_ns(), timeout_ms.count() * 1000000UL));
+
     if (m_managed) {
       std::unique_lock<std::mutex> lk(m_mutex);
       while (!m_done)
@@ -865,8 +938,8 @@ private:
   mutable std::shared_ptr<xrt::event_impl> m_event;
   execbuf_type m_execbuf; // underlying execution buffer
   unsigned int m_uid = 0;
-  bool m_managed = false;
-  bool m_done = false;
+  std::atomic<bool> m_managed {false};
+  std::atomic<bool> m_done {false};   // changed under m_mutex, read without lock by spin_wait
 
   mutable std::mutex m_mutex;
   mutable std::condition_variable m_exec_done;
@@ -1930,9 +2003,9 @@ public:
     encode_cumasks = false;
   }
 
-  // start() - start the run object (execbuf)
+  // prepare() - prepare command packet for execution
   virtual void
-  start()
+  prepare()
   {
     encode_compute_units();
 
@@ -1940,10 +2013,23 @@ public:
     pkt->state = ERT_CMD_STATE_NEW;
 
     XRT_DEBUG_CALL(debug_cmd_packet(kernel->get_name(), pkt));
+  }
 
+  // start() - start the run object (execbuf)
+  void
+  start()
+  {
+    prepare();
     cmd->run();
   }
 
+  // get_command() - underlying command object
+  kernel_command*
+  get_command() const
+  {
+    return cmd.get();
+  }
+
   void
   start(const autostart& iterations)
   {
@@ -2166,7 +2252,7 @@ public:
   }
 
   void
-  start() override
+  prepare() override
   {
     // sync command payload to mailbox if necessary
     write();
@@ -2176,8 +2262,8 @@ public:
     auto pkt = cmd->get_ert_packet();
     pkt->count = kernel->get_num_cumasks() + ap_ctrl_reserved;
 
-    // Regular start
-    run_impl::start();
+    // Regular prepare
+    run_impl::prepare();
   }
 };
 
@@ -2284,66 +2370,141 @@ public:
   }
 };
 
+// class run_batch_impl - insulated implementation of xrt::run_batch
+//
+// All runs of the batch are prepared before any is submitted so that
+// submission is one shim call per device when supported.
+class run_batch_impl
+{
+  std::vector<xrt::run> runs;
+
+  // Undo submit() of commands that were never started, or waiting on
+  // them would never return
+  template <typename ItrType>
+  static void
+  cancel_submit(ItrType first, ItrType last)
+  {
+    for (; first != last; ++first)
+      (*first)->cancel_submit();
+  }
+
+public:
+  void
+  add(const xrt::run& r)
+  {
+    runs.push_back(r);
+  }
+
+  size_t
+  size() const
+  {
+    return runs.size();
+  }
+
+  void
+  clear()
+  {
+    runs.clear();
+  }
+
+  void
+  start()
+  {
+    // Preparing a run rewrites its command packet, so no run can be
+    // touched before it is known that none of the runs are running
+    for (auto& run : runs)
+      if (!run.get_handle()->get_command()->is_done())
+        throw xrt_core::error(EBUSY, "bad command state, can't launch batch with running run object");
+
+    std::vector<kernel_command*> cmds;
+    cmds.reserve(runs.size());
+    std::vector<bool> managed;
+    managed.reserve(runs.size());
+    try {
+      for (auto& run : runs) {
+        auto& impl = run.get_handle();
+        impl->prepare();
+        auto cmd = impl->get_command();
+        managed.push_back(cmd->submit());
+        cmds.push_back(cmd);
+      }
+    }
+    catch (...) {
+      // None of the commands have been started
+      cancel_submit(cmds.begin(), cmds.end());
+      throw;
+    }
+
+    // Submit in order of runs, consecutive commands with the same
+    // execution mode are submitted together
+    std::exception_ptr eptr;
+    size_t submitted = 0;
+    while (submitted < cmds.size() && !eptr) {
+      auto first = managed.begin() + submitted;
+      auto last = std::find(first, managed.end(), !*first);
+      std::vector<xrt_core::command*> group(cmds.begin() + submitted, cmds.begin() + (last - managed.begin()));
+      submitted += *first
+        ? xrt_core::exec::managed_start(group, eptr)
+        : xrt_core::exec::unmanaged_start(group, eptr);
+    }
+
+    if (eptr) {
+      // Commands after the failure were never started
+      cancel_submit(cmds.begin() + submitted, cmds.end());
+      std::rethrow_exception(eptr);
+    }
+  }
+
+  void
+  wait() const
+  {
+    for (auto& run : runs)
+      run.get_handle()->wait(std::chrono::milliseconds{0});
+  }
+};
+
 } // namespace xrt
 
 namespace {
 
-// Device wrapper.  Lifetime is tied to kernel object.  Using
-// std::weak_ptr to treat as cache rather sharing ownership.
+// Device wrapper keyed by core device.  Lifetime is tied to kernel
+// object.  Using std::weak_ptr to treat as cache rather sharing ownership.
 // Ownership of device is shared by kernel objects, when last kernel
 // object is destructed, the correponding device object is deleted and
 // cache will miss lookup for subsequent kernel creation.  Without
 // weak_ptr, the cache would hold on to the device until static global
 // destruction and long after application calls xclClose on the
 // xrtDeviceHandle.
-static std::map<xrtDeviceHandle, std::weak_ptr<device_type>> devices;
+static std::map<const xrt_core::device*, std::weak_ptr<device_type>> devices;
 
 // Active kernels per xrtKernelOpen/Close.  This is a mapping from
-// xrtKernelHandle to the corresponding kernel object.  The
-// xrtKernelHandle is the address of the kernel object.  This is
+// xrtKernelHandle to the corresponding kernel object.  This is
 // shared ownership as application can close a kernel handle before
 // closing an xrtRunHandle that references same kernel.
-static std::map<void*, std::shared_ptr<xrt::kernel_impl>> kernels;
+static xrt_core::handle_table<std::shared_ptr<xrt::kernel_impl>> kernels;
 
 // Active runs.  This is a mapping from xrtRunHandle to corresponding
-// run object.  The xrtRunHandle is the address of the run object.
-// This is unique ownership as only the host application holds on to a
-// run object, e.g. the run object is desctructed immediately when it
-// is closed.
-static std::map<void*, std::unique_ptr<xrt::run_impl>> runs;
+// run object.  Only the host application holds on to a run object,
+// the run object is destructed when it is closed and no other thread
+// is using it.
+static xrt_core::handle_table<std::shared_ptr<xrt::run_impl>> runs;
 
 // Run updates, if used are tied to existing runs and removed
-// when run is closed.
-static std::map<const xrt::run_impl*, std::unique_ptr<xrt::run_update_type>> run_updates;
+// when run is closed.  Protected by map_mutex.  Shared ownership
+// so an update in progress is not destructed by a concurrent close.
+static std::map<const xrt::run_impl*, std::shared_ptr<xrt::run_update_type>> run_updates;
 
 // Mutex to protect access to maps
 static std::mutex map_mutex;
 
-// get_device() - get a device object from an xrtDeviceHandle
+// get_device() - get a device object from a core device
 //
 // The lifetime of the device object is shared ownership. The object
-// is cached so that subsequent look-ups from same xrtDeviceHandle
+// is cached so that subsequent look-ups from same core device
 // result in same device object if it exists already.
 //
 // Refactor to share, or better get rid of device_type and fold
 // extension into xrt_core::device
-static std::shared_ptr<device_type>
-get_device(xrtDeviceHandle dhdl)
-{
-  std::lock_guard<std::mutex> lk(map_mutex);
-  auto itr = devices.find(dhdl);
-  std::shared_ptr<device_type> device = (itr != devices.end())
-    ? (*itr).second.lock()
-    : nullptr;
-  if (!device) {
-    // NOLINTNEXTLINE(modernize-make-shared)  used in weak_ptr
-    device = std::shared_ptr<device_type>(new device_type(dhdl));
-    xrt_core::exec::init(device->get_core_device());
-    devices.emplace(std::make_pair(dhdl, device));
-  }
-  return device;
-}
-
 static std::shared_ptr<device_type>
 get_device(const std::shared_ptr<xrt_core::device>& core_device)
 {
@@ -2369,47 +2530,54 @@ get_device(const xrt::device& xdev)
   return get_device(xdev.get_handle());
 }
 
+// C-API device handles are opaque, device objects are cached
+// by the underlying core device
+static std::shared_ptr<device_type>
+get_device(xrtDeviceHandle dhdl)
+{
+  return get_device(xrt_core::device_int::get_core_device(dhdl));
+}
+
 // get_kernel() - get a kernel object from an xrtKernelHandle
 //
 // The lifetime of a kernel object is shared ownerhip. The object
 // is shared with host application and run objects.
-static const std::shared_ptr<xrt::kernel_impl>&
+static std::shared_ptr<xrt::kernel_impl>
 get_kernel(xrtKernelHandle khdl)
 {
-  auto itr = kernels.find(khdl);
-  if (itr == kernels.end())
+  auto kernel = kernels.find(khdl);
+  if (!kernel)
     throw xrt_core::error(-EINVAL, "Unknown kernel handle");
-  return (*itr).second;
+  return kernel;
 }
 
 // get_run() - get a run object from an xrtRunHandle
 //
-// The lifetime of a run object is unique to the host application.
-static xrt::run_impl*
+// The lifetime of a run object is owned by the host application,
+// the returned object keeps the run alive while in use.
+static std::shared_ptr<xrt::run_impl>
 get_run(xrtRunHandle rhdl)
 {
-  auto itr = runs.find(rhdl);
-  if (itr == runs.end())
+  auto run = runs.find(rhdl);
+  if (!run)
     throw xrt_core::error(-EINVAL, "Unknown run handle");
-  return (*itr).second.get();
+  return run;
 }
 
-static xrt::run_update_type*
+// get_run_update() - get the update object of a run
+//
+// The caller must keep the run alive while using the returned
+// update object, which references the run.
+static std::shared_ptr<xrt::run_update_type>
 get_run_update(xrt::run_impl* run)
 {
+  std::lock_guard<std::mutex> lk(map_mutex);
   auto itr = run_updates.find(run);
   if (itr == run_updates.end()) {
-    auto ret = run_updates.emplace(std::make_pair(run,std::make_unique<xrt::run_update_type>(run)));
+    auto ret = run_updates.emplace(std::make_pair(run,std::make_shared<xrt::run_update_type>(run)));
     itr = ret.first;
   }
-  return (*itr).second.get();
-}
-
-static xrt::run_update_type*
-get_run_update(xrtRunHandle rhdl)
-{
-  auto run = get_run(rhdl);
-  return get_run_update(run);
+  return (*itr).second;
 }
 
 static std::unique_ptr<xrt::run_impl>
@@ -2449,40 +2617,40 @@ xrtKernelOpen(xrtDeviceHandle dhdl, const xuid_t xclbin_uuid, const char *name,
 {
   auto device = get_device(dhdl);
   auto kernel = std::make_shared<xrt::kernel_impl>(device, xclbin_uuid, name, am);
-  auto handle = kernel.get();
-  kernels.emplace(std::make_pair(handle,std::move(kernel)));
-  return handle;
+  return kernels.insert(std::move(kernel));
 }
 
 void
 xrtKernelClose(xrtKernelHandle khdl)
 {
-  auto itr = kernels.find(khdl);
-  if (itr == kernels.end())
+  if (!kernels.erase(khdl))
     throw xrt_core::error(-EINVAL, "Unknown kernel handle");
-  kernels.erase(itr);
 }
 
 xrtRunHandle
 xrtRunOpen(xrtKernelHandle khdl)
 {
-  const auto& kernel = get_kernel(khdl);
-  auto run = alloc_run(kernel);
-  auto handle = run.get();
-  runs.emplace(std::make_pair(handle,std::move(run)));
-  return handle;
+  auto kernel = get_kernel(khdl);
+  std::shared_ptr<xrt::run_impl> run = alloc_run(kernel);
+  return runs.insert(std::move(run));
 }
 
 void
 xrtRunClose(xrtRunHandle rhdl)
 {
-  auto run = get_run(rhdl);
+  auto run = runs.erase(rhdl);
+  if (!run)
+    throw xrt_core::error(-EINVAL, "Unknown run handle");
+
+  std::shared_ptr<xrt::run_update_type> update;
   {
-    auto itr = run_updates.find(run);
-    if (itr != run_updates.end())
+    std::lock_guard<std::mutex> lk(map_mutex);
+    auto itr = run_updates.find(run.get());
+    if (itr != run_updates.end()) {
+      update = std::move((*itr).second);
       run_updates.erase(itr);
+    }
   }
-  runs.erase(run);
 }
 
 ert_cmd_state
@@ -2752,6 +2920,52 @@ get_ert_packet() const
   });
 }
 
+run_batch::
+run_batch()
+  : handle(std::make_shared<run_batch_impl>())
+{}
+
+void
+run_batch::
+add(const run& r)
+{
+  handle->add(r);
+}
+
+size_t
+run_batch::
+size() const
+{
+  return handle->size();
+}
+
+void
+run_batch::
+clear()
+{
+  handle->clear();
+}
+
+void
+run_batch::
+start()
+{
+  xdp::native::profiling_wrapper
+    ("xrt::run_batch::start", [this]{
+    handle->start();
+  });
+}
+
+void
+run_batch::
+wait() const
+{
+  xdp::native::profiling_wrapper
+    ("xrt::run_batch::wait", [this]{
+    handle->wait();
+  });
+}
+
 kernel::
 kernel(const xrt::device& xdev, const xrt::uuid& xclbin_id, const std::string& name, cu_access_mode mode)
   : handle(xdp::native::profiling_wrapper("xrt::kernel::kernel",
@@ -3156,7 +3370,8 @@ xrtRunUpdateArg(xrtRunHandle rhdl, int index, ...)
     va_start(args, index); // NOLINT
     auto result = xdp::native::profiling_wrapper(__func__,
     [rhdl, index, argptr]{
-      auto upd = get_run_update(rhdl);
+      auto run = get_run(rhdl);
+      auto upd = get_run_update(run.get());
       upd->update_arg_at_index(index, argptr);
       return 0;
     });
@@ -3179,7 +3394,8 @@ xrtRunUpdateArgV(xrtRunHandle rhdl, int index, const void* value, size_t bytes)
   try {
     return xdp::native::profiling_wrapper(__func__,
     [rhdl, index, value, bytes]{
-      auto upd = get_run_update(rhdl);
+      auto run = get_run(rhdl);
+      auto upd = get_run_update(run.get());
       upd->update_arg_at_index(index, value, bytes);
       return 0;
     });
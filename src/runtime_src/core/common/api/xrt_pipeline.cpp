@@ -22,6 +22,7 @@
 
 #include "core/common/debug.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -48,7 +49,7 @@ public:
   pipeline_impl(const xrt::event_queue& q)
     : m_queue(q)
   {
-    static unsigned int count = 0;
+    static std::atomic<unsigned int> count {0};
     m_uid = count++;
     XRT_DEBUGF("pipeline_impl::pipeline_impl(%d)\n", m_uid);
   }
@@ -32,10 +32,15 @@
 
 #include "native_profile.h"
 
+#include <algorithm>
 #include <array>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <set>
+#include <tuple>
 #include <vector>
 
 #ifdef _WIN32
@@ -43,6 +48,10 @@
 # pragma warning( disable : 4244 4267 4996)
 #else
 # include <linux/uuid.h>
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
 #endif
 
 namespace {
@@ -100,6 +109,160 @@ copy_axlf(const axlf* top)
   return header;
 }
 
+// validate_axlf() - check that image is an xclbin whose section
+// headers and sections all lie within the image
+static void
+validate_axlf(const char* data, size_t size)
+{
+  auto top = reinterpret_cast<const axlf*>(data);
+  if (size < sizeof(axlf) || strncmp(top->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
+    throw std::runtime_error("Invalid xclbin");
+  if (top->m_header.m_length > size)
+    throw std::runtime_error("Invalid xclbin, size " + std::to_string(size)
+                             + " is less than header length " + std::to_string(top->m_header.m_length));
+
+  uint64_t nsections = top->m_header.m_numSections;
+  uint64_t headers = sizeof(axlf) + (nsections ? nsections - 1 : 0) * sizeof(axlf_section_header);
+  if (headers > size)
+    throw std::runtime_error("Invalid xclbin, " + std::to_string(nsections)
+                             + " section headers exceed size " + std::to_string(size));
+
+  for (uint64_t idx = 0; idx < nsections; ++idx) {
+    auto& hdr = top->m_sections[idx];
+    if (hdr.m_sectionOffset > size || hdr.m_sectionSize > size - hdr.m_sectionOffset)
+      throw std::runtime_error("Invalid xclbin, section " + std::to_string(idx)
+                               + " exceeds size " + std::to_string(size));
+  }
+}
+
+// class xclbin_file - read only image of an xclbin file
+//
+// On Linux the file is memory mapped.  Pages are read from disk when
+// first touched, so large sections that are never accessed, e.g. the
+// bitstream when only meta data is needed, are never read.  The file
+// is kept open so that users of the image can check that the file has
+// not been modified in place since it was mapped, in which case the
+// mapped pages no longer hold the xclbin that was validated.
+class xclbin_file
+{
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  std::vector<char> m_copy;
+#else
+  int m_fd = -1;
+  struct timespec m_mtime {};
+#endif
+
+public:
+  explicit
+  xclbin_file(const std::string& fnm)
+  {
+#ifdef _WIN32
+    m_copy = read_xclbin(fnm);
+    m_data = m_copy.data();
+    m_size = m_copy.size();
+#else
+    if (fnm.empty())
+      throw std::runtime_error("No xclbin specified");
+
+    auto fd = ::open(fnm.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("Failed to open file '" + fnm + "' for reading");
+
+    struct stat st;
+    if (::fstat(fd, &st) || st.st_size <= 0) {
+      ::close(fd);
+      throw std::runtime_error("Failed to read file '" + fnm + "'");
+    }
+
+    auto size = static_cast<size_t>(st.st_size);
+    auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file '" + fnm + "'");
+    }
+
+    m_data = static_cast<const char*>(addr);
+    m_size = size;
+    m_fd = fd;
+    m_mtime = st.st_mtim;
+#endif
+  }
+
+  ~xclbin_file()
+  {
+#ifndef _WIN32
+    ::munmap(const_cast<char*>(m_data), m_size);
+    ::close(m_fd);
+#endif
+  }
+
+  xclbin_file(const xclbin_file&) = delete;
+  xclbin_file& operator=(const xclbin_file&) = delete;
+
+  const char*
+  data() const
+  {
+    return m_data;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  // modified() - check if file was written or truncated since mapped
+  bool
+  modified() const
+  {
+#ifdef _WIN32
+    return false;
+#else
+    struct stat st;
+    if (::fstat(m_fd, &st))
+      return true;
+    return static_cast<size_t>(st.st_size) != m_size
+      || st.st_mtim.tv_sec != m_mtime.tv_sec
+      || st.st_mtim.tv_nsec != m_mtime.tv_nsec;
+#endif
+  }
+};
+
+// get_xclbin_file() - image of file shared by all xclbin objects
+//
+// A file that is loaded more than once, e.g. on multiple devices, is
+// mapped only once as long as it is not replaced in between.
+static std::shared_ptr<xclbin_file>
+get_xclbin_file(const std::string& fnm)
+{
+#ifdef _WIN32
+  return std::make_shared<xclbin_file>(fnm);
+#else
+  struct stat st;
+  if (fnm.empty() || ::stat(fnm.c_str(), &st))
+    return std::make_shared<xclbin_file>(fnm);  // throws
+
+  using key_type = std::tuple<dev_t, ino_t, off_t, time_t>;
+  static std::mutex mutex;
+  static std::map<key_type, std::weak_ptr<xclbin_file>> files;
+
+  key_type key{st.st_dev, st.st_ino, st.st_size, st.st_mtime};
+  std::lock_guard<std::mutex> lk(mutex);
+  if (auto file = files[key].lock())
+    return file;
+
+  // Drop entries of files no longer in use
+  for (auto itr = files.begin(); itr != files.end();)
+    itr = itr->second.expired() ? files.erase(itr) : std::next(itr);
+
+  auto file = std::make_shared<xclbin_file>(fnm);
+  files[key] = file;
+  return file;
+#endif
+}
+
 }
 
 namespace xrt {
@@ -517,70 +680,99 @@ public:
 // class xclbin_full - Implementation of full xclbin
 //
 // A full xclbin is constructed from a file on disk or from a complete
-// binary images for file content
+// binary images for file content.  A file is mapped rather than read,
+// and sections are located in the image when requested, so meta data
+// access does not read or copy the large sections of the xclbin.
 class xclbin_full : public xclbin_impl
 {
-  std::vector<char> m_axlf;  // complete copy of xclbin raw data
-  const axlf* m_top = nullptr;
+  std::shared_ptr<xclbin_file> m_file; // mapped xclbin file
+  std::string m_filename;              // name of mapped file
+  mutable std::vector<char> m_axlf;    // complete copy of xclbin raw data if not from file
+  mutable const axlf* m_top = nullptr;
+  mutable std::mutex m_mutex;          // switch from mapped file to copy
   uuid m_uuid;
+
+  // sections created for software emulation
   std::map<axlf_section_kind, std::vector<char>> m_axlf_sections;
 
+  // get_top() - image of the xclbin
+  //
+  // A mapped file modified in place no longer holds the validated
+  // xclbin.  The file is then read again, and the copy is used from
+  // there on if it is still the same xclbin.  The mapping is kept so
+  // that sections returned earlier remain accessible.
+  const axlf*
+  get_top() const
+  {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_file || !m_axlf.empty() || !m_file->modified())
+      return m_top;
+
+    auto data = read_xclbin(m_filename);
+    validate_axlf(data.data(), data.size());
+    auto top = reinterpret_cast<const axlf*>(data.data());
+    if (uuid(top->m_header.uuid) != m_uuid)
+      throw std::runtime_error("xclbin file '" + m_filename + "' was replaced after it was loaded");
+
+    m_axlf = std::move(data);
+    m_top = reinterpret_cast<const axlf*>(m_axlf.data());
+    return m_top;
+  }
+
   void
-  init_axlf()
+  init_axlf(const char* data, size_t size)
   {
-    const axlf* tmp = reinterpret_cast<const axlf*>(m_axlf.data());
-    if (strncmp(tmp->m_magic, "xclbin2", strlen("xclbin2")) != 0) // Future: Do not hardcode "xclbin2"
-      throw std::runtime_error("Invalid xclbin");
-    m_top = tmp;
+    validate_axlf(data, size);
+    m_top = reinterpret_cast<const axlf*>(data);
 
     m_uuid = uuid(m_top->m_header.uuid); 
     
+    // software emulation xclbin does not have all sections
+    // create the necessary ones.  important that ip_layout is
+    // before connectivity which needs ip_layout
+    if (!is_sw_emulation() || xrt_core::config::get_feature_toggle("Runtime.vitis715"))
+      return;
+
     XRT_CORE_UNUSED const ::ip_layout* ip_layout = nullptr;
 
     for (auto kind : kinds) {
       auto hdr = xrt_core::xclbin::get_axlf_section(m_top, kind);
-
-      // software emulation xclbin does not have all sections
-      // create the necessary ones.  important that ip_layout is
-      // before connectivity which needs ip_layout
-      if (!hdr && is_sw_emulation() && !xrt_core::config::get_feature_toggle("Runtime.vitis715")) {
-        auto data = xrt_core::xclbin::swemu::get_axlf_section(m_top, ip_layout, kind);
-        if (!data.empty()) {
-          auto pos = m_axlf_sections.emplace(kind, std::move(data));
-          if (kind == IP_LAYOUT)
-            ip_layout = reinterpret_cast<const ::ip_layout*>((pos.first)->second.data());
-        }
-      }
-
-      if (!hdr)
+      if (hdr) {
+        if (kind == IP_LAYOUT)
+          ip_layout = reinterpret_cast<const ::ip_layout*>(data + hdr->m_sectionOffset);
         continue;
+      }
 
-      auto section_data = reinterpret_cast<const char*>(m_top) + hdr->m_sectionOffset;
-      std::vector<char> data{section_data, section_data + hdr->m_sectionSize};
-      m_axlf_sections.emplace(kind , std::move(data));
+      auto section = xrt_core::xclbin::swemu::get_axlf_section(m_top, ip_layout, kind);
+      if (!section.empty()) {
+        auto pos = m_axlf_sections.emplace(kind, std::move(section));
+        if (kind == IP_LAYOUT)
+          ip_layout = reinterpret_cast<const ::ip_layout*>((pos.first)->second.data());
+      }
     }
   }
   
 public:
   explicit
   xclbin_full(const std::string& filename)
-    : m_axlf(read_xclbin(filename))
+    : m_file(get_xclbin_file(filename))
+    , m_filename(filename)
   {
-    init_axlf();
+    init_axlf(m_file->data(), m_file->size());
   }
 
   explicit
   xclbin_full(std::vector<char> data)
     : m_axlf(std::move(data))
   {
-    init_axlf();
+    init_axlf(m_axlf.data(), m_axlf.size());
   }
 
   explicit
   xclbin_full(const axlf* top)
     : m_axlf(copy_axlf(top))
   {
-    init_axlf();
+    init_axlf(m_axlf.data(), m_axlf.size());
   }
 
   uuid
@@ -592,12 +784,19 @@ public:
   std::string
   get_xsa_name() const override
   {
-    return reinterpret_cast<const char*>(m_top->m_header.m_platformVBNV);
+    return reinterpret_cast<const char*>(get_top()->m_header.m_platformVBNV);
   }
 
   std::pair<const char*, size_t>
   get_axlf_section(axlf_section_kind kind) const override
   {
+    if (std::find(kinds.begin(), kinds.end(), kind) == kinds.end())
+      return {nullptr, 0};
+
+    auto top = get_top();
+    if (auto hdr = xrt_core::xclbin::get_axlf_section(top, kind))
+      return {reinterpret_cast<const char*>(top) + hdr->m_sectionOffset, hdr->m_sectionSize};
+
     auto itr = m_axlf_sections.find(kind);
     return itr != m_axlf_sections.end()
       ? std::make_pair((*itr).second.data(), (*itr).second.size())
@@ -607,7 +806,7 @@ public:
   const axlf*
   get_axlf() const override
   {
-    return m_top;
+    return get_top();
   }
 };
   
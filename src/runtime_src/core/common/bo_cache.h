@@ -1,5 +1,5 @@
 /**
- * Copyright (C) 2019 Xilinx, Inc
+ * Copyright (C) 2019-2021 Xilinx, Inc
  *
  * Licensed under the Apache License, Version 2.0 (the "License"). You may
  * not use this file except in compliance with the License. A copy of the
@@ -21,9 +21,11 @@
 #include "device.h"
 #include "ert.h"
 
-#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <utility>
-#include <mutex>
 
 #ifdef _WIN32
 # pragma warning( push )
@@ -34,35 +36,170 @@ namespace xrt_core {
 
 // Create a cache of CMD BO objects -- for now only used for M2M -- to reduce
 // the overhead of BO life cycle management.
+//
+// The cache is lock free.  Cached BOs are kept in slots that are
+// allocated in chunks as the cache fills up.  Slots holding a cached
+// BO and empty slots are linked in two lock free stacks.  The number
+// of BOs retained by the cache adapts to usage, it starts at an
+// initial limit and grows by one for every cache miss up to the
+// maximum size.  BOs that stay in the cache through a whole trim
+// interval are idle, they are freed and the limit shrinks back
+// towards the initial limit.
 class bo_cache {
 public:
   // Helper typedef for std::pair. Note the elements are const so that the
   // pair is immutable. The clients should not change the contents of cmd_bo.
   template <typename CommandType>
   using cmd_bo = std::pair<const xclBufferHandle, CommandType *const>;
+
+  // Cache statistics
+  struct stats
+  {
+    uint64_t hits;       // alloc served from cache
+    uint64_t misses;     // alloc that required new BO
+    unsigned int cached; // number of BOs currently in cache
+    unsigned int limit;  // current limit on number of cached BOs
+  };
+
 private:
+  // Slot in the cache. The index of next slot in the stack is
+  // offset by one so that zero can represent end of stack.
+  struct slot
+  {
+    xclBufferHandle handle = XRT_NULL_BO;
+    void* data = nullptr;
+    std::atomic<uint32_t> next {0};
+  };
+
+  // Slots allocated on first use in chunks of chunk_size, so memory
+  // follows the number of BOs actually cached rather than the
+  // maximum size of the cache.  A chunk is never freed before the
+  // cache is destroyed.
+  class slot_table
+  {
+    static constexpr uint32_t chunk_size = 64;
+    std::unique_ptr<std::atomic<slot*>[]> m_chunks;
+    const uint32_t m_max;
+    std::atomic<uint32_t> m_used {0};
+
+  public:
+    explicit
+    slot_table(uint32_t max)
+      : m_chunks(std::make_unique<std::atomic<slot*>[]>((max + chunk_size - 1) / chunk_size))
+      , m_max(max)
+    {}
+
+    ~slot_table()
+    {
+      for (uint32_t idx = 0; idx < (m_max + chunk_size - 1) / chunk_size; ++idx)
+        delete [] m_chunks[idx].load();
+    }
+
+    slot&
+    operator[](uint32_t idx)
+    {
+      return m_chunks[idx / chunk_size].load(std::memory_order_acquire)[idx % chunk_size];
+    }
+
+    // Create a new slot if table is not full
+    bool
+    create(uint32_t& idx)
+    {
+      auto used = m_used.load(std::memory_order_relaxed);
+      do {
+        if (used >= m_max)
+          return false;
+      } while (!m_used.compare_exchange_weak(used, used + 1, std::memory_order_relaxed));
+
+      idx = used;
+      auto& chunk = m_chunks[idx / chunk_size];
+      if (!chunk.load(std::memory_order_acquire)) {
+        slot* expected = nullptr;
+        auto fresh = new slot[chunk_size];
+        if (!chunk.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+          delete [] fresh;
+      }
+      return true;
+    }
+  };
+
+  // Lock free stack of slot indices.  The head packs a tag in the
+  // upper 32 bits to prevent ABA when a slot is popped and pushed
+  // while another thread is in the middle of a pop.
+  class slot_stack
+  {
+    std::atomic<uint64_t> m_head {0};
+
+  public:
+    void
+    push(slot_table& slots, uint32_t idx)
+    {
+      auto head = m_head.load(std::memory_order_relaxed);
+      uint64_t next = 0;
+      do {
+        slots[idx].next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        next = (((head >> 32) + 1) << 32) | (idx + 1);
+      } while (!m_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool
+    pop(slot_table& slots, uint32_t& idx)
+    {
+      auto head = m_head.load(std::memory_order_acquire);
+      uint64_t next = 0;
+      uint32_t top = 0;
+      do {
+        top = static_cast<uint32_t>(head);
+        if (!top)
+          return false;
+        next = (((head >> 32) + 1) << 32) | slots[top - 1].next.load(std::memory_order_relaxed);
+      } while (!m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire));
+      idx = top - 1;
+      return true;
+    }
+  };
 
   // We are really allocating a page size as that is what xocl/zocl do. Note on
   // POWER9 pagesize maybe more than 4K, xocl would upsize the allocation to the
   // correct pagesize. unmap always unmaps the full page.
   static const size_t mBOSize = 4096;
+  // Number of allocations between checks for idle BOs
+  static const uint64_t mTrimInterval = 1024;
   std::shared_ptr<device> mDevice;
   // Maximum number of BOs that can be cached in the pool. Value of 0 indicates
   // caching should be disabled.
   const unsigned int mCacheMaxSize;
-  std::vector<cmd_bo<void>> mCmdBOCache;
-  std::mutex mCacheMutex;
+  const unsigned int mCacheInitSize;
+  slot_table mSlots;
+  slot_stack mCached;
+  slot_stack mEmpty;
+  std::atomic<unsigned int> mCacheLimit;
+  std::atomic<unsigned int> mCacheSize {0};
+  std::atomic<unsigned int> mLowWater {0}; // fewest cached BOs since last trim
+  std::atomic<uint64_t> mHits {0};
+  std::atomic<uint64_t> mMisses {0};
 
 public:
+  // Fixed size cache, retains up to max_size BOs
   bo_cache(xclDeviceHandle handle, unsigned int max_size)
-    : mDevice(get_userpf_device(handle)), mCacheMaxSize(max_size)
+    : bo_cache(handle, max_size, max_size)
+  {}
+
+  // Adaptive cache, retains initially up to init_size BOs, grows on
+  // demand to max_size.
+  bo_cache(xclDeviceHandle handle, unsigned int init_size, unsigned int max_size)
+    : mDevice(get_userpf_device(handle))
+    , mCacheMaxSize(max_size)
+    , mCacheInitSize(std::min(init_size, max_size))
+    , mSlots(max_size)
+    , mCacheLimit(mCacheInitSize)
   {}
 
   ~bo_cache()
   {
-    std::lock_guard<std::mutex> lock(mCacheMutex);
-    for (auto& bo : mCmdBOCache)
-      destroy(bo);
+    uint32_t idx = 0;
+    while (mCached.pop(mSlots, idx))
+      destroy(std::make_pair(mSlots[idx].handle, mSlots[idx].data));
   }
 
   template<typename T>
@@ -80,18 +217,34 @@ public:
     release_impl(std::make_pair(bo.first, static_cast<void *>(bo.second)));
   }
 
+  stats
+  get_stats() const
+  {
+    return { mHits.load(), mMisses.load(), mCacheSize.load(), mCacheLimit.load() };
+  }
+
 private:
   cmd_bo<void>
   alloc_impl()
   {
     if (mCacheMaxSize) {
       // If caching is enabled first look up in the BO cache
-      std::lock_guard<std::mutex> lock(mCacheMutex);
-      if (!mCmdBOCache.empty()) {
-        auto bo = mCmdBOCache.back();
-        mCmdBOCache.pop_back();
+      uint32_t idx = 0;
+      if (mCached.pop(mSlots, idx)) {
+        auto bo = std::make_pair(mSlots[idx].handle, mSlots[idx].data);
+        update_low_water(--mCacheSize);
+        mEmpty.push(mSlots, idx);
+        if ((mHits.fetch_add(1, std::memory_order_relaxed) + 1) % mTrimInterval == 0)
+          trim_idle();
         return bo;
       }
+
+      // Cache miss, allow the cache to retain one more BO
+      mLowWater.store(0, std::memory_order_relaxed);
+      mMisses.fetch_add(1, std::memory_order_relaxed);
+      auto limit = mCacheLimit.load(std::memory_order_relaxed);
+      if (limit < mCacheMaxSize)
+        mCacheLimit.compare_exchange_strong(limit, limit + 1, std::memory_order_relaxed);
     }
 
     auto execHandle = mDevice->alloc_bo(mBOSize, XCL_BO_FLAGS_EXECBUF);
@@ -103,15 +256,50 @@ private:
   {
     if (mCacheMaxSize) {
       // If caching is enabled and BO cache is not fully populated add this the cache
-      std::lock_guard<std::mutex> lock(mCacheMutex);
-      if (mCmdBOCache.size() < mCacheMaxSize) {
-        mCmdBOCache.push_back(bo);
+      uint32_t idx = 0;
+      if (mCacheSize.fetch_add(1) < mCacheLimit.load(std::memory_order_relaxed)
+          && (mEmpty.pop(mSlots, idx) || mSlots.create(idx))) {
+        mSlots[idx].handle = bo.first;
+        mSlots[idx].data = bo.second;
+        mCached.push(mSlots, idx);
         return;
       }
+      --mCacheSize;
     }
     destroy(bo);
   }
 
+  void
+  update_low_water(unsigned int cached)
+  {
+    auto low = mLowWater.load(std::memory_order_relaxed);
+    while (cached < low && !mLowWater.compare_exchange_weak(low, cached, std::memory_order_relaxed))
+      ;
+  }
+
+  // BOs that stayed cached through the last trim interval were not
+  // needed.  Lower the limit by that many, but not below the initial
+  // limit, and free the cached BOs above the new limit.
+  void
+  trim_idle()
+  {
+    auto idle = mLowWater.load(std::memory_order_relaxed);
+    auto limit = mCacheLimit.load(std::memory_order_relaxed);
+    if (idle && limit > mCacheInitSize) {
+      auto new_limit = limit - std::min(idle, limit - mCacheInitSize);
+      if (mCacheLimit.compare_exchange_strong(limit, new_limit, std::memory_order_relaxed)) {
+        uint32_t idx = 0;
+        while (mCacheSize.load() > new_limit && mCached.pop(mSlots, idx)) {
+          auto bo = std::make_pair(mSlots[idx].handle, mSlots[idx].data);
+          --mCacheSize;
+          mEmpty.push(mSlots, idx);
+          destroy(bo);
+        }
+      }
+    }
+    mLowWater.store(mCacheSize.load(), std::memory_order_relaxed);
+  }
+
   void
   destroy(const cmd_bo<void> &bo)
   {
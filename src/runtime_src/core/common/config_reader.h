@@ -261,6 +261,13 @@ get_trace_buffer_size()
   return value;
 }
 
+inline bool
+get_trace_file_compression()
+{
+  static bool value = detail::get_bool_value("Debug.trace_file_compression", false);
+  return value;
+}
+
 inline std::string
 get_aie_trace_buffer_size()
 {
@@ -409,6 +416,30 @@ get_polling_throttle()
   return value;
 }
 
+/**
+ * Number of software command scheduler (sws) threads.  Each new
+ * execution core (device) is assigned to the thread that currently
+ * serves the fewest execution cores.
+ */
+inline unsigned int
+get_sws_threads()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.sws_threads",1);
+  return value;
+}
+
+/**
+ * Number of milliseconds a device sensor value read from sysfs is
+ * cached.  While sensors are polled, a background thread refreshes
+ * them before they expire.  0 disables caching.
+ */
+inline unsigned int
+get_sensor_ttl_ms()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.sensor_ttl_ms",0);
+  return value;
+}
+
 inline std::string
 get_hal_logging()
 {
@@ -601,6 +632,30 @@ get_cmdbo_cache()
   return value;
 }
 
+/**
+ * Set maximum size of exec buffer cache used by xrt::run objects.
+ * The cache grows on demand to this size and shrinks back when
+ * cached buffers are idle, 0 disables caching.
+ */
+inline unsigned int
+get_exec_buffer_cache_size()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.exec_buffer_cache_size",128);
+  return value;
+}
+
+/**
+ * Number of microseconds to busy poll command state before blocking
+ * in xrt::run::wait().  Spinning reduces completion latency of short
+ * running kernels at the cost of CPU cycles, 0 disables spinning.
+ */
+inline unsigned int
+get_cmd_wait_spin_us()
+{
+  static unsigned int value = detail::get_uint_value("Runtime.cmd_wait_spin_us",0);
+  return value;
+}
+
 inline std::string
 get_hw_em_driver()
 {
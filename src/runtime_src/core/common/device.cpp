@@ -131,6 +131,16 @@ device::
   XRT_DEBUGF("xrt_core::device::~device(0x%x) idx(%d)\n", this, m_device_id);
 }
 
+std::shared_ptr<dma_queues>
+device::
+get_dma_queues(const std::function<std::shared_ptr<dma_queues>()>& create) const
+{
+  std::lock_guard<std::mutex> lk(m_dma_mutex);
+  if (!m_dma_queues)
+    m_dma_queues = create();
+  return m_dma_queues;
+}
+
 bool
 device::
 is_nodma() const
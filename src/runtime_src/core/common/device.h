@@ -30,6 +30,9 @@
 #include "core/include/experimental/xrt_xclbin.h"
 
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <map>
@@ -46,6 +49,9 @@ namespace xrt_core {
 
 using device_collection = std::vector<std::shared_ptr<xrt_core::device>>;
 
+// DMA worker queues for asynchronous buffer sync, see xrt_bo.cpp
+class dma_queues;
+
 /**
  * class device - interface to support OS agnositic operations on a device
  */
@@ -334,9 +340,22 @@ public:
     return {fd, std::bind(&device::close, this, fd)};
   }
 
+  /**
+   * get_dma_queues() - Get DMA worker queues for asynchronous buffer sync
+   *
+   * @create: Function that creates the queues on first call
+   *
+   * The queues are owned by the device and destroyed with it.
+   */
+  XRT_CORE_COMMON_EXPORT
+  std::shared_ptr<dma_queues>
+  get_dma_queues(const std::function<std::shared_ptr<dma_queues>()>& create) const;
+
  private:
   id_type m_device_id;
   mutable boost::optional<bool> m_nodma = boost::none;
+  mutable std::mutex m_dma_mutex;
+  mutable std::shared_ptr<dma_queues> m_dma_queues;
 
   std::vector<size_t> m_memidx_encoding; // compressed mem_toplogy indices
   std::vector<uint64_t> m_cus;           // cu base addresses in expeced sort order
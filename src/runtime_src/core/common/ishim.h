@@ -25,6 +25,7 @@
 #include "xcl_graph.h"
 #include "error.h"
 #include <stdexcept>
+#include <vector>
 
 // Internal shim function forward declarations
 int xclUpdateSchedulerStat(xclDeviceHandle handle);
@@ -146,6 +147,32 @@ struct ishim
   { throw xrt_core::error(std::errc::not_supported,"wait_ip_interrupt()"); }
   ////////////////////////////////////////////////////////////////
 
+  ////////////////////////////////////////////////////////////////
+  // Interfaces for command completion reporting
+  // Implemented explicitly by concrete shim device class
+  // Only supported for noop shim
+  ////////////////////////////////////////////////////////////////
+  // exec_wait_completed() - Wait for command completion and report
+  // the exec buffer handles of the commands that completed since last
+  // call.  Returns number of handles appended to @completed, 0 on
+  // timeout.
+  virtual size_t
+  exec_wait_completed(int, std::vector<xclBufferHandle>&) const
+  { throw xrt_core::error(std::errc::not_supported,"exec_wait_completed()"); }
+  ////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////
+  // Interfaces for batched command submission
+  // Implemented explicitly by concrete shim device class
+  // Only supported for noop shim
+  ////////////////////////////////////////////////////////////////
+  // exec_buf_list() - Submit a list of exec buffers for execution
+  // in one shim call.  The exec buffers are submitted in list order.
+  virtual void
+  exec_buf_list(const std::vector<xclBufferHandle>&)
+  { throw xrt_core::error(std::errc::not_supported,"exec_buf_list()"); }
+  ////////////////////////////////////////////////////////////////
+
 #ifdef XRT_ENABLE_AIE
   virtual xclGraphHandle
   open_graph(const xuid_t, const char*, xrt::graph::access_mode am) = 0;
@@ -25,6 +25,14 @@
 #include <functional>
 #include <chrono>
 #include <queue>
+#include <deque>
+#include <array>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <iostream>
@@ -233,7 +241,283 @@ public:
   }
 };
 
-using queue = mpmcqueue<task>;
+/**
+ * Multiple producer / multiple consumer work stealing queue
+ *
+ * Interface compatible with mpmcqueue, but the tasks are distributed
+ * over per consumer lanes each with its own lock.  A consumer thread
+ * is assigned a lane the first time it calls getWork() and keeps it
+ * until the thread exits, when the lane is handed to the next new
+ * consumer.  The consumer takes work from its own lane and steals
+ * from other lanes when its own lane is empty.
+ *
+ * Tasks added by a consumer thread go to the consumer's own lane,
+ * tasks added by other threads are distributed round robin over the
+ * lanes of the live consumers.
+ *
+ * Ordering differs from mpmcqueue: each lane is first-in-first-out,
+ * but with more than one consumer a task can be started before tasks
+ * added earlier to another lane.  With a single consumer the queue is
+ * first-in-first-out like mpmcqueue.
+ *
+ * Lanes are created as consumers arrive, getWork() throws
+ * std::runtime_error if more than max_lanes consumer threads use the
+ * queue at the same time.
+ *
+ * Idle consumers block on a condition variable that producers notify
+ * only when some consumer is actually waiting.
+ */
+template <typename Task>
+class stealing_queue
+{
+  static constexpr size_t max_lanes = 1024;
+
+  struct lane
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::atomic<bool> owned {false};    // assigned to a live consumer
+  };
+
+  // Shared with the consumer threads so a thread that exits after
+  // the queue is destructed does not touch a deleted queue
+  struct lane_table
+  {
+    std::array<std::atomic<lane*>, max_lanes> lanes;
+    std::atomic<size_t> size {0};       // lanes created so far
+    std::mutex mutex;                   // creation and free list
+    std::vector<size_t> free;           // lanes without consumer
+
+    lane_table()
+    {
+      for (auto& l : lanes)
+        l = nullptr;
+    }
+
+    ~lane_table()
+    {
+      for (size_t idx = 0; idx < size; ++idx)
+        delete lanes[idx].load();
+    }
+
+    lane&
+    operator[](size_t idx)
+    {
+      return *lanes[idx].load();
+    }
+
+    size_t
+    create()
+    {
+      auto idx = size.load();
+      if (idx == max_lanes)
+        throw std::runtime_error
+          ("task queue has more than " + std::to_string(max_lanes) + " consumer threads");
+      lanes[idx] = new lane;
+      size = idx + 1;   // publish after the lane exists
+      return idx;
+    }
+
+    size_t
+    acquire()
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      size_t idx = 0;
+      if (!free.empty()) {
+        idx = free.back();
+        free.pop_back();
+      }
+      else {
+        idx = create();
+      }
+      (*this)[idx].owned = true;
+      return idx;
+    }
+
+    void
+    release(size_t idx)
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      (*this)[idx].owned = false;
+      free.push_back(idx);
+    }
+  };
+
+  // Lanes of the calling thread by queue id, released when the
+  // thread exits.  Tasks left in a released lane are stolen by the
+  // other consumers.
+  struct thread_lanes
+  {
+    std::unordered_map<uint64_t, std::pair<std::weak_ptr<lane_table>, size_t>> lanes;
+
+    ~thread_lanes()
+    {
+      for (auto& entry : lanes)
+        if (auto table = entry.second.first.lock())
+          table->release(entry.second.second);
+    }
+  };
+
+  std::shared_ptr<lane_table> m_lanes;
+  std::atomic<size_t> m_next {0};       // round robin for producers
+  std::atomic<size_t> m_pending {0};    // tasks in all lanes
+  std::atomic<size_t> m_sleepers {0};   // consumers waiting for work
+  std::atomic<bool> m_stop {false};
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_work;
+  const uint64_t m_id;                  // unique id of this queue
+
+  static uint64_t
+  next_id()
+  {
+    static std::atomic<uint64_t> id {0};
+    return ++id;
+  }
+
+  // Lane assigned to calling thread for this queue or max_lanes if
+  // none, optionally assign a lane if thread has none
+  size_t
+  thread_lane(bool assign)
+  {
+    // most threads use one queue, cache the last lookup
+    static thread_local std::pair<uint64_t, size_t> last {0, max_lanes};
+    static thread_local thread_lanes owned;
+    if (last.first == m_id && (last.second != max_lanes || !assign))
+      return last.second;
+
+    auto itr = owned.lanes.find(m_id);
+    if (itr != owned.lanes.end()) {
+      last = std::make_pair(m_id, itr->second.second);
+      return last.second;
+    }
+
+    if (!assign) {
+      last = std::make_pair(m_id, max_lanes);
+      return max_lanes;
+    }
+
+    // Forget lanes of queues that no longer exist
+    for (auto entry = owned.lanes.begin(); entry != owned.lanes.end(); ) {
+      if (entry->second.first.expired())
+        entry = owned.lanes.erase(entry);
+      else
+        ++entry;
+    }
+
+    auto idx = m_lanes->acquire();
+    owned.lanes.emplace(m_id, std::make_pair(std::weak_ptr<lane_table>(m_lanes), idx));
+    last = std::make_pair(m_id, idx);
+    return idx;
+  }
+
+  // Next lane of a live consumer, any lane if there is none
+  size_t
+  producer_lane()
+  {
+    auto nlanes = m_lanes->size.load();
+    for (size_t i = 0; i < nlanes; ++i) {
+      auto idx = m_next++ % nlanes;
+      if ((*m_lanes)[idx].owned)
+        return idx;
+    }
+    return m_next++ % nlanes;
+  }
+
+  bool
+  try_pop(size_t idx, Task& task)
+  {
+    auto& l = (*m_lanes)[idx];
+    std::lock_guard<std::mutex> lk(l.mutex);
+    if (l.tasks.empty())
+      return false;
+    task = std::move(l.tasks.front());
+    l.tasks.pop_front();
+    --m_pending;
+    return true;
+  }
+
+  // Take work from own lane, else steal from other lanes
+  bool
+  try_get(size_t own, Task& task)
+  {
+    if (try_pop(own, task))
+      return true;
+    auto nlanes = m_lanes->size.load();
+    for (size_t i = 1; i < nlanes; ++i)
+      if (try_pop((own + i) % nlanes, task))
+        return true;
+    return false;
+  }
+
+public:
+  stealing_queue()
+    : m_lanes(std::make_shared<lane_table>())
+    , m_id(next_id())
+  {
+    // Producers always have a lane to add to
+    m_lanes->free.push_back(m_lanes->create());
+  }
+
+  explicit stealing_queue(bool)
+    : stealing_queue()
+  {}
+
+  void
+  addWork(Task&& t)
+  {
+    auto idx = thread_lane(false);
+    if (idx == max_lanes)
+      idx = producer_lane();
+
+    {
+      auto& l = (*m_lanes)[idx];
+      std::lock_guard<std::mutex> lk(l.mutex);
+      l.tasks.push_back(std::move(t));
+      ++m_pending;
+    }
+
+    // The sleep mutex orders this notification with a consumer that
+    // has found no pending work and is about to wait
+    if (m_sleepers) {
+      std::lock_guard<std::mutex> lk(m_sleep_mutex);
+      m_work.notify_one();
+    }
+  }
+
+  Task
+  getWork()
+  {
+    auto own = thread_lane(true);
+    Task task;
+    while (!m_stop) {
+      if (try_get(own, task))
+        return task;
+
+      std::unique_lock<std::mutex> lk(m_sleep_mutex);
+      ++m_sleepers;
+      while (!m_stop && !m_pending)
+        m_work.wait(lk);
+      --m_sleepers;
+    }
+    return Task();
+  }
+
+  size_t
+  size() const
+  {
+    return m_pending;
+  }
+
+  void
+  stop()
+  {
+    std::lock_guard<std::mutex> lk(m_sleep_mutex);
+    m_stop = true;
+    m_work.notify_all();
+  }
+};
+
+using queue = stealing_queue<task>;
 
 /**
  * event class wraps std::future<RT>
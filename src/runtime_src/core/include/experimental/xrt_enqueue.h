@@ -19,6 +19,7 @@
 #define _XRT_ENQUEUE_H_
 
 #ifdef __cplusplus
+# include "xrt/xrt_bo.h"
 # include <memory>
 # include <vector>
 # include <functional>
@@ -38,6 +39,16 @@ struct callable_traits
   enum { is_async = false };
 };
 
+/// @cond
+// Specialization for async sync handles, which are asynchronous
+// waitable objects.
+template <>
+struct callable_traits<bo::async_handle>
+{
+  enum { is_async = true };
+};
+/// @endcond
+
 /**
  * class event_queue -- producer / consumer queue for tasks
  *
@@ -54,9 +54,68 @@ namespace xrt {
 using memory_group = xrtMemoryGroup;
 
 class bo_impl;
+class bo_async_impl;
+class event_impl;
 class bo
 {
 public:
+  /**
+   * @class async_handle
+   *
+   * Waitable handle for an asynchronous buffer sync started
+   * with ``bo::async()``.
+   *
+   * An async_handle returned from a callable enqueued in an
+   * ``xrt::event_queue`` makes the enqueued event complete when the
+   * sync completes, so the event can be used as a dependency for
+   * other enqueued operations.
+   */
+  class async_handle
+  {
+  public:
+    /**
+     * async_handle() - Construct empty handle
+     */
+    async_handle() = default;
+
+    /**
+     * wait() - Wait for asynchronous sync to complete
+     *
+     * Rethrows any exception thrown by the sync operation.  Returns
+     * immediately for an empty handle.
+     */
+    XCL_DRIVER_DLLESPEC
+    void
+    wait() const;
+
+    /**
+     * ready() - Check if asynchronous sync has completed
+     *
+     * @return
+     *  True if sync has completed or handle is empty, false otherwise
+     */
+    XCL_DRIVER_DLLESPEC
+    bool
+    ready() const;
+
+    /// @cond
+    // set_event() - Add event for enqueued operations
+    //
+    // The event is notified upon completion of the sync.
+    XCL_DRIVER_DLLESPEC
+    void
+    set_event(const std::shared_ptr<event_impl>& event) const;
+
+    explicit
+    async_handle(std::shared_ptr<bo_async_impl> impl)
+      : handle(std::move(impl))
+    {}
+    /// @endcond
+
+  private:
+    std::shared_ptr<bo_async_impl> handle;
+  };
+
   /**
    * @enum flags - buffer object flags
    *
@@ -307,6 +366,44 @@ public:
     sync(dir, size(), 0);
   }
 
+  /**
+   * async() - Start asynchronous sync of buffer content with device side
+   *
+   * @param dir
+   *  To device or from device
+   * @param sz
+   *  Size of data to synchronize
+   * @param offset
+   *  Offset within the BO
+   * @return
+   *  Handle that can be waited on for completion of the sync
+   *
+   * The sync is executed by DMA worker threads of the device that
+   * owns the buffer, one set of workers per direction.  The number
+   * of workers per direction is controlled by ``dma_channels`` in
+   * the ``[Runtime]`` section of xrt.ini.
+   *
+   * The buffer must not be modified or synchronized otherwise until
+   * the asynchronous sync has completed.
+   */
+  XCL_DRIVER_DLLESPEC
+  async_handle
+  async(xclBOSyncDirection dir, size_t sz, size_t offset);
+
+  /**
+   * async() - Start asynchronous sync of entire buffer
+   *
+   * @param dir
+   *  To device or from device
+   * @return
+   *  Handle that can be waited on for completion of the sync
+   */
+  async_handle
+  async(xclBOSyncDirection dir)
+  {
+    return async(dir, size(), 0);
+  }
+
   /**
    * map() - Map the host side buffer into application
    *
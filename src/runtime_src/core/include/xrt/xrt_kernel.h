@@ -481,6 +481,82 @@ private:
     set_arg(++argno, std::forward<Args>(args)...);
   }
 };
+
+/*!
+ * @class run_batch
+ *
+ * A run_batch object is a list of run objects that are started
+ * together.
+ *
+ * Starting a batch prepares all runs and then submits them for
+ * execution in one go.  When supported by the platform, the runs are
+ * submitted with a single call per device, otherwise each run is
+ * submitted individually.  Runs are submitted in the order they were
+ * added to the batch.
+ *
+ * A run object must be added at most once to a batch, and a batch
+ * cannot be restarted until all its runs have completed.
+ */
+class run_batch_impl;
+class run_batch
+{
+ public:
+  /**
+   * run_batch() - Construct empty batch
+   */
+  XCL_DRIVER_DLLESPEC
+  run_batch();
+
+  /**
+   * add() - Add a run object to the batch
+   *
+   * @param r: Run object to add
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  add(const run& r);
+
+  /**
+   * size() - Number of run objects in the batch
+   */
+  XCL_DRIVER_DLLESPEC
+  size_t
+  size() const;
+
+  /**
+   * clear() - Remove all run objects from the batch
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  clear();
+
+  /**
+   * start() - Start one execution of all runs in the batch
+   *
+   * This function is asynchronous, ``wait()`` must be used to wait
+   * for the runs to complete.
+   *
+   * If any run in the batch is still running, or if a run cannot be
+   * prepared, an exception is thrown and none of the runs are
+   * started.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  start();
+
+  /**
+   * wait() - Wait for all runs in the batch to complete
+   *
+   * Completion does not guarantee success, the status of individual
+   * runs should be checked using ``run::state()``.
+   */
+  XCL_DRIVER_DLLESPEC
+  void
+  wait() const;
+
+private:
+  std::shared_ptr<run_batch_impl> handle;
+};
  
 
 /*!
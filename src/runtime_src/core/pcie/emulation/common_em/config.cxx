@@ -81,6 +81,7 @@ namespace xclemulation{
     mCuBaseAddrForce=-1;
     mIsSharedFmodel=true;
     mIsM2MEnabled = false;
+    mIsShmTransferEnabled = false;
     mTimeOutScale=TIMEOUT_SCALE::NA;
     mIsPlatformDataAvailable = false;
     mIsDisabledHostBuffer=false;
@@ -217,6 +218,9 @@ namespace xclemulation{
       else if (name == "enable_m2m") {
         mIsM2MEnabled = getBoolValue(value, false);
       }
+      else if (name == "enable_shm_transfer") {
+        mIsShmTransferEnabled = getBoolValue(value, false);
+      }
       else if (name == "host_buffer_sync") {
     	  mIsDisabledHostBuffer = getBoolValue(value, false);
       }
@@ -216,6 +216,7 @@ namespace xclemulation{
       inline long long getCuBaseAddrForce() const         { return mCuBaseAddrForce;              }
       inline bool isSharedFmodel() const         {return mIsSharedFmodel; } 
       inline bool isM2MEnabled() const { return mIsM2MEnabled; }
+      inline bool isShmTransferEnabled() const { return mIsShmTransferEnabled; }
       inline TIMEOUT_SCALE getTimeOutScale() const    {return mTimeOutScale;}
 
       inline void setIsPlatformEnabled(bool isPlatformDataAvailable) {mIsPlatformDataAvailable = isPlatformDataAvailable; }
@@ -255,6 +256,7 @@ namespace xclemulation{
       long long mCuBaseAddrForce;
       bool      mIsSharedFmodel;
       bool mIsM2MEnabled;
+      bool mIsShmTransferEnabled;
       bool mIsPlatformDataAvailable;
       bool mIsDisabledHostBuffer;
       TIMEOUT_SCALE mTimeOutScale;
@@ -1,5 +1,5 @@
 /**
- * Copyright (C) 2016-2017 Xilinx, Inc
+ * Copyright (C) 2016-2021 Xilinx, Inc
  *
  * Licensed under the Apache License, Version 2.0 (the "License"). You may
  * not use this file except in compliance with the License. A copy of the
@@ -19,10 +19,10 @@
 namespace xclemulation {
   MemoryManager::MemoryManager(uint64_t size, uint64_t start,
       unsigned alignment,std::string& tag ) : mSize(size), mStart(start), mAlignment(alignment), mTag(tag),
-  mCoalesceThreshold(4), mFreeSize(0)
+  mFreeSize(0)
   {
     assert(start % alignment == 0);
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
+    insertFree(mStart, mSize);
     mFreeSize = mSize;
   }
 
@@ -76,100 +76,85 @@ namespace xclemulation {
 	    }
     }
 
-    for (PairList::iterator i = mFreeBufferList.begin(), e = mFreeBufferList.end(); i != e; ++i) 
+    // Best fit, smallest free block that can hold size, lowest address first
+    SizeMap::iterator fit = mFreeSizeMap.lower_bound(std::make_pair(static_cast<uint64_t>(size), static_cast<uint64_t>(0)));
+    if (fit == mFreeSizeMap.end())
+      return result;
+
+    result = fit->second;
+    AddrMap::iterator i = mFreeBufferMap.find(result);
+    assert(i != mFreeBufferMap.end());
+    uint64_t blockSize = i->second;
+    eraseFree(i);
+    if (blockSize > size)
     {
-      if (i->second < size)
-        continue;
-      result = i->first;
-      if (i->second > size) 
-      {
-        // Resize the existing entry in freelist
-        i->first += size;
-        i->second -= size;
-      }
-      else 
-      {
-        // remove the exact match found
-        mFreeBufferList.erase(i);
-      }
-      mBusyBufferList.push_back(std::make_pair(result, size));
-      mFreeSize -= size;
-      break;
+      // Return the remainder of the block to the free maps
+      insertFree(result + size, blockSize - size);
     }
+    mBusyBufferMap.emplace(result, size);
+    mFreeSize -= size;
     return result;
   }
 
   void MemoryManager::free(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i == mBusyBufferList.end())
+    BusyMap::iterator b = mBusyBufferMap.find(buf);
+    if (b == mBusyBufferMap.end())
       return;
-    mFreeSize += i->second;
-    mFreeBufferList.push_back(std::make_pair(i->first, i->second));
-    mBusyBufferList.erase(i);
-    if (mFreeBufferList.size() > mCoalesceThreshold) {
-      coalesce();
+    uint64_t addr = b->first;
+    uint64_t size = b->second;
+    mBusyBufferMap.erase(b);
+    mFreeSize += size;
+
+    // Coalesce with the free block that ends where this one starts and
+    // the free block that starts where this one ends
+    AddrMap::iterator next = mFreeBufferMap.lower_bound(addr);
+    if (next != mFreeBufferMap.begin())
+    {
+      AddrMap::iterator prev = std::prev(next);
+      if (prev->first + prev->second == addr)
+      {
+        addr = prev->first;
+        size += prev->second;
+        eraseFree(prev);
+      }
     }
+    if (next != mFreeBufferMap.end() && (addr + size) == next->first)
+    {
+      size += next->second;
+      eraseFree(next);
+    }
+    insertFree(addr, size);
   }
 
-
-  void MemoryManager::coalesce()
+  void MemoryManager::insertFree(uint64_t addr, uint64_t size)
   {
-    // First sort the free buffers and then attempt to coalesce the neighbors
-    mFreeBufferList.sort();
-
-    PairList::iterator curr = mFreeBufferList.begin();
-    PairList::iterator next = curr;
-    ++next;
-    PairList::iterator last = mFreeBufferList.end();
-    while (next != last) {
-      if ((curr->first + curr->second) != next->first) {
-        // Non contiguous blocks
-        curr = next;
-        ++next;
-        continue;
-      }
-      // Coalesce curr and next
-      curr->second += next->second;
-      mFreeBufferList.erase(next);
-      next = curr;
-      ++next;
-    }
+    mFreeBufferMap.emplace(addr, size);
+    mFreeSizeMap.emplace(size, addr);
   }
 
-
-  MemoryManager::PairList::iterator MemoryManager::find(uint64_t buf)
+  void MemoryManager::eraseFree(AddrMap::iterator itr)
   {
-#if GCC_VERSION >= 40800
-    PairList::iterator i = std::find_if(mBusyBufferList.begin(), mBusyBufferList.end(), [&] (const PairList::value_type& s)
-        { return s.first == buf; });
-#else
-    PairList::iterator i = mBusyBufferList.begin();
-    PairList::iterator last  = mBusyBufferList.end();
-    while(i != last) {
-      if (i->first == buf)
-        break;
-      ++i;
-    }
-#endif
-    return i;
+    mFreeSizeMap.erase(std::make_pair(itr->second, itr->first));
+    mFreeBufferMap.erase(itr);
   }
 
   void MemoryManager::reset()
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    mFreeBufferList.clear();
-    mBusyBufferList.clear();
-    mFreeBufferList.push_back(std::make_pair(mStart, mSize));
+    mFreeBufferMap.clear();
+    mFreeSizeMap.clear();
+    mBusyBufferMap.clear();
+    insertFree(mStart, mSize);
     mFreeSize = 0;
   }
 
   std::pair<uint64_t, uint64_t> MemoryManager::lookup(uint64_t buf)
   {
     std::lock_guard<std::mutex> lock(mMemManagerMutex);
-    PairList::iterator i = find(buf);
-    if (i != mBusyBufferList.end())
+    BusyMap::iterator i = mBusyBufferMap.find(buf);
+    if (i != mBusyBufferMap.end())
       return *i;
     // Compiler bug -- Some versions of GCC C++11 compiler do not
     // like mNull directly inside std::make_pair, so capture mNull
@@ -178,4 +163,3 @@ namespace xclemulation {
     return std::make_pair(v, v);
   }
 }
-
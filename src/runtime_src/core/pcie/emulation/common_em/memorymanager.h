@@ -20,6 +20,9 @@
 #include <mutex>
 #include <list>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <iterator>
 #include <cassert>
 #include <algorithm>
 
@@ -30,20 +33,26 @@ namespace xclemulation
 {
 static std::map<uint64_t,uint64_t> DEFAULT_MAP;
 static std::string DEFAULT_TAG("");
+    // Free blocks are kept in an address ordered map, so that a freed
+    // block is coalesced with its neighbors immediately, and in a size
+    // ordered multimap for best-fit allocation.  Busy blocks are kept
+    // in a hash map by address.
     class MemoryManager 
     {
+        typedef std::map<uint64_t, uint64_t> AddrMap;                 // address -> size
+        typedef std::set<std::pair<uint64_t, uint64_t>> SizeMap;     // (size, address)
+        typedef std::unordered_map<uint64_t, uint64_t> BusyMap;       // address -> size
+
         std::mutex mMemManagerMutex;
-        std::list<std::pair<uint64_t, uint64_t> > mFreeBufferList;
-        std::list<std::pair<uint64_t, uint64_t> > mBusyBufferList;
+        AddrMap mFreeBufferMap;
+        SizeMap mFreeSizeMap;
+        BusyMap mBusyBufferMap;
         uint64_t mSize;
         uint64_t mStart;
         uint64_t mAlignment;
 	std::string mTag;
-        const unsigned mCoalesceThreshold;
         uint64_t mFreeSize;
 
-        typedef std::list<std::pair<uint64_t, uint64_t> > PairList;
-
     public:
 	static const uint64_t mNull = 0xffffffffffffffffull;
 	std::list<MemoryManager*> mChildMemories;
@@ -64,8 +73,8 @@ static std::string DEFAULT_TAG("");
         std::pair<uint64_t, uint64_t>lookup(uint64_t buf);
 
     private:
-        void coalesce();
-        PairList::iterator find(uint64_t buf);
+        void insertFree(uint64_t addr, uint64_t size);
+        void eraseFree(AddrMap::iterator itr);
     };
 }
 
@@ -100,6 +100,10 @@ namespace xclcpuemhal2 {
       message_size = 0x800000;
     }
     mCloseAll = false;
+    mShmFd = -1;
+    mShmData = nullptr;
+    mShmSize = 0;
+    mShmCopyFailed = false;
     bUnified = _unified;
     bXPR = _xpr;
     mIsKdsSwEmu = (xclemulation::is_sw_emulation()) ? xrt_core::config::get_flag_kds_sw_emu() : false;
@@ -909,6 +913,11 @@ namespace xclcpuemhal2 {
     src = (unsigned char*)src + seek;
     dest += seek;
 
+    if (auto shm = getShmAddress(dest, size)) {
+      std::memcpy(shm, src, size);
+      return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
@@ -933,6 +942,153 @@ namespace xclcpuemhal2 {
   }
 
 
+  bool CpuemShim::initShmTransfer()
+  {
+    if (mShmData)
+      return true;
+
+    // Sparse file in tmpfs, pages are allocated on first touch
+    static const size_t shmSize = 0x4000000;
+    char fileName[] = "/dev/shm/xrt_swemu_XXXXXX";
+    int fd = mkstemp(fileName);
+    if (fd == -1)
+      return false;
+
+    if (ftruncate(fd, shmSize) == -1) {
+      close(fd);
+      unlink(fileName);
+      return false;
+    }
+
+    void* data = mmap(0, shmSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      unlink(fileName);
+      return false;
+    }
+
+    mShmFileName = fileName;
+    mShmFd = fd;
+    mShmData = static_cast<char*>(data);
+    mShmSize = shmSize;
+    return true;
+  }
+
+  void CpuemShim::finiShmTransfer()
+  {
+    {
+      std::lock_guard<std::mutex> lk(mShmMtx);
+      for (auto& buffer : mShmBuffers) {
+        munmap(buffer.second.data, buffer.second.size);
+        unlink(buffer.second.fileName.c_str());
+      }
+      mShmBuffers.clear();
+    }
+
+    if (!mShmData)
+      return;
+
+    munmap(mShmData, mShmSize);
+    close(mShmFd);
+    unlink(mShmFileName.c_str());
+    mShmData = nullptr;
+    mShmFd = -1;
+    mShmSize = 0;
+  }
+
+  // Back the device buffer at base with a shared memory file.  On any
+  // failure the buffer is left to the socket transfers.
+  bool CpuemShim::createShmBuffer(uint64_t base, size_t size)
+  {
+    char fileName[] = "/dev/shm/xrt_swemu_XXXXXX";
+    int fd = mkstemp(fileName);
+    if (fd == -1)
+      return false;
+
+    if (ftruncate(fd, size) == -1) {
+      close(fd);
+      unlink(fileName);
+      return false;
+    }
+
+    void* data = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      unlink(fileName);
+      return false;
+    }
+
+    bool ack = false;
+    std::string sFileName(fileName);
+#ifndef _WINDOWS
+    xclImportBO_RPC_CALL(xclImportBO, sFileName, base, size);
+#endif
+    if (!ack) {
+      if (mLogStream.is_open())
+        mLogStream << __func__ << ", device process did not map " << sFileName << std::endl;
+      munmap(data, size);
+      unlink(fileName);
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lk(mShmMtx);
+    mShmBuffers[base] = {sFileName, static_cast<char*>(data), size};
+    return true;
+  }
+
+  void CpuemShim::freeShmBuffer(uint64_t base)
+  {
+    std::lock_guard<std::mutex> lk(mShmMtx);
+    auto itr = mShmBuffers.find(base);
+    if (itr == mShmBuffers.end())
+      return;
+
+    munmap(itr->second.data, itr->second.size);
+    unlink(itr->second.fileName.c_str());
+    mShmBuffers.erase(itr);
+  }
+
+  // Host address of a device range that lies within one shared memory
+  // backed buffer, nullptr otherwise
+  char* CpuemShim::getShmAddress(uint64_t addr, size_t size)
+  {
+    std::lock_guard<std::mutex> lk(mShmMtx);
+    auto itr = mShmBuffers.upper_bound(addr);
+    if (itr == mShmBuffers.begin())
+      return nullptr;
+    --itr;
+    uint64_t offset = addr - itr->first;
+    if (offset + size > itr->second.size)
+      return nullptr;
+    return itr->second.data + offset;
+  }
+
+  // Device process copies device memory into the shared memory region
+  // using the same request that serves P2P xclCopyBO. Only the control
+  // message goes over the socket.  Returns the number of bytes copied,
+  // the caller transfers the rest over the socket.
+  size_t CpuemShim::xclCopyBufferDevice2HostShm(void *dest, uint64_t src, size_t size)
+  {
+    size_t processed_bytes = 0;
+    while (processed_bytes < size) {
+      size_t c_size = std::min(size - processed_bytes, mShmSize);
+      bool ack = false;
+#ifndef _WINDOWS
+      xclCopyBO_RPC_CALL(xclCopyBO, src, mShmFileName, c_size, processed_bytes, 0);
+#endif
+      if (!ack) {
+        // Do not try again for every transfer
+        mShmCopyFailed = true;
+        std::cerr << "WARNING: [SW-EM] Shared memory transfer from device failed at offset "
+                  << processed_bytes << " of " << size << ", using the socket instead" << std::endl;
+        return processed_bytes;
+      }
+      std::memcpy(((unsigned char*)dest) + processed_bytes, mShmData, c_size);
+      processed_bytes += c_size;
+    }
+    return size;
+  }
+
   size_t CpuemShim::xclCopyBufferDevice2Host(void *dest, uint64_t src, size_t size, size_t skip)
   {
     if (mLogStream.is_open()) {
@@ -946,11 +1102,23 @@ namespace xclcpuemhal2 {
       launchTempProcess();
     }
     src += skip;
+
+    if (auto shm = getShmAddress(src, size)) {
+      std::memcpy(dest, shm, size);
+      return size;
+    }
+
+    unsigned int processed_bytes = 0;
+    if (xclemulation::config::getInstance()->isShmTransferEnabled() && !mShmCopyFailed && initShmTransfer()) {
+      processed_bytes = xclCopyBufferDevice2HostShm(dest, src, size);
+      if (processed_bytes == size)
+        return size;
+    }
+
     void *handle = this;
 
     unsigned int messageSize = get_messagesize();
     unsigned int c_size = messageSize;
-    unsigned int processed_bytes = 0;
 
     while(processed_bytes < size){
       if((size - processed_bytes) < messageSize){
@@ -1156,6 +1324,7 @@ namespace xclcpuemhal2 {
     free(ci_buf);
     free(ri_buf);
     free(buf);
+    finiShmTransfer();
 
     if (mLogStream.is_open())
     {
@@ -1237,6 +1406,8 @@ uint64_t CpuemShim::xoclCreateBo(xclemulation::xocl_create_bo* info)
   bool noHostMemory = xclemulation::no_host_memory(xobj.get()) || xclemulation::xocl_bo_host_only(xobj.get());
   std::string sFileName("");
   xobj->base = xclAllocDeviceBuffer2(size,XCL_MEM_DEVICE_RAM,ddr,noHostMemory,sFileName);
+  if (!noHostMemory && (xobj->base != xclemulation::MemoryManager::mNull) && xclemulation::config::getInstance()->isShmTransferEnabled())
+    createShmBuffer(xobj->base, size);
   xobj->filename = sFileName;
   xobj->size = size;
   xobj->userptr = NULL;
@@ -1354,6 +1525,8 @@ unsigned int CpuemShim::xclImportBO(int boGlobalHandle, unsigned flags)
       std::cout<<"ERROR HERE in importBO "<<std::endl;
       return -1;
     }
+    // The imported file backs the buffer instead of a shared memory file
+    freeShmBuffer(bo->base);
     mImportedBOs.insert(importedBo);
     bo->fd = boGlobalHandle;
     bool ack;
@@ -1555,6 +1728,7 @@ void CpuemShim::xclFreeBO(unsigned int boHandle)
   if(bo)
   {
     xclFreeDeviceBuffer(bo->base);
+    freeShmBuffer(bo->base);
     mXoclObjMap.erase(it);
   }
   PRINTENDFUNC;
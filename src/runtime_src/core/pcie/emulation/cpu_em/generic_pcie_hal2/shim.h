@@ -285,6 +285,32 @@ namespace xclcpuemhal2 {
       unsigned int message_size;
       bool simulator_started;
 
+      // Shared memory for bulk transfers, used when enable_shm_transfer
+      // is set in ini, so payload bypasses protobuf serialization and
+      // the socket.  Device buffers of BOs are backed by a /dev/shm file
+      // that the device process maps through the xclImportBO request
+      // used for P2P import; transfers in both directions are a memcpy
+      // on the host.  Other device ranges are read through a staging
+      // region that the device process writes into via xclCopyBO.
+      struct ShmBuffer {
+        std::string fileName;
+        char* data;
+        size_t size;
+      };
+      std::mutex mShmMtx;
+      std::map<uint64_t, ShmBuffer> mShmBuffers;  // by device address
+      std::string mShmFileName;
+      int mShmFd;
+      char* mShmData;
+      size_t mShmSize;
+      bool mShmCopyFailed;
+      bool initShmTransfer();
+      void finiShmTransfer();
+      bool createShmBuffer(uint64_t base, size_t size);
+      void freeShmBuffer(uint64_t base);
+      char* getShmAddress(uint64_t addr, size_t size);
+      size_t xclCopyBufferDevice2HostShm(void *dest, uint64_t src, size_t size);
+
       std::ofstream mLogStream;
       xclVerbosityLevel mVerbosity;
 
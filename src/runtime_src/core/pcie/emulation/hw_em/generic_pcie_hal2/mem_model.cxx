@@ -16,12 +16,22 @@
 
 #include "mem_model.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+
 mem_model::~ mem_model()
 {
-  serialize();
+  // Shared file mappings, the contents stay in the region files
+  for (auto& entry : regions)
+    munmap(entry.second.base, (0x1ULL << REGIONBITS));
 }
 
 mem_model::mem_model(std::string deviceName):
+  last_region_idx(0),
+  last_region(nullptr),
   mDeviceName(deviceName),
   module_name("dr_wrapper_dr_i_sdaccel_generic_pcie_0.sdaccel_generic_pcie_model.ddrx_top_tlm_model_0.axi_app_tlm_model_0")
 {
@@ -37,7 +47,7 @@ mem_model::mem_model(std::string deviceName):
       while(written_bytes < size){
           uint64_t src_offset = written_bytes;
 
-          unsigned char* page_ptr  = get_page(addr);
+          unsigned char* page_ptr  = get_page(addr, true);
           uint64_t       page_addr = addr & ~(-1 << ADDRBITS);
 
           unsigned char* dest_buf_ptr = page_ptr + page_addr;
@@ -84,7 +94,7 @@ mem_model::mem_model(std::string deviceName):
 	  while(read_bytes < size){
 		  uint64_t dest_offset = read_bytes;
 
-		  unsigned char* page_ptr  = get_page(addr);
+		  unsigned char* page_ptr  = get_page(addr, false);
 		  uint64_t       page_addr = addr & ~(-1 << ADDRBITS);
 
 		  unsigned char* src_buf_ptr = page_ptr + page_addr;
@@ -118,92 +128,134 @@ mem_model::mem_model(std::string deviceName):
 
 	  return 0;
   }
-  unsigned char* mem_model::get_page(uint64_t offset) {
-	  uint64_t page_idx = offset >> ADDRBITS;
-	  std::string file_name = get_mem_file_name(page_idx);
-	  if(pageCache.size() > N_1MBARRAYS)
-	  {
-		  std::cerr << "Out of Memory. DDR model does not support this much of memory\n";
-		  exit(1);
-	  } else {
-      FILE* pFile = NULL;
-		  if(pageCache.find(page_idx) != pageCache.end())
-		  {
-			  return pageCache[page_idx];
-		  } else if(((pFile = fopen(file_name.c_str(),"r")) != NULL)) {
-			  int fhandle = fileno(pFile);
+  mem_model::region* mem_model::get_region(uint64_t region_idx) {
+	  if (last_region && last_region_idx == region_idx)
+		  return last_region;
 
-			  if (deserialize_msg.ParseFromFileDescriptor(fhandle) == false)
-        {
-          fclose(pFile);
-          exit(1);
-        }
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-
-			  memcpy(pageCache[page_idx],deserialize_msg.data().c_str(),PAGESIZE);
-			  fclose(pFile);
-			  return pageCache[page_idx];
-		  } else {
-			  pageCache[page_idx] = new unsigned char[PAGESIZE];
-			  return pageCache[page_idx];
+	  auto itr = regions.find(region_idx);
+	  if (itr == regions.end()) {
+		  // Sparse region file, disk blocks and physical pages are
+		  // allocated on first write and first touch respectively
+		  std::string file_name = get_region_file_name(region_idx);
+		  bool exists = (access(file_name.c_str(), F_OK) == 0);
+		  int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+		  if (fd == -1)
+			  throw std::runtime_error("DDR model failed to open " + file_name + ": " + strerror(errno));
+		  if (ftruncate(fd, (0x1ULL << REGIONBITS)) == -1) {
+			  int err = errno;
+			  close(fd);
+			  throw std::runtime_error("DDR model failed to size " + file_name + ": " + strerror(err));
 		  }
+		  void* base = mmap(NULL, (0x1ULL << REGIONBITS), PROT_READ | PROT_WRITE,
+				    MAP_SHARED | MAP_NORESERVE, fd, 0);
+		  int err = errno;
+		  close(fd);
+		  if (base == MAP_FAILED)
+			  throw std::runtime_error("DDR model failed to map " + file_name + ": " + strerror(err));
+		  region r;
+		  r.base = static_cast<unsigned char*>(base);
+		  r.import = !exists;
+		  r.touched.resize(PAGES_PER_REGION, false);
+		  r.dirty.resize(PAGES_PER_REGION, false);
+		  itr = regions.emplace(region_idx, std::move(r)).first;
 	  }
+
+	  last_region_idx = region_idx;
+	  last_region = &itr->second;
+	  return last_region;
   }
 
+  unsigned char* mem_model::get_page(uint64_t offset, bool write) {
+	  uint64_t page_idx = offset >> ADDRBITS;
+	  region* r = get_region(offset >> REGIONBITS);
+	  uint64_t region_page = page_idx & (PAGES_PER_REGION - 1);
+	  unsigned char* page_ptr = r->base + (region_page << ADDRBITS);
+	  if (!r->touched[region_page]) {
+		  r->touched[region_page] = true;
+		  if (r->import)
+			  import_page(page_idx, page_ptr);
+	  }
+	  if (write)
+		  r->dirty[region_page] = true;
+	  return page_ptr;
+  }
+
+  void mem_model::import_page(uint64_t page_idx, unsigned char* page_ptr) {
+	  std::string file_name = get_mem_file_name(page_idx);
+	  FILE* pFile = fopen(file_name.c_str(),"r");
+	  if (!pFile)
+		  return;
 
-  void mem_model::serialize() {
-     FILE *pFile;
-     int fhandle;
-     for (pageCacheItr=pageCache.begin(); pageCacheItr != pageCache.end(); ++pageCacheItr)
+	  int fhandle = fileno(pFile);
+	  bool parsed = deserialize_msg.ParseFromFileDescriptor(fhandle);
+	  fclose(pFile);
+	  if (!parsed)
+		  throw std::runtime_error("DDR model failed to parse " + file_name);
+	  memcpy(page_ptr,deserialize_msg.data().c_str(),std::min<size_t>(PAGESIZE,deserialize_msg.data().size()));
+  }
+
+  void mem_model::export_pages() {
+     for (auto& entry : regions)
      {
-        std::string file_name = get_mem_file_name(pageCacheItr->first);
-        pFile = fopen(file_name.c_str(),"w+");
-        if(!pFile)
-          continue;
-        fhandle = fileno(pFile);
-        if(fhandle == -1)
+        region& r = entry.second;
+        for (uint64_t region_page = 0; region_page < PAGES_PER_REGION; ++region_page)
         {
-          fclose(pFile);
-          exit(1);
-        }
+          if (!r.dirty[region_page])
+            continue;
+          uint64_t page_idx = (entry.first << (REGIONBITS - ADDRBITS)) + region_page;
+          std::string file_name = get_mem_file_name(page_idx);
+          FILE* pFile = fopen(file_name.c_str(),"w+");
+          if(!pFile)
+            throw std::runtime_error("DDR model failed to open " + file_name + ": " + strerror(errno));
 
-        serialize_msg.set_data(reinterpret_cast<const char*>(pageCacheItr->second),PAGESIZE);
-        if(serialize_msg.SerializeToFileDescriptor(fhandle) == false)
-        {
+          serialize_msg.set_data(reinterpret_cast<const char*>(r.base + (region_page << ADDRBITS)),PAGESIZE);
+          bool serialized = serialize_msg.SerializeToFileDescriptor(fileno(pFile));
           fclose(pFile);
-          exit(1);
+          if (!serialized)
+            throw std::runtime_error("DDR model failed to write " + file_name);
         }
-        fclose(pFile);
      }
   }
 
+ std::string mem_model::get_region_file_name(uint64_t region_idx)
+ {
+   return get_mem_dir() + "region_" + std::to_string(region_idx) + ".mem";
+ }
+
  std::string mem_model::get_mem_file_name(uint64_t pageIdx)
  {
-   std::string file_name("");
-   std::string user("");
-   char* cUser = getenv("USER");
-   if(cUser)
-   {
-     user = cUser;
-   }
-   std::string file_path("");
-   if(mDeviceName.empty() == false)
-     file_path = "/tmp/" + user + "/" + std::to_string(getpid()) + "/hw_em/" + mDeviceName + "/" + module_name + "/";
-    else
-     file_path = "/tmp/" + user + "/hw_em/" + module_name + "/";
-   std::stringstream mkdirCommand;
-   mkdirCommand<<"mkdir -p "<<file_path;;
-   struct stat statBuf;
-   if ( stat(file_path.c_str(), &statBuf) == -1 )
-   {
-     int rV = system(mkdirCommand.str().c_str());
-     if(rV == -1) {std::cout<<"unable to open/create mem file"<<std::endl;}
-   }
-    file_name = file_path + module_name + "_" + std::to_string(pageIdx);
+   std::string file_name = get_mem_dir() + module_name + "_" + std::to_string(pageIdx);
 #ifdef DEBUGMSG
       cout<<"ddr fmodel file_name: "<< file_name<<endl;
 #endif
     return file_name;
  }
 
-
+ std::string mem_model::get_mem_dir()
+ {
+   // The directory is created once, on first use
+   if (mem_file_path.empty())
+   {
+     std::string user("");
+     char* cUser = getenv("USER");
+     if(cUser)
+     {
+       user = cUser;
+     }
+     std::string file_path("");
+     if(mDeviceName.empty() == false)
+       file_path = "/tmp/" + user + "/" + std::to_string(getpid()) + "/hw_em/" + mDeviceName + "/" + module_name + "/";
+     else
+       file_path = "/tmp/" + user + "/hw_em/" + module_name + "/";
+     std::stringstream mkdirCommand;
+     mkdirCommand<<"mkdir -p "<<file_path;;
+     struct stat statBuf;
+     if ( stat(file_path.c_str(), &statBuf) == -1 )
+     {
+       int rV = system(mkdirCommand.str().c_str());
+       if(rV == -1) {std::cout<<"unable to open/create mem file"<<std::endl;}
+     }
+     mem_file_path = file_path;
+   }
+   return mem_file_path;
+ }
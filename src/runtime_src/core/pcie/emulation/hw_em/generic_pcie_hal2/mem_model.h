@@ -1,5 +1,5 @@
 /**
- * Copyright (C) 2016-2017 Xilinx, Inc
+ * Copyright (C) 2016-2021 Xilinx, Inc
  *
  * Licensed under the Apache License, Version 2.0 (the "License"). You may
  * not use this file except in compliance with the License. A copy of the
@@ -23,6 +23,8 @@
 #include <sstream> // memcpy
 #include <stdlib.h> //realloc
 #include <map> //realloc
+#include <unordered_map>
+#include <vector>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -33,23 +35,51 @@
 #define ONE_MB (ONE_KB * ONE_KB)
 #define PAGESIZE (ONE_MB)
 #define ADDRBITS (20)
-#define N_1MBARRAYS 4096
+#define REGIONBITS (30)
+#define PAGES_PER_REGION (1 << (REGIONBITS - ADDRBITS))
 
+// Device memory is modelled as sparse 1GB regions, each a shared
+// mapping of a sparse file created on first access to any address in
+// the region.  Physical pages are allocated on first touch, so memory
+// usage is proportional to memory accessed, and there is no limit on
+// model size other than address space.  The region files are the
+// persistent store, contents are written back through the page cache
+// without any serialization.
+//
+// Per page ddr_mem_msg files are the interchange format with the
+// simulator.  They are only written by an explicit export_pages(),
+// which writes the pages that have been written since the model was
+// created.  Page files from a previous export are imported on first
+// access into a region whose file did not exist yet.
 class mem_model{
 public:
 unsigned int writeDevMem(uint64_t offset, const void* src, unsigned int size);
 unsigned int readDevMem(uint64_t offset, void* dest, unsigned int size);
+void export_pages();
 
 protected:
 private:
-  unsigned char* get_page(uint64_t offset);
+  struct region
+  {
+    unsigned char* base;
+    bool import;               // region file is new, import page files
+    std::vector<bool> touched; // page accessed, imported if needed
+    std::vector<bool> dirty;   // page written
+  };
+
+  unsigned char* get_page(uint64_t offset, bool write);
+  region* get_region(uint64_t region_idx);
+  void import_page(uint64_t page_idx, unsigned char* page_ptr);
+  std::string get_mem_dir();
   std::string get_mem_file_name(uint64_t pageIdx);
-  std::map<uint64_t,unsigned char*> pageCache;
-  std::map<uint64_t,unsigned char*>::iterator pageCacheItr;
+  std::string get_region_file_name(uint64_t region_idx);
+  std::unordered_map<uint64_t,region> regions;
+  uint64_t last_region_idx;
+  region* last_region;
+  std::string mem_file_path;
 
   ddr_mem_msg serialize_msg;
   ddr_mem_msg deserialize_msg;
-  void serialize();
   std::string mDeviceName;
   std::string module_name;
 public:
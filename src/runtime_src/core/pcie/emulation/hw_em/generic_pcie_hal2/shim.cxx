@@ -452,6 +452,8 @@ namespace xclhwemhal2 {
 
     if (mMemModel)
     {
+      // Hand memory written so far over to the simulator
+      mMemModel->export_pages();
       delete mMemModel;
       mMemModel = NULL;
     }
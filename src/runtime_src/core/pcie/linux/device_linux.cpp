@@ -20,8 +20,10 @@
 #include "core/pcie/driver/linux/include/mgmt-ioctl.h"
 
 #include "common/utils.h"
+#include "common/config_reader.h"
 #include "xrt.h"
 #include "scan.h"
+#include <chrono>
 #include <string>
 #include <iostream>
 #include <map>
@@ -246,6 +248,18 @@ struct sysfs_fcn
     return value;
   }
 
+  static ValueType
+  get(const pdev& dev, const char* subdev, const char* entry,
+      std::chrono::milliseconds ttl)
+  {
+    std::string err;
+    ValueType value;
+    dev->sysfs_get_cached(subdev, entry, ttl, err, value, static_cast<ValueType>(-1));
+    if (!err.empty())
+      throw std::runtime_error(err);
+    return value;
+  }
+
   static void
   put(const pdev& dev, const char* subdev, const char* entry, ValueType value)
   {
@@ -336,6 +350,27 @@ struct sysfs_get : virtual QueryRequestType
   }
 };
 
+// Sensors are polled by monitoring tools, their values are read
+// through the per device sysfs cache
+template <typename QueryRequestType>
+struct sysfs_sensor : virtual QueryRequestType
+{
+  const char* subdev;
+  const char* entry;
+
+  sysfs_sensor(const char* s, const char* e)
+    : subdev(s), entry(e)
+  {}
+
+  boost::any
+  get(const xrt_core::device* device) const
+  {
+    static std::chrono::milliseconds ttl(xrt_core::config::get_sensor_ttl_ms());
+    return sysfs_fcn<typename QueryRequestType::result_type>
+      ::get(get_pcidev(device), subdev, entry, ttl);
+  }
+};
+
 template <typename QueryRequestType>
 struct sysfs_put : virtual QueryRequestType
 {
@@ -384,6 +419,14 @@ emplace_sysfs_get(const char* subdev, const char* entry)
   query_tbl.emplace(x, std::make_unique<sysfs_get<QueryRequestType>>(subdev, entry));
 }
 
+template <typename QueryRequestType>
+static void
+emplace_sysfs_sensor(const char* subdev, const char* entry)
+{
+  auto x = QueryRequestType::key;
+  query_tbl.emplace(x, std::make_unique<sysfs_sensor<QueryRequestType>>(subdev, entry));
+}
+
 template <typename QueryRequestType, typename Getter>
 static void
 emplace_func0_request()
@@ -460,61 +503,61 @@ initialize_query_table()
   emplace_sysfs_get<query::nodma>                              ("", "nodma");
   emplace_sysfs_get<query::dna_serial_num>                     ("dna", "dna");
   emplace_sysfs_get<query::p2p_config>                         ("p2p", "config");
-  emplace_sysfs_get<query::temp_card_top_front>                ("xmc", "xmc_se98_temp0");
-  emplace_sysfs_get<query::temp_card_top_rear>                 ("xmc", "xmc_se98_temp1");
-  emplace_sysfs_get<query::temp_card_bottom_front>             ("xmc", "xmc_se98_temp2");
-  emplace_sysfs_get<query::temp_fpga>                          ("xmc", "xmc_fpga_temp");
-  emplace_sysfs_get<query::fan_trigger_critical_temp>          ("xmc", "xmc_fan_temp");
+  emplace_sysfs_sensor<query::temp_card_top_front>             ("xmc", "xmc_se98_temp0");
+  emplace_sysfs_sensor<query::temp_card_top_rear>              ("xmc", "xmc_se98_temp1");
+  emplace_sysfs_sensor<query::temp_card_bottom_front>          ("xmc", "xmc_se98_temp2");
+  emplace_sysfs_sensor<query::temp_fpga>                       ("xmc", "xmc_fpga_temp");
+  emplace_sysfs_sensor<query::fan_trigger_critical_temp>       ("xmc", "xmc_fan_temp");
   emplace_sysfs_get<query::fan_fan_presence>                   ("xmc", "fan_presence");
-  emplace_sysfs_get<query::fan_speed_rpm>                      ("xmc", "xmc_fan_rpm");
-  emplace_sysfs_get<query::ddr_temp_0>                         ("xmc", "xmc_ddr_temp0");
-  emplace_sysfs_get<query::ddr_temp_1>                         ("xmc", "xmc_ddr_temp1");
-  emplace_sysfs_get<query::ddr_temp_2>                         ("xmc", "xmc_ddr_temp2");
-  emplace_sysfs_get<query::ddr_temp_3>                         ("xmc", "xmc_ddr_temp3");
-  emplace_sysfs_get<query::hbm_temp>                           ("xmc", "xmc_hbm_temp");
-  emplace_sysfs_get<query::cage_temp_0>                        ("xmc", "xmc_cage_temp0");
-  emplace_sysfs_get<query::cage_temp_1>                        ("xmc", "xmc_cage_temp1");
-  emplace_sysfs_get<query::cage_temp_2>                        ("xmc", "xmc_cage_temp2");
-  emplace_sysfs_get<query::cage_temp_3>                        ("xmc", "xmc_cage_temp3");
-  emplace_sysfs_get<query::v12v_pex_millivolts>                ("xmc", "xmc_12v_pex_vol");
-  emplace_sysfs_get<query::v12v_pex_milliamps>                 ("xmc", "xmc_12v_pex_curr");
-  emplace_sysfs_get<query::v12v_aux_millivolts>                ("xmc", "xmc_12v_aux_vol");
-  emplace_sysfs_get<query::v12v_aux_milliamps>                 ("xmc", "xmc_12v_aux_curr");
-  emplace_sysfs_get<query::v3v3_pex_millivolts>                ("xmc", "xmc_3v3_pex_vol");
-  emplace_sysfs_get<query::v3v3_aux_millivolts>                ("xmc", "xmc_3v3_aux_vol");
-  emplace_sysfs_get<query::v3v3_aux_milliamps>                 ("xmc", "xmc_3v3_aux_cur");
-  emplace_sysfs_get<query::ddr_vpp_bottom_millivolts>          ("xmc", "xmc_ddr_vpp_btm");
-  emplace_sysfs_get<query::ddr_vpp_top_millivolts>             ("xmc", "xmc_ddr_vpp_top");
-
-  emplace_sysfs_get<query::v5v5_system_millivolts>             ("xmc", "xmc_sys_5v5");
-  emplace_sysfs_get<query::v1v2_vcc_top_millivolts>            ("xmc", "xmc_1v2_top");
-  emplace_sysfs_get<query::v1v2_vcc_bottom_millivolts>         ("xmc", "xmc_vcc1v2_btm");
-  emplace_sysfs_get<query::v1v8_millivolts>                    ("xmc", "xmc_1v8");
-  emplace_sysfs_get<query::v0v85_millivolts>                   ("xmc", "xmc_0v85");
-  emplace_sysfs_get<query::v0v9_vcc_millivolts>                ("xmc", "xmc_mgt0v9avcc");
-  emplace_sysfs_get<query::v12v_sw_millivolts>                 ("xmc", "xmc_12v_sw");
-  emplace_sysfs_get<query::mgt_vtt_millivolts>                 ("xmc", "xmc_mgtavtt");
-  emplace_sysfs_get<query::int_vcc_millivolts>                 ("xmc", "xmc_vccint_vol");
-  emplace_sysfs_get<query::int_vcc_milliamps>                  ("xmc", "xmc_vccint_curr");
-  emplace_sysfs_get<query::int_vcc_temp>                       ("xmc", "xmc_vccint_temp");
-
-  emplace_sysfs_get<query::v12_aux1_millivolts>                ("xmc", "xmc_12v_aux1");
-  emplace_sysfs_get<query::vcc1v2_i_milliamps>                 ("xmc", "xmc_vcc1v2_i");
-  emplace_sysfs_get<query::v12_in_i_milliamps>                 ("xmc", "xmc_v12_in_i");
-  emplace_sysfs_get<query::v12_in_aux0_i_milliamps>            ("xmc", "xmc_v12_in_aux0_i");
-  emplace_sysfs_get<query::v12_in_aux1_i_milliamps>            ("xmc", "xmc_v12_in_aux1_i");
-  emplace_sysfs_get<query::vcc_aux_millivolts>                 ("xmc", "xmc_vccaux");
-  emplace_sysfs_get<query::vcc_aux_pmc_millivolts>             ("xmc", "xmc_vccaux_pmc");
-  emplace_sysfs_get<query::vcc_ram_millivolts>                 ("xmc", "xmc_vccram");
-
-  emplace_sysfs_get<query::v3v3_pex_milliamps>                 ("xmc", "xmc_3v3_pex_curr");
-  emplace_sysfs_get<query::v3v3_aux_milliamps>                 ("xmc", "xmc_3v3_aux_cur");
-  emplace_sysfs_get<query::int_vcc_io_milliamps>               ("xmc", "xmc_0v85_curr");
-  emplace_sysfs_get<query::v3v3_vcc_millivolts>                ("xmc", "xmc_3v3_vcc_vol");
-  emplace_sysfs_get<query::hbm_1v2_millivolts>                 ("xmc", "xmc_hbm_1v2_vol");
-  emplace_sysfs_get<query::v2v5_vpp_millivolts>                ("xmc", "xmc_vpp2v5_vol");
-  emplace_sysfs_get<query::int_vcc_io_millivolts>              ("xmc", "xmc_vccint_bram_vol");
-  emplace_sysfs_get<query::v0v9_int_vcc_vcu_millivolts>        ("xmc", "xmc_vccint_vcu_0v9");
+  emplace_sysfs_sensor<query::fan_speed_rpm>                   ("xmc", "xmc_fan_rpm");
+  emplace_sysfs_sensor<query::ddr_temp_0>                      ("xmc", "xmc_ddr_temp0");
+  emplace_sysfs_sensor<query::ddr_temp_1>                      ("xmc", "xmc_ddr_temp1");
+  emplace_sysfs_sensor<query::ddr_temp_2>                      ("xmc", "xmc_ddr_temp2");
+  emplace_sysfs_sensor<query::ddr_temp_3>                      ("xmc", "xmc_ddr_temp3");
+  emplace_sysfs_sensor<query::hbm_temp>                        ("xmc", "xmc_hbm_temp");
+  emplace_sysfs_sensor<query::cage_temp_0>                     ("xmc", "xmc_cage_temp0");
+  emplace_sysfs_sensor<query::cage_temp_1>                     ("xmc", "xmc_cage_temp1");
+  emplace_sysfs_sensor<query::cage_temp_2>                     ("xmc", "xmc_cage_temp2");
+  emplace_sysfs_sensor<query::cage_temp_3>                     ("xmc", "xmc_cage_temp3");
+  emplace_sysfs_sensor<query::v12v_pex_millivolts>             ("xmc", "xmc_12v_pex_vol");
+  emplace_sysfs_sensor<query::v12v_pex_milliamps>              ("xmc", "xmc_12v_pex_curr");
+  emplace_sysfs_sensor<query::v12v_aux_millivolts>             ("xmc", "xmc_12v_aux_vol");
+  emplace_sysfs_sensor<query::v12v_aux_milliamps>              ("xmc", "xmc_12v_aux_curr");
+  emplace_sysfs_sensor<query::v3v3_pex_millivolts>             ("xmc", "xmc_3v3_pex_vol");
+  emplace_sysfs_sensor<query::v3v3_aux_millivolts>             ("xmc", "xmc_3v3_aux_vol");
+  emplace_sysfs_sensor<query::v3v3_aux_milliamps>              ("xmc", "xmc_3v3_aux_cur");
+  emplace_sysfs_sensor<query::ddr_vpp_bottom_millivolts>       ("xmc", "xmc_ddr_vpp_btm");
+  emplace_sysfs_sensor<query::ddr_vpp_top_millivolts>          ("xmc", "xmc_ddr_vpp_top");
+
+  emplace_sysfs_sensor<query::v5v5_system_millivolts>          ("xmc", "xmc_sys_5v5");
+  emplace_sysfs_sensor<query::v1v2_vcc_top_millivolts>         ("xmc", "xmc_1v2_top");
+  emplace_sysfs_sensor<query::v1v2_vcc_bottom_millivolts>      ("xmc", "xmc_vcc1v2_btm");
+  emplace_sysfs_sensor<query::v1v8_millivolts>                 ("xmc", "xmc_1v8");
+  emplace_sysfs_sensor<query::v0v85_millivolts>                ("xmc", "xmc_0v85");
+  emplace_sysfs_sensor<query::v0v9_vcc_millivolts>             ("xmc", "xmc_mgt0v9avcc");
+  emplace_sysfs_sensor<query::v12v_sw_millivolts>              ("xmc", "xmc_12v_sw");
+  emplace_sysfs_sensor<query::mgt_vtt_millivolts>              ("xmc", "xmc_mgtavtt");
+  emplace_sysfs_sensor<query::int_vcc_millivolts>              ("xmc", "xmc_vccint_vol");
+  emplace_sysfs_sensor<query::int_vcc_milliamps>               ("xmc", "xmc_vccint_curr");
+  emplace_sysfs_sensor<query::int_vcc_temp>                    ("xmc", "xmc_vccint_temp");
+
+  emplace_sysfs_sensor<query::v12_aux1_millivolts>             ("xmc", "xmc_12v_aux1");
+  emplace_sysfs_sensor<query::vcc1v2_i_milliamps>              ("xmc", "xmc_vcc1v2_i");
+  emplace_sysfs_sensor<query::v12_in_i_milliamps>              ("xmc", "xmc_v12_in_i");
+  emplace_sysfs_sensor<query::v12_in_aux0_i_milliamps>         ("xmc", "xmc_v12_in_aux0_i");
+  emplace_sysfs_sensor<query::v12_in_aux1_i_milliamps>         ("xmc", "xmc_v12_in_aux1_i");
+  emplace_sysfs_sensor<query::vcc_aux_millivolts>              ("xmc", "xmc_vccaux");
+  emplace_sysfs_sensor<query::vcc_aux_pmc_millivolts>          ("xmc", "xmc_vccaux_pmc");
+  emplace_sysfs_sensor<query::vcc_ram_millivolts>              ("xmc", "xmc_vccram");
+
+  emplace_sysfs_sensor<query::v3v3_pex_milliamps>              ("xmc", "xmc_3v3_pex_curr");
+  emplace_sysfs_sensor<query::v3v3_aux_milliamps>              ("xmc", "xmc_3v3_aux_cur");
+  emplace_sysfs_sensor<query::int_vcc_io_milliamps>            ("xmc", "xmc_0v85_curr");
+  emplace_sysfs_sensor<query::v3v3_vcc_millivolts>             ("xmc", "xmc_3v3_vcc_vol");
+  emplace_sysfs_sensor<query::hbm_1v2_millivolts>              ("xmc", "xmc_hbm_1v2_vol");
+  emplace_sysfs_sensor<query::v2v5_vpp_millivolts>             ("xmc", "xmc_vpp2v5_vol");
+  emplace_sysfs_sensor<query::int_vcc_io_millivolts>           ("xmc", "xmc_vccint_bram_vol");
+  emplace_sysfs_sensor<query::v0v9_int_vcc_vcu_millivolts>     ("xmc", "xmc_vccint_vcu_0v9");
   emplace_sysfs_get<query::mac_contiguous_num>                 ("xmc", "mac_contiguous_num");
   emplace_sysfs_get<query::mac_addr_first>                     ("xmc", "mac_addr_first");
   emplace_sysfs_get<query::oem_id>                             ("xmc", "xmc_oem_id");
@@ -525,7 +568,7 @@ initialize_query_table()
   emplace_sysfs_get<query::firewall_status>                   ("firewall", "detected_status");
   emplace_sysfs_get<query::firewall_time_sec>                 ("firewall", "detected_time");
 
-  emplace_sysfs_get<query::power_microwatts>                  ("xmc", "xmc_power");
+  emplace_sysfs_sensor<query::power_microwatts>               ("xmc", "xmc_power");
   emplace_sysfs_get<query::power_warning>                     ("xmc", "xmc_power_warn");
   emplace_sysfs_get<query::host_mem_size>                     ("address_translator", "host_mem_size");
   emplace_sysfs_get<query::kds_numcdmas>                      ("mb_scheduler", "kds_numcdmas");
@@ -26,7 +26,10 @@
 #include <cstring>
 #include <unistd.h>
 #include <algorithm>
+#include <map>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <regex>
 #include <sys/stat.h>
 #include <sys/file.h>
@@ -173,17 +176,81 @@ namespace pcidev {
 
 namespace sysfs {
 
-static const std::string dev_root = "/sys/bus/pci/devices/";
-static const std::string drv_root = "/sys/bus/pci/drivers/";
+// The sysfs root can be redirected to a fake directory tree with
+// XRT_SYSFS_ROOT, which allows testing without hardware.
+static std::string
+get_root()
+{
+  auto root = std::getenv("XRT_SYSFS_ROOT");
+  return root ? root : "/sys";
+}
+
+static const std::string&
+dev_root()
+{
+  static const std::string path = get_root() + "/bus/pci/devices/";
+  return path;
+}
+
+static const std::string&
+drv_root()
+{
+  static const std::string path = get_root() + "/bus/pci/drivers/";
+  return path;
+}
+
+// Subdevice directory names found by scanning the device directory,
+// keyed by "<device>/<subdev>".  Scanning reads the name of every
+// subdevice, so it is done once and repeated only if an entry under
+// the cached directory can no longer be opened.
+static std::mutex subdir_mutex;
+static std::map<std::string, std::string> subdir_cache;
+
+static int
+find_subdev_dir(const std::string& name, const std::string& subdev, std::string& subdir)
+{
+  if (subdev.empty()) {
+    subdir = "";
+    return 0;
+  }
+
+  auto key = name + "/" + subdev;
+  std::lock_guard<std::mutex> lk(subdir_mutex);
+  auto itr = subdir_cache.find(key);
+  if (itr != subdir_cache.end()) {
+    subdir = itr->second;
+    return 0;
+  }
+
+  auto ret = get_subdev_dir_name(dev_root() + name, subdev, subdir);
+  if (ret == 0)
+    subdir_cache.emplace(key, subdir);
+  return ret;
+}
+
+// Drop a cached subdevice directory, returns true if one was cached
+static bool
+forget_subdev_dir(const std::string& name, const std::string& subdev)
+{
+  if (subdev.empty())
+    return false;
+  std::lock_guard<std::mutex> lk(subdir_mutex);
+  return subdir_cache.erase(name + "/" + subdev) > 0;
+}
 
 static std::string
 get_path(const std::string& name, const std::string& subdev, const std::string& entry)
 {
   std::string subdir;
-  if (get_subdev_dir_name(dev_root + name, subdev, subdir) != 0)
+
+  // A path without entry probes for the subdevice, don't trust the cache
+  int ret = entry.empty()
+    ? get_subdev_dir_name(dev_root() + name, subdev, subdir)
+    : find_subdev_dir(name, subdev, subdir);
+  if (ret != 0)
     return "";
 
-  auto path = dev_root;
+  auto path = dev_root();
   path += name;
   path += "/";
   path += subdir;
@@ -225,10 +292,19 @@ open(const std::string& name,
   if (path.empty()) {
     std::stringstream ss;
     ss << "Failed to find subdirectory for " << subdev
-       << " under " << dev_root + name << std::endl;
+       << " under " << dev_root() + name << std::endl;
     err = ss.str();
-  } else {
-    fs = open_path(path, err, write, binary);
+    return fs;
+  }
+
+  fs = open_path(path, err, write, binary);
+
+  // Subdevices are recreated on reset and xclbin download, retry
+  // once with a fresh lookup of the subdevice directory
+  if (!fs.is_open() && forget_subdev_dir(name, subdev)) {
+    path = get_path(name, subdev, entry);
+    if (!path.empty())
+      fs = open_path(path, err, write, binary);
   }
 
   return fs;
@@ -249,22 +325,17 @@ get(const std::string& name,
     sv.push_back(line);
 }
 
+// Convert lines read from sysfs to integers, the path is only
+// needed for the error message
+template <typename PathFunc>
 static void
-get(const std::string& name,
-    const std::string& subdev, const std::string& entry,
-    std::string& err, std::vector<uint64_t>& iv)
+to_uint64(const std::vector<std::string>& sv, PathFunc path,
+          std::string& err, std::vector<uint64_t>& iv)
 {
-  iv.clear();
-
-  std::vector<std::string> sv;
-  get(name, subdev, entry, err, sv);
-  if (!err.empty())
-    return;
-
   for (auto& s : sv) {
     if (s.empty()) {
       std::stringstream ss;
-      ss << "Reading " << get_path(name, subdev, entry) << ", ";
+      ss << "Reading " << path() << ", ";
       ss << "can't convert empty string to integer" << std::endl;
       err = ss.str();
       break;
@@ -273,7 +344,7 @@ get(const std::string& name,
     auto n = std::strtoull(s.c_str(), &end, 0);
     if (*end != '\0') {
       std::stringstream ss;
-      ss << "Reading " << get_path(name, subdev, entry) << ", ";
+      ss << "Reading " << path() << ", ";
       ss << "failed to convert string to integer: " << s << std::endl;
       err = ss.str();
       break;
@@ -282,6 +353,21 @@ get(const std::string& name,
   }
 }
 
+static void
+get(const std::string& name,
+    const std::string& subdev, const std::string& entry,
+    std::string& err, std::vector<uint64_t>& iv)
+{
+  iv.clear();
+
+  std::vector<std::string> sv;
+  get(name, subdev, entry, err, sv);
+  if (!err.empty())
+    return;
+
+  to_uint64(sv, [&] { return get_path(name, subdev, entry); }, err, iv);
+}
+
 static void
 get(const std::string& name,
     const std::string& subdev, const std::string& entry,
@@ -364,6 +450,197 @@ put(const std::string& name,
   }
 }
 
+using clock = std::chrono::steady_clock;
+
+// Cached sysfs entries that are not read for this many ttl periods
+// are no longer refreshed by the sampler
+constexpr int idle_periods = 8;
+
+// One cached sysfs entry, see pci_device::sysfs_get_cached
+struct sample
+{
+  std::mutex mutex;
+  std::string path;
+  int fd = -1;
+  std::chrono::milliseconds ttl{0};
+  std::vector<std::string> value;
+  std::string err;
+  clock::time_point updated;  // when value was read, epoch if not valid
+  clock::time_point accessed; // last cached read
+
+  ~sample()
+  {
+    if (fd != -1)
+      ::close(fd);
+  }
+
+  bool
+  is_idle(clock::time_point now) const
+  {
+    return now - accessed > idle_periods * ttl;
+  }
+
+  // Read the entry through the persistent file descriptor.  A sysfs
+  // attribute is regenerated when read from offset 0, so there is no
+  // need to reopen it.  Must be called with mutex held.
+  void
+  refresh()
+  {
+    value.clear();
+    err.clear();
+    updated = clock::time_point();
+
+    if (fd == -1)
+      fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      err = "Failed to open " + path + " for reading: " + strerror(errno) + "\n";
+      return;
+    }
+
+    char buf[4096];
+    std::string data;
+    off_t offset = 0;
+    while (true) {
+      auto n = ::pread(fd, buf, sizeof(buf), offset);
+      if (n < 0) {
+        err = "Failed to read " + path + ": " + strerror(errno) + "\n";
+        ::close(fd);
+        fd = -1;
+        return;
+      }
+      if (n == 0)
+        break;
+      data.append(buf, n);
+      offset += n;
+    }
+
+    // Same lines as std::getline would produce
+    size_t pos = 0;
+    while (pos < data.size()) {
+      auto eol = data.find('\n', pos);
+      if (eol == std::string::npos)
+        eol = data.size();
+      value.emplace_back(data, pos, eol - pos);
+      pos = eol + 1;
+    }
+    updated = clock::now();
+  }
+};
+
+// Cached entries of one device
+struct sample_set
+{
+  std::mutex mutex;
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<sample>> samples;
+
+  std::shared_ptr<sample>
+  get(const std::string& subdev, const std::string& entry, bool& created)
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    auto& s = samples[std::make_pair(subdev, entry)];
+    created = (s == nullptr);
+    if (created)
+      s = std::make_shared<sample>();
+    return s;
+  }
+};
+
+// Background thread that refreshes cached entries of all devices
+// before they expire, so that polling readers never wait for sysfs.
+// An entry is refreshed when a quarter of its ttl is left; entries
+// with the same ttl are read in the same pass.  Entries that could
+// not be read or that are idle are left to the readers.
+class sampler
+{
+  std::mutex mutex;
+  std::condition_variable work;
+  std::vector<std::weak_ptr<sample>> samples;
+  std::thread thread;
+  bool stop = false;
+
+  void
+  run()
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    while (!stop) {
+      auto now = clock::now();
+      auto next = clock::time_point::max();
+      std::vector<std::shared_ptr<sample>> due;
+
+      for (auto itr = samples.begin(); itr != samples.end(); ) {
+        auto s = itr->lock();
+        if (!s) {
+          itr = samples.erase(itr);
+          continue;
+        }
+        ++itr;
+
+        std::lock_guard<std::mutex> slk(s->mutex);
+        if (s->fd == -1 || s->updated == clock::time_point() || s->is_idle(now))
+          continue;
+        auto refresh_at = s->updated + s->ttl - s->ttl / 4;
+        if (refresh_at <= now)
+          due.push_back(std::move(s));
+        else
+          next = std::min(next, refresh_at);
+      }
+
+      if (!due.empty()) {
+        lk.unlock();
+        for (auto& s : due) {
+          std::lock_guard<std::mutex> slk(s->mutex);
+          s->refresh();
+        }
+        due.clear();
+        lk.lock();
+        continue;
+      }
+
+      if (next == clock::time_point::max())
+        work.wait(lk);
+      else
+        work.wait_until(lk, next);
+    }
+  }
+
+public:
+  ~sampler()
+  {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      stop = true;
+    }
+    work.notify_one();
+    if (thread.joinable())
+      thread.join();
+  }
+
+  void
+  add(const std::shared_ptr<sample>& s)
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    samples.push_back(s);
+    if (!thread.joinable())
+      thread = std::thread([this] { run(); });
+    work.notify_one();
+  }
+
+  // An entry was read after being idle or failing
+  void
+  wake()
+  {
+    std::lock_guard<std::mutex> lk(mutex);
+    work.notify_one();
+  }
+};
+
+static sampler&
+get_sampler()
+{
+  static sampler s;
+  return s;
+}
+
 } // sysfs
 
 static bool is_in_use(std::vector<std::shared_ptr<pci_device>>& vec)
@@ -416,6 +693,89 @@ sysfs_get(const std::string& subdev, const std::string& entry,
   sysfs::get(sysfs_name, subdev, entry, err, s);
 }
 
+void
+pci_device::
+sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                 std::chrono::milliseconds ttl,
+                 std::string& err, std::vector<std::string>& sv)
+{
+  if (ttl.count() == 0) {
+    sysfs_get(subdev, entry, err, sv);
+    return;
+  }
+
+  bool created = false;
+  auto s = samples->get(subdev, entry, created);
+  bool wake = false;
+  bool valid = false;
+  {
+    std::lock_guard<std::mutex> lk(s->mutex);
+    auto now = sysfs::clock::now();
+    wake = s->is_idle(now) || s->fd == -1;
+    s->ttl = ttl;
+    s->accessed = now;
+
+    if (now - s->updated < ttl) {
+      err.clear();
+      sv = s->value;
+      return;
+    }
+
+    if (s->path.empty())
+      s->path = get_sysfs_path(subdev, entry);
+    if (!s->path.empty()) {
+      s->refresh();
+      valid = s->err.empty();
+      if (valid) {
+        err.clear();
+        sv = s->value;
+      }
+      else {
+        // Look up the entry again on next read
+        s->path.clear();
+      }
+    }
+  }
+
+  if (created)
+    sysfs::get_sampler().add(s);
+  else if (wake)
+    sysfs::get_sampler().wake();
+
+  // Uncached read reports the error
+  if (!valid)
+    sysfs_get(subdev, entry, err, sv);
+}
+
+void
+pci_device::
+sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                 std::chrono::milliseconds ttl,
+                 std::string& err, std::vector<uint64_t>& iv)
+{
+  iv.clear();
+
+  std::vector<std::string> sv;
+  sysfs_get_cached(subdev, entry, ttl, err, sv);
+  if (!err.empty())
+    return;
+
+  sysfs::to_uint64(sv, [&] { return get_sysfs_path(subdev, entry); }, err, iv);
+}
+
+void
+pci_device::
+sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                 std::chrono::milliseconds ttl,
+                 std::string& err, std::string& s)
+{
+  std::vector<std::string> sv;
+  sysfs_get_cached(subdev, entry, ttl, err, sv);
+  if (!sv.empty())
+    s = sv[0];
+  else
+    s = ""; // default value
+}
 
 void
 pci_device::
@@ -494,7 +854,8 @@ open(const std::string& subdev, int flag)
 }
 
 pci_device::
-pci_device(const std::string& drv_name, const std::string& sysfs) : sysfs_name(sysfs)
+pci_device(const std::string& drv_name, const std::string& sysfs)
+  : sysfs_name(sysfs), samples(std::make_shared<sysfs::sample_set>())
 {
   uint16_t dom, b, d, f;
   if(sscanf(sysfs.c_str(), "%hx:%hx:%hx.%hx", &dom, &b, &d, &f) < 4)
@@ -520,10 +881,10 @@ pci_device(const std::string& drv_name, const std::string& sysfs) : sysfs_name(s
   if (is_mgmt())
     sysfs_get("", "instance", err, instance, static_cast<uint32_t>(INVALID_ID));
   else
-    instance = get_render_value(sysfs::dev_root + sysfs + "/drm");
+    instance = get_render_value(sysfs::dev_root() + sysfs + "/drm");
 
   sysfs_get<int>("", "userbar", err, user_bar, 0);
-  user_bar_size = bar_size(sysfs::dev_root + sysfs, user_bar);
+  user_bar_size = bar_size(sysfs::dev_root() + sysfs, user_bar);
   sysfs_get<bool>("", "ready", err, is_ready, false);
 }
 
@@ -982,7 +1343,7 @@ public:
 private:
   void rescan_nolock(const std::string driver)
   {
-    const std::string drvpath = sysfs::drv_root + driver;
+    const std::string drvpath = sysfs::drv_root() + driver;
     if(!bfs::exists(drvpath))
       return;
 
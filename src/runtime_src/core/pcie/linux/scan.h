@@ -17,6 +17,7 @@
 #ifndef _XCL_SCAN_H_
 #define _XCL_SCAN_H_
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
@@ -66,6 +67,10 @@ struct fdt_header {
 
 namespace pcidev {
 
+namespace sysfs {
+struct sample_set;
+}
+
 // One PCIE function on FPGA board
 class pci_device
 {
@@ -127,6 +132,38 @@ public:
     sysfs_get<uint32_t>(subdev, entry, err, i, 0);
   }
 
+  // Cached read of a frequently polled entry such as a sensor.  A
+  // value younger than ttl is returned without accessing sysfs.
+  // The entry is kept open and, while it is being polled, refreshed
+  // ahead of expiry by a background sampler thread that reads all
+  // cached entries of all devices in one pass.  A ttl of zero reads
+  // sysfs directly.
+  void
+  sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                   std::chrono::milliseconds ttl,
+                   std::string& err, std::vector<std::string>& sv);
+  void
+  sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                   std::chrono::milliseconds ttl,
+                   std::string& err, std::vector<uint64_t>& iv);
+  void
+  sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                   std::chrono::milliseconds ttl,
+                   std::string& err, std::string& s);
+  template <typename T>
+  void
+  sysfs_get_cached(const std::string& subdev, const std::string& entry,
+                   std::chrono::milliseconds ttl,
+                   std::string& err, T& i, const T& default_val)
+  {
+    std::vector<uint64_t> iv;
+    sysfs_get_cached(subdev, entry, ttl, err, iv);
+    if (!iv.empty())
+      i = static_cast<T>(iv[0]);
+    else
+      i = static_cast<T>(default_val); // default value
+  }
+
   virtual void
   sysfs_put(const std::string& subdev, const std::string& entry,
             std::string& err, const std::string& input);
@@ -162,6 +199,7 @@ private:
   std::mutex lock;
   char *user_bar_map = reinterpret_cast<char *>(MAP_FAILED);
   bool mgmt = false;
+  std::shared_ptr<sysfs::sample_set> samples;
 };
 
 void rescan(void);
@@ -31,4 +31,18 @@ device(handle_type device_handle, id_type device_id, bool user)
 {
 }
 
+size_t
+device::
+exec_wait_completed(int timeout_ms, std::vector<xclBufferHandle>& completed) const
+{
+  return userpf::exec_wait_completed(get_device_handle(), timeout_ms, completed);
+}
+
+void
+device::
+exec_buf_list(const std::vector<xclBufferHandle>& cmds)
+{
+  userpf::exec_buf_list(get_device_handle(), cmds);
+}
+
 }} // noop,xrt_core
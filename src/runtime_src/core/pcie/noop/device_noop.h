@@ -30,6 +30,22 @@ class device : public shim<device_pcie>
 public:
   device(handle_type device_handle, id_type device_id, bool user);
 
+  ////////////////////////////////////////////////////////////////
+  // Command completion reporting
+  // Redefined from xrt_core::ishim
+  ////////////////////////////////////////////////////////////////
+  virtual size_t
+  exec_wait_completed(int timeout_ms, std::vector<xclBufferHandle>& completed) const;
+  ////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////
+  // Batched command submission
+  // Redefined from xrt_core::ishim
+  ////////////////////////////////////////////////////////////////
+  virtual void
+  exec_buf_list(const std::vector<xclBufferHandle>& cmds);
+  ////////////////////////////////////////////////////////////////
+
 private:
   // Private look up function for concrete query::request
   virtual const query::request&
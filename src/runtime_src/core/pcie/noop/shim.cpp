@@ -24,10 +24,14 @@
 #include "core/common/task.h"
 #include "core/common/thread.h"
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <map>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace { // private implementation details
 
@@ -120,6 +124,13 @@ static xrt_core::task::queue running_queue;
 static std::thread completer;
 static std::atomic<uint64_t> completion_count {0};
 
+// Handles of completed commands are recorded only after first
+// request for completion reporting, otherwise the list would grow
+// unbounded for clients that use plain exec_wait
+static std::atomic<bool> report_handles {false};
+static std::mutex completed_mutex;
+static std::vector<xclBufferHandle> completed_handles;
+
 struct cmd_type
 {
   xclBufferHandle handle;
@@ -145,11 +156,40 @@ stop()
   }
 }
 
+// Consume at most max completions atomically, concurrent waiters
+// must neither consume the same completion nor drive the count
+// below zero.  Returns the number of completions consumed.
+static uint64_t
+consume(uint64_t max)
+{
+  auto count = completion_count.load();
+  while (count && !completion_count.compare_exchange_weak(count, count - std::min(count, max))) ;
+  return std::min(count, max);
+}
+
 static void
 wait()
 {
-  while (!completion_count) ;
-  --completion_count;
+  while (!consume(1)) ;
+}
+
+// Wait for completion and move all completed command handles to
+// argument vector.  Returns 0 if nothing completed within timeout.
+static size_t
+wait(int timeout_ms, std::vector<xclBufferHandle>& handles)
+{
+  report_handles = true;
+  auto deadline = xrt_core::time_ns() + static_cast<unsigned long>(timeout_ms) * 1000000;
+  while (!completion_count)
+    if (xrt_core::time_ns() > deadline)
+      return 0;
+
+  std::lock_guard<std::mutex> lk(completed_mutex);
+  auto count = completed_handles.size();
+  consume(count);
+  handles.insert(handles.end(), completed_handles.begin(), completed_handles.end());
+  completed_handles.clear();
+  return count;
 }
 
 static void
@@ -159,6 +199,14 @@ mark_cmd_handle_complete(xclBufferHandle handle)
   auto hbuf = buffer::map(handle);
   auto cmd = reinterpret_cast<ert_packet*>(hbuf);
   cmd->state = ERT_CMD_STATE_COMPLETED;
+
+  if (!report_handles) {
+    ++completion_count;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lk(completed_mutex);
+  completed_handles.push_back(handle);
   ++completion_count;
 }
 
@@ -188,7 +236,49 @@ static X x;
 
 } // cmd
 
-  
+// Simulate CU control registers for the software command scheduler.
+//
+// A CU that is started with AP_START completes immediately, the next
+// read of its control register returns AP_DONE | AP_IDLE.  Other
+// registers read back what was last written.
+namespace cu {
+
+const uint32_t AP_START = 0x1;
+const uint32_t AP_DONE  = 0x2;
+const uint32_t AP_IDLE  = 0x4;
+
+// Register values per device index
+static std::mutex regs_mutex;
+static std::map<unsigned int, std::map<uint64_t, uint32_t>> device_regs;
+
+static void
+write(unsigned int devidx, uint64_t offset, const void* hbuf, size_t size)
+{
+  std::lock_guard<std::mutex> lk(regs_mutex);
+  auto& regs = device_regs[devidx];
+  auto words = reinterpret_cast<const uint32_t*>(hbuf);
+  for (size_t idx = 0; idx < size / sizeof(uint32_t); ++idx)
+    regs[offset + idx * sizeof(uint32_t)] = words[idx];
+}
+
+static void
+read(unsigned int devidx, uint64_t offset, void* hbuf, size_t size)
+{
+  std::lock_guard<std::mutex> lk(regs_mutex);
+  auto& regs = device_regs[devidx];
+  auto words = reinterpret_cast<uint32_t*>(hbuf);
+  for (size_t idx = 0; idx < size / sizeof(uint32_t); ++idx) {
+    auto& reg = regs[offset + idx * sizeof(uint32_t)];
+    if (idx == 0 && (reg & AP_START))
+      reg = AP_DONE | AP_IDLE;
+    words[idx] = reg;
+    if (idx == 0 && (reg & AP_DONE))
+      reg = AP_IDLE;
+  }
+}
+
+} // cu
+
 struct shim
 {
   using buffer_handle_type = xclBufferHandle; // xrt.h
@@ -267,6 +357,19 @@ struct shim
     return 1;
   }
 
+  void
+  exec_buf_list(const std::vector<buffer_handle_type>& handles)
+  {
+    for (auto handle : handles)
+      cmd::add(handle);
+  }
+
+  size_t
+  exec_wait_completed(int msec, std::vector<buffer_handle_type>& completed)
+  {
+    return cmd::wait(msec, completed);
+  }
+
   int
   get_bo_properties(buffer_handle_type handle, struct xclBOProperties* properties)
   {
@@ -286,15 +389,17 @@ struct shim
   }
 
   int
-  write(enum xclAddressSpace, uint64_t, const void*, size_t)
+  write(enum xclAddressSpace, uint64_t offset, const void* hbuf, size_t size)
   {
-    throw std::runtime_error("not implemented");
+    cu::write(m_devidx, offset, hbuf, size);
+    return 0;
   }
 
   int
-  read(enum xclAddressSpace, uint64_t, void*, size_t)
+  read(enum xclAddressSpace, uint64_t offset, void* hbuf, size_t size)
   {
-    throw std::runtime_error("not implemented");
+    cu::read(m_devidx, offset, hbuf, size);
+    return 0;
   }
 
   ssize_t
@@ -491,6 +596,26 @@ xclExecWait(xclDeviceHandle handle, int timeoutMilliSec)
   return shim->exec_wait(timeoutMilliSec);
 }
 
+namespace userpf {
+
+size_t
+exec_wait_completed(xclDeviceHandle handle, int timeout_ms, std::vector<xclBufferHandle>& completed)
+{
+  auto shim = get_shim_object(handle);
+  return shim->exec_wait_completed(timeout_ms, completed);
+}
+
+void
+exec_buf_list(xclDeviceHandle handle, const std::vector<xclBufferHandle>& cmds)
+{
+  xrt_core::message::
+    send(xrt_core::message::severity_level::debug, "XRT", "exec_buf_list()");
+  auto shim = get_shim_object(handle);
+  shim->exec_buf_list(cmds);
+}
+
+} // userpf
+
 xclBufferExportHandle
 xclExportBO(xclDeviceHandle handle, xclBufferHandle boHandle)
 {
@@ -20,8 +20,20 @@
 #include "core/pcie/noop/config.h"
 #include "xrt.h"
 
+#include <vector>
+
 namespace userpf {
 
+// exec_wait_completed() - Wait for command completion
+//
+// Appends the exec buffer handles of all commands that have completed
+// since last call.  Returns number of handles appended.
+size_t
+exec_wait_completed(xclDeviceHandle handle, int timeout_ms, std::vector<xclBufferHandle>& completed);
+
+// exec_buf_list() - Submit a list of exec buffers for execution
+void
+exec_buf_list(xclDeviceHandle handle, const std::vector<xclBufferHandle>& cmds);
 
 } // userpf
 
@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <sstream>
 
@@ -59,13 +60,32 @@ Section::~Section() {
 void
 Section::purgeBuffers()
 {
-  if (m_pBuffer != nullptr) {
-    delete m_pBuffer;
-    m_pBuffer = nullptr;
-  }
+  if (m_pImage != nullptr) 
+    m_pImage.reset();
+  else
+    delete[] m_pBuffer;
+
+  m_pBuffer = nullptr;
   m_bufferSize = 0;
 }
 
+void
+Section::detachFromFile(const std::string& _sFileName)
+{
+  if ((m_pImage == nullptr) || m_pImage->getFileName().empty()) 
+    return;
+
+  boost::system::error_code ec;
+  if (!boost::filesystem::equivalent(m_pImage->getFileName(), _sFileName, ec)) 
+    return;
+
+  // The file is about to be overwritten, take a copy of the buffer
+  char* pBuffer = new char[m_bufferSize];
+  memcpy(pBuffer, m_pBuffer, m_bufferSize);
+  m_pImage.reset();
+  m_pBuffer = pBuffer;
+}
+
 void
 Section::setName(const std::string &_sSectionName)
 {
@@ -258,7 +278,41 @@ Section::writeXclBinSectionBuffer(std::ostream& _ostream) const
 }
 
 void
-Section::readXclBinBinary(std::fstream& _istream, const axlf_section_header& _sectionHeader) {
+Section::writeXclBinSectionBuffer(XUtil::OutputFile& _ofile) const
+{
+  if ((m_pBuffer == nullptr) ||
+      (m_bufferSize == 0)) {
+    return;
+  }
+
+  // Buffers served from a mapped file are copied file to file
+  if ((m_pImage != nullptr) && m_pImage->isMapped()) 
+    _ofile.copyFromImage(*m_pImage, m_pBuffer, m_bufferSize);
+  else
+    _ofile.write(m_pBuffer, m_bufferSize);
+}
+
+void
+Section::setBufferFromImage(const std::shared_ptr<XUtil::FileImage>& _image, uint64_t _offset, uint64_t _size)
+{
+  if ((_offset > _image->size()) || (_size > _image->size() - _offset)) {
+    std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
+    throw std::runtime_error(errMsg);
+  }
+
+  if (_size > UINT32_MAX) {
+    std::string errMsg ("FATAL ERROR: Section size exceeds internal representation size.");
+    throw std::runtime_error(errMsg);
+  }
+
+  // The buffer is served from the image, no copy is made
+  m_pImage = _image;
+  m_pBuffer = _image->data() + _offset;
+  m_bufferSize = (unsigned int) _size;
+}
+
+void
+Section::readXclBinBinary(const std::shared_ptr<XUtil::FileImage>& _image, const axlf_section_header& _sectionHeader) {
   // Some error checking
   if ((enum axlf_section_kind)_sectionHeader.m_sectionKind != getSectionKind()) {
     std::string errMsg = XUtil::format("ERROR: Unexpected section kind.  Expected: %d, Read: %d", getSectionKind(), _sectionHeader.m_sectionKind);
@@ -272,29 +326,23 @@ Section::readXclBinBinary(std::fstream& _istream, const axlf_section_header& _se
 
   m_name = (char*)&_sectionHeader.m_sectionName;
 
-  if (_sectionHeader.m_sectionSize > UINT64_MAX) {
-    std::string errMsg ("FATAL ERROR: Section header size exceeds internal representation size.");
-    throw std::runtime_error(errMsg);
-  }
-
-  m_bufferSize = (unsigned int) _sectionHeader.m_sectionSize;
-
-  m_pBuffer = new char[m_bufferSize];
-
-  _istream.seekg(_sectionHeader.m_sectionOffset);
-
-  _istream.read(m_pBuffer, m_bufferSize);
-
-  if (_istream.gcount() != (std::streamsize) m_bufferSize) {
-    std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
-    throw std::runtime_error(errMsg);
-  }
+  setBufferFromImage(_image, _sectionHeader.m_sectionOffset, _sectionHeader.m_sectionSize);
 
   XUtil::TRACE(XUtil::format("Section: %s (%d)", getSectionKindAsString().c_str(), (unsigned int)getSectionKind()));
   XUtil::TRACE(XUtil::format("  m_name: %s", m_name.c_str()));
   XUtil::TRACE(XUtil::format("  m_size: %ld", m_bufferSize));
 }
 
+void
+Section::readXclBinBinary(std::fstream& _istream, const axlf_section_header& _sectionHeader) {
+  // Bring the section into memory, the image then holds only this section
+  auto image = XUtil::FileImage::readStream(_istream, _sectionHeader.m_sectionOffset, _sectionHeader.m_sectionSize);
+
+  axlf_section_header sectionHeader = _sectionHeader;
+  sectionHeader.m_sectionOffset = 0;
+  readXclBinBinary(image, sectionHeader);
+}
+
 
 void 
 Section::readJSONSectionImage(const boost::property_tree::ptree& _ptSection)
@@ -316,7 +364,7 @@ Section::readJSONSectionImage(const boost::property_tree::ptree& _ptSection)
 }
 
 void
-Section::readXclBinBinary(std::fstream& _istream,
+Section::readXclBinBinary(const std::shared_ptr<XUtil::FileImage>& _image,
                           const boost::property_tree::ptree& _ptSection) {
   // Some error checking
   enum axlf_section_kind eKind = (enum axlf_section_kind)_ptSection.get<unsigned int>("Kind");
@@ -348,18 +396,8 @@ Section::readXclBinBinary(std::fstream& _istream,
       throw std::runtime_error(errMsg);
     }
 
-    m_bufferSize = (unsigned int) imageSize;
-    m_pBuffer = new char[m_bufferSize];
-
     uint64_t offset = XUtil::stringToUInt64(_ptSection.get<std::string>("Offset"));
-
-    _istream.seekg(offset);
-    _istream.read(m_pBuffer, m_bufferSize);
-
-    if (_istream.gcount() != (std::streamsize) m_bufferSize) {
-      std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
-      throw std::runtime_error(errMsg);
-    }
+    setBufferFromImage(_image, offset, imageSize);
   }
 
   XUtil::TRACE(XUtil::format("Adding Section: %s (%d)", getSectionKindAsString().c_str(), (unsigned int)getSectionKind()));
@@ -421,6 +459,16 @@ Section::readPayload(std::fstream& _istream, enum FormatType _eFormatType)
         axlf_section_header sectionHeader = axlf_section_header {0};
         sectionHeader.m_sectionKind = getSectionKind();
         sectionHeader.m_sectionOffset = 0;
+
+        // Map regular files, large payloads are then never copied into memory
+        boost::system::error_code ec;
+        if (!m_pathAndName.empty() && boost::filesystem::is_regular_file(m_pathAndName, ec)) {
+          auto image = XUtil::FileImage::mapFile(m_pathAndName);
+          sectionHeader.m_sectionSize = image->size();
+          readXclBinBinary(image, sectionHeader);
+          break;
+        }
+
         _istream.seekg(0, _istream.end);
 
         static_assert(sizeof(std::streamsize) <= sizeof(uint64_t), "std::streamsize precision is greater then 64 bits");
@@ -503,21 +551,18 @@ Section::readXclBinBinary(std::fstream& _istream, enum FormatType _eFormatType)
       _istream.seekg(0, _istream.end);
       std::streamsize fileSize = _istream.tellg();
 
-      std::unique_ptr<unsigned char> memBuffer(new unsigned char[fileSize]);
-      _istream.clear();
-      _istream.seekg(0);
-      _istream.read((char*)memBuffer.get(), fileSize);
+      auto image = XUtil::FileImage::readStream(_istream, 0, fileSize);
 
-      XUtil::TRACE_BUF("Buffer", (char*)memBuffer.get(), fileSize);
+      XUtil::TRACE_BUF("Buffer", image->data(), fileSize);
 
       // Convert the JSON file to a boost property tree
       std::stringstream ss;
-      ss.write((char*) memBuffer.get(), fileSize);
+      ss.write(image->data(), fileSize);
 
       boost::property_tree::ptree pt;
       boost::property_tree::read_json(ss, pt);
 
-      readXclBinBinary(_istream, pt);
+      readXclBinBinary(image, pt);
       break;
     }
   case FT_HTML:
@@ -666,11 +711,7 @@ Section::readSubPayload(std::fstream& _istream,
   readSubPayload(m_pBuffer, m_bufferSize, _istream, _sSubSection, _eFormatType, buffer);
 
   // Now for some how cleaning
-  if (m_pBuffer != nullptr) {
-    delete m_pBuffer;
-    m_pBuffer = nullptr;
-    m_bufferSize = 0;
-  }
+  purgeBuffers();
 
   m_bufferSize = (unsigned int) buffer.tellp();
 
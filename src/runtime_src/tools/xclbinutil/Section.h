@@ -26,12 +26,14 @@
 #include <fstream>
 #include <map>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include <boost/property_tree/ptree.hpp>
 
 // ------------ F O R W A R D - D E C L A R A T I O N S ----------------------
 // Forward declarations - use these instead whenever possible...
+namespace XclBinUtilities { class FileImage; class OutputFile; }
 
 // ------------------- C L A S S :   S e c t i o n ---------------------------
 
@@ -74,8 +76,9 @@ class Section {
 
  public:
   // Xclbin Binary helper methods - child classes can override them if they choose
-  virtual void readXclBinBinary(std::fstream& _istream, const struct axlf_section_header& _sectionHeader);
-  virtual void readXclBinBinary(std::fstream& _istream, const boost::property_tree::ptree& _ptSection);
+  virtual void readXclBinBinary(const std::shared_ptr<XclBinUtilities::FileImage>& _image, const struct axlf_section_header& _sectionHeader);
+  virtual void readXclBinBinary(const std::shared_ptr<XclBinUtilities::FileImage>& _image, const boost::property_tree::ptree& _ptSection);
+  void readXclBinBinary(std::fstream& _istream, const struct axlf_section_header& _sectionHeader);
   void readXclBinBinary(std::fstream& _istream, enum FormatType _eFormatType);
   void readJSONSectionImage(const boost::property_tree::ptree& _ptSection);
   void readPayload(std::fstream& _istream, enum FormatType _eFormatType);
@@ -84,6 +87,7 @@ class Section {
   void readSubPayload(std::fstream& _istream, const std::string & _sSubSection, enum Section::FormatType _eFormatType);
   virtual void initXclBinSectionHeader(axlf_section_header& _sectionHeader);
   virtual void writeXclBinSectionBuffer(std::ostream& _ostream) const;
+  void writeXclBinSectionBuffer(XclBinUtilities::OutputFile& _ofile) const;
   virtual void appendToSectionMetadata(const boost::property_tree::ptree& _ptAppendData, boost::property_tree::ptree& _ptToAppendTo);
 
   void dumpContents(std::ostream& _ostream, enum FormatType _eFormatType) const;
@@ -91,6 +95,7 @@ class Section {
 
   void getPayload(boost::property_tree::ptree& _pt) const;
   void purgeBuffers();
+  void detachFromFile(const std::string& _sFileName);
   void setName(const std::string &_sSectionName);
   void setPathAndName(const std::string& _pathAndName);
   const std::string &getPathAndName() const;
@@ -103,6 +108,9 @@ class Section {
   virtual void readSubPayload(const char *_pOrigDataSection, unsigned int _origSectionSize,  std::fstream &_istream, const std::string &_sSubSection, enum Section::FormatType _eFormatType, std::ostringstream &_buffer) const;
   virtual void writeSubPayload(const std::string & _sSubSectionName, FormatType _eFormatType, std::fstream&  _oStream) const;
 
+ private:
+  void setBufferFromImage(const std::shared_ptr<XclBinUtilities::FileImage>& _image, uint64_t _offset, uint64_t _size);
+
  protected:
   Section();
 
@@ -119,6 +127,9 @@ class Section {
   unsigned int m_bufferSize;
   std::string m_name;
 
+  // Image the buffer points into, if it was read from an xclbin file
+  std::shared_ptr<XclBinUtilities::FileImage> m_pImage;
+
   std::string m_pathAndName;
 
  private:
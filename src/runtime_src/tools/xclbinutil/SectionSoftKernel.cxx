@@ -486,8 +486,8 @@ SectionSoftKernel::writeSubPayload(const std::string& _sSubSectionName,
 }
 
 void
-SectionSoftKernel::readXclBinBinary(std::fstream& _istream, const axlf_section_header& _sectionHeader) {
-  Section::readXclBinBinary(_istream, _sectionHeader);
+SectionSoftKernel::readXclBinBinary(const std::shared_ptr<XUtil::FileImage>& _image, const axlf_section_header& _sectionHeader) {
+  Section::readXclBinBinary(_image, _sectionHeader);
 
   // Extract the binary data as a JSON string
   std::ostringstream buffer;
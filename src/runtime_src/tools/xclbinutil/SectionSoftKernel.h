@@ -44,7 +44,7 @@ public:
   virtual bool doesSupportAddFormatType(FormatType _eFormatType) const;
   virtual bool supportsSubSection(const std::string &_sSubSectionName) const;
   virtual bool subSectionExists(const std::string &_sSubSectionName) const;
-  virtual void readXclBinBinary(std::fstream& _istream, const struct axlf_section_header& _sectionHeader);
+  virtual void readXclBinBinary(const std::shared_ptr<XclBinUtilities::FileImage>& _image, const struct axlf_section_header& _sectionHeader);
 
 
  protected:
@@ -25,8 +25,11 @@
 #include <boost/uuid/uuid.hpp>          // for uuid
 #include <boost/uuid/uuid_io.hpp>       // for to_string
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
 #include <random>
 #include <sstream>
+#include <thread>
 
 #include "XclBinUtilities.h"
 namespace XUtil = XclBinUtilities;
@@ -103,18 +106,15 @@ XclBin::printSections(std::ostream &_ostream) const {
 }
 
 void
-XclBin::readXclBinBinaryHeader(std::fstream& _istream) {
+XclBin::readXclBinBinaryHeader(const XUtil::FileImage& _image) {
   // Read in the buffer
-  const unsigned int expectBufferSize = sizeof(axlf);
-
-  _istream.seekg(0);
-  _istream.read((char*)&m_xclBinHeader, sizeof(axlf));
-
-  if (_istream.gcount() != expectBufferSize) {
+  if (_image.size() < sizeof(axlf)) {
     std::string errMsg = "ERROR: Input stream is smaller than the expected header size.";
     throw std::runtime_error(errMsg);
   }
 
+  memcpy(&m_xclBinHeader, _image.data(), sizeof(axlf));
+
   if (FormattedOutput::getMagicAsString(m_xclBinHeader).c_str() != std::string("xclbin2")) {
     std::string errMsg = "ERROR: The XCLBIN appears to be corrupted (header start key value is not what is expected).";
     throw std::runtime_error(errMsg);
@@ -122,32 +122,29 @@ XclBin::readXclBinBinaryHeader(std::fstream& _istream) {
 }
 
 void
-XclBin::readXclBinBinarySections(std::fstream& _istream) {
+XclBin::readXclBinBinarySections(const std::shared_ptr<XUtil::FileImage>& _image) {
   // Read in each section
   unsigned int numberOfSections = m_xclBinHeader.m_header.m_numSections;
 
   for (unsigned int index = 0; index < numberOfSections; ++index) {
     XUtil::TRACE(XUtil::format("Examining Section: %d of %d", index + 1, m_xclBinHeader.m_header.m_numSections));
     // Find the section header data
-    long long sectionOffset = sizeof(axlf) + (index * sizeof(axlf_section_header)) - sizeof(axlf_section_header);
-    _istream.seekg(sectionOffset);
+    uint64_t sectionOffset = sizeof(axlf) + (index * sizeof(axlf_section_header)) - sizeof(axlf_section_header);
 
     // Read in the section header
-    axlf_section_header sectionHeader = axlf_section_header {0};
-    const unsigned int expectBufferSize = sizeof(axlf_section_header);
-
-    _istream.read((char*)&sectionHeader, sizeof(axlf_section_header));
-
-    if (_istream.gcount() != expectBufferSize) {
+    if (sectionOffset + sizeof(axlf_section_header) > _image->size()) {
       std::string errMsg = "ERROR: Input stream is smaller than the expected section header size.";
       throw std::runtime_error(errMsg);
     }
 
+    axlf_section_header sectionHeader = axlf_section_header {0};
+    memcpy(&sectionHeader, _image->data() + sectionOffset, sizeof(axlf_section_header));
+
     Section* pSection = Section::createSectionObjectOfKind((enum axlf_section_kind)sectionHeader.m_sectionKind);
 
     // Here for testing purposes, when all segments are supported it should be removed
     if (pSection != nullptr) {
-      pSection->readXclBinBinary(_istream, sectionHeader);
+      pSection->readXclBinBinary(_image, sectionHeader);
       addSection(pSection);
     }
   }
@@ -162,30 +159,23 @@ XclBin::readXclBinBinary(const std::string &_binaryFileName,
     throw std::runtime_error(errMsg);
   }
 
-  // Open the file for consumption
+  // Map the file, the sections are served from the file image
   XUtil::TRACE("Reading xclbin binary file: " + _binaryFileName);
-  std::fstream ifXclBin;
-  ifXclBin.open(_binaryFileName, std::ifstream::in | std::ifstream::binary);
-  if (!ifXclBin.is_open()) {
-    std::string errMsg = "ERROR: Unable to open the file for reading: " + _binaryFileName;
-    throw std::runtime_error(errMsg);
-  }
+  auto image = XUtil::FileImage::mapFile(_binaryFileName);
 
   if (_bMigrate) {
     boost::property_tree::ptree pt_mirrorData;
-    findAndReadMirrorData(ifXclBin, pt_mirrorData);
+    findAndReadMirrorData(*image, pt_mirrorData);
 
     // Read in the mirror image
-    readXclBinaryMirrorImage(ifXclBin, pt_mirrorData);
+    readXclBinaryMirrorImage(image, pt_mirrorData);
   } else {
     // Read in the header
-    readXclBinBinaryHeader(ifXclBin);
+    readXclBinBinaryHeader(*image);
 
     // Read the sections
-    readXclBinBinarySections(ifXclBin);
+    readXclBinBinarySections(image);
   }
-
-  ifXclBin.close();
 }
 
 void
@@ -215,32 +205,17 @@ XclBin::addHeaderMirrorData(boost::property_tree::ptree& _pt_header) {
 
 
 void
-XclBin::writeXclBinBinaryHeader(std::ostream& _ostream, boost::property_tree::ptree& _mirroredData) {
+XclBin::writeXclBinBinaryHeader(XUtil::OutputFile& _ofile) {
   // Write the header (minus the section header array)
   XUtil::TRACE("Writing xclbin binary header");
-  _ostream.write((char*)&m_xclBinHeader, sizeof(axlf) - sizeof(axlf_section_header));
-  _ostream.flush();
-
-  // Get mirror data
-  boost::property_tree::ptree pt_header;
-  addHeaderMirrorData(pt_header);
-
-  _mirroredData.add_child("header", pt_header);
+  _ofile.write((char*)&m_xclBinHeader, sizeof(axlf) - sizeof(axlf_section_header));
 }
 
 
-void
-XclBin::writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::ptree& _mirroredData) {
-  // Nothing to write
-  if (m_sections.empty()) {
-    return;
-  }
-
-  // Prepare the array
-  struct axlf_section_header *sectionHeader = new struct axlf_section_header[m_sections.size()];
-  memset(sectionHeader, 0, sizeof(struct axlf_section_header) * m_sections.size());  // Zero out memory
-
+uint64_t
+XclBin::layoutXclBinBinarySections(std::vector<axlf_section_header>& _sectionHeaders) {
   // Populate the array size and offsets
+  _sectionHeaders.assign(m_sections.size(), axlf_section_header {0});
   uint64_t currentOffset = (uint64_t) (sizeof(axlf) - sizeof(axlf_section_header) + (sizeof(axlf_section_header) * m_sections.size()));
 
   for (unsigned int index = 0; index < m_sections.size(); ++index) {
@@ -248,71 +223,113 @@ XclBin::writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::
     currentOffset += (uint64_t) XUtil::bytesToAlign(currentOffset);
 
     // Initialize section header
-    m_sections[index]->initXclBinSectionHeader(sectionHeader[index]);
-    sectionHeader[index].m_sectionOffset = currentOffset;
-    currentOffset += (uint64_t) sectionHeader[index].m_sectionSize;
+    m_sections[index]->initXclBinSectionHeader(_sectionHeaders[index]);
+    _sectionHeaders[index].m_sectionOffset = currentOffset;
+    currentOffset += (uint64_t) _sectionHeaders[index].m_sectionSize;
+  }
+
+  return currentOffset;
+}
+
+
+void
+XclBin::addSectionMirrorData(const std::vector<axlf_section_header>& _sectionHeaders, 
+                             boost::property_tree::ptree& _mirroredData) const {
+  // Marshalling a section to JSON is independent of the other sections.  
+  // Spread the work over the available cores unless tracing, where the 
+  // output of the sections would interleave.
+  std::vector<boost::property_tree::ptree> payloads(m_sections.size());
+  std::vector<std::exception_ptr> errors(m_sections.size());
+  std::atomic<unsigned int> nextIndex(0);
+
+  auto worker = [&]() {
+    for (unsigned int index = nextIndex++; index < m_sections.size(); index = nextIndex++) {
+      try {
+        if (m_sections[index]->doesSupportAddFormatType(Section::FT_JSON) && 
+            m_sections[index]->doesSupportDumpFormatType(Section::FT_JSON)) {
+          m_sections[index]->getPayload(payloads[index]);
+        }
+      } catch (...) {
+        errors[index] = std::current_exception();
+      }
+    }
+  };
+
+  unsigned int workerCount = XUtil::getVerbose() ? 1 : std::thread::hardware_concurrency();
+  workerCount = std::max(1u, std::min(workerCount, (unsigned int) m_sections.size()));
+
+  std::vector<std::thread> workers;
+  for (unsigned int count = 1; count < workerCount; ++count) 
+    workers.emplace_back(worker);
+  worker();
+  for (auto & thread : workers) 
+    thread.join();
+
+  // Report the first failure in section order
+  for (auto & error : errors) {
+    if (error != nullptr) 
+      std::rethrow_exception(error);
+  }
+
+  for (unsigned int index = 0; index < m_sections.size(); ++index) {
+    XUtil::TRACE("");
+    XUtil::TRACE(XUtil::format("Adding mirror properties[%d]", index));
+
+    boost::property_tree::ptree pt_sectionHeader;
+
+    XUtil::TRACE(XUtil::format("Kind: %d, Name: %s, Offset: 0x%lx, Size: 0x%lx",
+                               _sectionHeaders[index].m_sectionKind,
+                               _sectionHeaders[index].m_sectionName,
+                               _sectionHeaders[index].m_sectionOffset,
+                               _sectionHeaders[index].m_sectionSize));
+
+    pt_sectionHeader.put("Kind", XUtil::format("%d", _sectionHeaders[index].m_sectionKind).c_str());
+    pt_sectionHeader.put("Name", XUtil::format("%s", _sectionHeaders[index].m_sectionName).c_str());
+    pt_sectionHeader.put("Offset", XUtil::format("0x%lx", _sectionHeaders[index].m_sectionOffset).c_str());
+    pt_sectionHeader.put("Size", XUtil::format("0x%lx", _sectionHeaders[index].m_sectionSize).c_str());
+
+    if (payloads[index].size() != 0) {
+      pt_sectionHeader.add_child("payload", payloads[index]);
+    }
+
+    _mirroredData.add_child("section_header", pt_sectionHeader);
+  }
+}
+
+
+void
+XclBin::writeXclBinBinarySections(XUtil::OutputFile& _ofile, 
+                                  const std::vector<axlf_section_header>& _sectionHeaders) const {
+  // Nothing to write
+  if (m_sections.empty()) {
+    return;
   }
 
   XUtil::TRACE("Writing xclbin section header array");
-  _ostream.write((char*) sectionHeader, sizeof(axlf_section_header) * m_sections.size());
-  _ostream.flush();
+  _ofile.write((const char*) _sectionHeaders.data(), sizeof(axlf_section_header) * _sectionHeaders.size());
 
   // Write out each of the sections
   for (unsigned int index = 0; index < m_sections.size(); ++index) {
-    XUtil::TRACE(XUtil::format("Writing section: Index: %d, ID: %d", index, sectionHeader[index].m_sectionKind));
+    XUtil::TRACE(XUtil::format("Writing section: Index: %d, ID: %d", index, _sectionHeaders[index].m_sectionKind));
 
     // Align section to next 8 byte boundary
-    unsigned int runningOffset = (unsigned int) _ostream.tellp();
+    uint64_t runningOffset = _ofile.tellp();
     unsigned int bytePadding = XUtil::bytesToAlign(runningOffset);
     if (bytePadding != 0) {
-      static char holePack[] = { (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0 };
-      _ostream.write(holePack, bytePadding);
-      _ostream.flush();
+      static const char holePack[] = { (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0, (char)0 };
+      _ofile.write(holePack, bytePadding);
     }
     runningOffset += bytePadding;
 
     // Check current and expected offsets
-    if (runningOffset != sectionHeader[index].m_sectionOffset) {
-      std::string errMsg = XUtil::format("ERROR: Expected offset (0x%lx) does not match actual (0x%lx)", sectionHeader[index].m_sectionOffset, runningOffset);
+    if (runningOffset != _sectionHeaders[index].m_sectionOffset) {
+      std::string errMsg = XUtil::format("ERROR: Expected offset (0x%lx) does not match actual (0x%lx)", _sectionHeaders[index].m_sectionOffset, runningOffset);
       throw std::runtime_error(errMsg);
     }
 
     // Write buffer
-    m_sections[index]->writeXclBinSectionBuffer(_ostream);
-
-    // Write mirror data
-    {
-      XUtil::TRACE("");
-      XUtil::TRACE(XUtil::format("Adding mirror properties[%d]", index));
-
-      boost::property_tree::ptree pt_sectionHeader;
-
-      XUtil::TRACE(XUtil::format("Kind: %d, Name: %s, Offset: 0x%lx, Size: 0x%lx",
-                                 sectionHeader[index].m_sectionKind,
-                                 sectionHeader[index].m_sectionName,
-                                 sectionHeader[index].m_sectionOffset,
-                                 sectionHeader[index].m_sectionSize));
-
-      pt_sectionHeader.put("Kind", XUtil::format("%d", sectionHeader[index].m_sectionKind).c_str());
-      pt_sectionHeader.put("Name", XUtil::format("%s", sectionHeader[index].m_sectionName).c_str());
-      pt_sectionHeader.put("Offset", XUtil::format("0x%lx", sectionHeader[index].m_sectionOffset).c_str());
-      pt_sectionHeader.put("Size", XUtil::format("0x%lx", sectionHeader[index].m_sectionSize).c_str());
-
-      boost::property_tree::ptree pt_Payload;
-      if (m_sections[index]->doesSupportAddFormatType(Section::FT_JSON) && 
-          m_sections[index]->doesSupportDumpFormatType(Section::FT_JSON)) {
-        m_sections[index]->getPayload(pt_Payload);
-      }
-
-      if (pt_Payload.size() != 0) {
-        pt_sectionHeader.add_child("payload", pt_Payload);
-      }
-
-      _mirroredData.add_child("section_header", pt_sectionHeader);
-    }
+    m_sections[index]->writeXclBinSectionBuffer(_ofile);
   }
-
-  delete[] sectionHeader;
 }
 
 
@@ -350,14 +367,9 @@ XclBin::writeXclBinBinary(const std::string &_binaryFileName,
     throw std::runtime_error(errMsg);
   }
 
-  // Write the xclbin file image
-  XUtil::TRACE("Writing the xclbin binary file: " + _binaryFileName);
-  std::fstream ofXclBin;
-  ofXclBin.open(_binaryFileName, std::ifstream::out | std::ifstream::binary);
-  if (!ofXclBin.is_open()) {
-    std::string errMsg = "ERROR: Unable to open the file for writing: " + _binaryFileName;
-    throw std::runtime_error(errMsg);
-  }
+  // Sections read from the file being overwritten must not refer to it
+  for (auto pSection : m_sections) 
+    pSection->detachFromFile(_binaryFileName);
 
   if (_bSkipUUIDInsertion) {
     XUtil::TRACE("Skipping xclbin's UUID insertion.");
@@ -371,29 +383,34 @@ XclBin::writeXclBinBinary(const std::string &_binaryFileName,
   // Add Version information
   addPTreeSchemaVersion(mirroredData, m_SchemaVersionMirrorWrite);
 
-  // Write in the header data
-  writeXclBinBinaryHeader(ofXclBin, mirroredData);
+  // Get the header mirror data
+  boost::property_tree::ptree pt_header;
+  addHeaderMirrorData(pt_header);
+  mirroredData.add_child("header", pt_header);
 
-  // Write the section array and sections
-  writeXclBinBinarySections(ofXclBin, mirroredData);
+  // Lay out the sections and collect their mirror data
+  std::vector<axlf_section_header> sectionHeaders;
+  uint64_t sectionsEnd = layoutXclBinBinarySections(sectionHeaders);
+  addSectionMirrorData(sectionHeaders, mirroredData);
 
-  // Write out our mirror data
-  writeXclBinBinaryMirrorData(ofXclBin, mirroredData);
+  std::ostringstream mirrorBuffer;
+  writeXclBinBinaryMirrorData(mirrorBuffer, mirroredData);
+  const std::string sMirrorData = mirrorBuffer.str();
 
-  // Update header file length
-  {
-    // Determine file size
-    ofXclBin.seekg(0, ofXclBin.end);
-    static_assert(sizeof(std::streamsize) <= sizeof(uint64_t), "std::streamsize precision is greater then 64 bits");
-    std::streamsize streamSize = (std::streamsize) ofXclBin.tellg();
+  // The file length is known up front, the header is written only once
+  m_xclBinHeader.m_header.m_length = sectionsEnd + sMirrorData.size();
+
+  // Write the xclbin file image
+  XUtil::TRACE("Writing the xclbin binary file: " + _binaryFileName);
+  XUtil::OutputFile ofXclBin(_binaryFileName);
 
-    // Update Header
-    m_xclBinHeader.m_header.m_length = (uint64_t) streamSize;
+  writeXclBinBinaryHeader(ofXclBin);
+  writeXclBinBinarySections(ofXclBin, sectionHeaders);
+  ofXclBin.write(sMirrorData.data(), sMirrorData.size());
 
-    // Write out the header...again
-    ofXclBin.seekg(0, ofXclBin.beg);
-    boost::property_tree::ptree dummyData;
-    writeXclBinBinaryHeader(ofXclBin, dummyData);
+  if (ofXclBin.tellp() != m_xclBinHeader.m_header.m_length) {
+    std::string errMsg = XUtil::format("ERROR: Expected file length (0x%lx) does not match actual (0x%lx)", m_xclBinHeader.m_header.m_length, ofXclBin.tellp());
+    throw std::runtime_error(errMsg);
   }
 
   // Close file
@@ -439,15 +456,14 @@ XclBin::getSchemaVersion(boost::property_tree::ptree& _pt, SchemaVersion& _schem
 }
 
 void
-XclBin::findAndReadMirrorData(std::fstream& _istream, boost::property_tree::ptree& _mirrorData) const {
+XclBin::findAndReadMirrorData(const XUtil::FileImage& _image, boost::property_tree::ptree& _mirrorData) const {
   XUtil::TRACE("Searching for mirrored data...");
 
   // Find start of buffer
-  _istream.seekg(0);
-  unsigned int startOffset = 0;
-  if (XUtil::findBytesInStream(_istream, MIRROR_DATA_START, startOffset) == true) {
+  uint64_t startOffset = 0;
+  if (XUtil::findBytesInBuffer(_image.data(), _image.size(), MIRROR_DATA_START, startOffset) == true) {
     XUtil::TRACE(XUtil::format("Found MIRROR_DATA_START at offset: 0x%lx", startOffset));
-    startOffset += (unsigned int) MIRROR_DATA_START.length();
+    startOffset += MIRROR_DATA_START.length();
   }  else {
     std::string errMsg;
     errMsg  = "ERROR: Mirror backup data not found in given file.\n"; 
@@ -460,26 +476,20 @@ XclBin::findAndReadMirrorData(std::fstream& _istream, boost::property_tree::ptre
   }
 
   // Find end of buffer (continue where we left off)
-  _istream.seekg(startOffset);
-  unsigned int bufferSize = 0;
-  if (XUtil::findBytesInStream(_istream, MIRROR_DATA_END, bufferSize) == true) {
+  uint64_t bufferSize = 0;
+  if (XUtil::findBytesInBuffer(_image.data() + startOffset, _image.size() - startOffset, MIRROR_DATA_END, bufferSize) == true) {
     XUtil::TRACE(XUtil::format("Found MIRROR_DATA_END.  Buffersize: 0x%lx", bufferSize));
   }  else {
     std::string errMsg = "ERROR: Mirror backup data not well formed in given file.";
     throw std::runtime_error(errMsg);
   }
 
-  // Bring the mirror metadata into memory
-  std::unique_ptr<unsigned char> memBuffer(new unsigned char[bufferSize]);
-  _istream.clear();
-  _istream.seekg(startOffset);
-  _istream.read((char*)memBuffer.get(), bufferSize);
-
-  XUtil::TRACE_BUF("Buffer", (char*)memBuffer.get(), bufferSize);
+  const char* pBuffer = _image.data() + startOffset;
+  XUtil::TRACE_BUF("Buffer", pBuffer, bufferSize);
 
   // Convert the JSON file to a boost property tree
   std::stringstream ss;
-  ss.write((char*) memBuffer.get(), bufferSize);
+  ss.write(pBuffer, bufferSize);
 
   try {
     boost::property_tree::read_json(ss, _mirrorData);
@@ -534,20 +544,20 @@ XclBin::readXclBinHeader(const boost::property_tree::ptree& _ptHeader,
 }
 
 void
-XclBin::readXclBinSection(std::fstream& _istream,
+XclBin::readXclBinSection(const std::shared_ptr<XUtil::FileImage>& _image,
                           const boost::property_tree::ptree& _ptSection) {
   enum axlf_section_kind eKind = (enum axlf_section_kind)_ptSection.get<unsigned int>("Kind");
 
   Section* pSection = Section::createSectionObjectOfKind(eKind);
 
-  pSection->readXclBinBinary(_istream, _ptSection);
+  pSection->readXclBinBinary(_image, _ptSection);
   addSection(pSection);
 }
 
 
 
 void
-XclBin::readXclBinaryMirrorImage(std::fstream& _istream,
+XclBin::readXclBinaryMirrorImage(const std::shared_ptr<XUtil::FileImage>& _image,
                                  const boost::property_tree::ptree& _mirrorData) {
   // Iterate over each entry
   for (boost::property_tree::ptree::const_iterator ptEntry = _mirrorData.begin();
@@ -570,7 +580,7 @@ XclBin::readXclBinaryMirrorImage(std::fstream& _istream,
 
     // ---------------------------------------------------------------------
     if (ptEntry->first == "section_header") {
-      readXclBinSection(_istream, ptEntry->second);
+      readXclBinSection(_image, ptEntry->second);
       continue;
     }
     XUtil::TRACE("Skipping unknown section: " + ptEntry->first);
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
 #include <vector>
 #include <boost/property_tree/ptree.hpp>
 
@@ -26,6 +27,7 @@
 #include "ParameterSectionData.h"
 
 class Section;
+namespace XclBinUtilities { class FileImage; class OutputFile; }
 
 class XclBin {
  public:
@@ -68,11 +70,11 @@ class XclBin {
 
  private:
   void updateHeaderFromSection(Section *_pSection);
-  void readXclBinBinaryHeader(std::fstream& _istream);
-  void readXclBinBinarySections(std::fstream& _istream);
+  void readXclBinBinaryHeader(const XclBinUtilities::FileImage& _image);
+  void readXclBinBinarySections(const std::shared_ptr<XclBinUtilities::FileImage>& _image);
 
-  void findAndReadMirrorData(std::fstream& _istream, boost::property_tree::ptree& _mirrorData) const;
-  void readXclBinaryMirrorImage(std::fstream& _istream, const boost::property_tree::ptree& _mirrorData);
+  void findAndReadMirrorData(const XclBinUtilities::FileImage& _image, boost::property_tree::ptree& _mirrorData) const;
+  void readXclBinaryMirrorImage(const std::shared_ptr<XclBinUtilities::FileImage>& _image, const boost::property_tree::ptree& _mirrorData);
 
   void writeXclBinBinaryMirrorData(std::ostream& _ostream, const boost::property_tree::ptree& _mirroredData) const;
 
@@ -90,9 +92,11 @@ class XclBin {
   // Should be in their own separate class
  private:
   void readXclBinHeader(const boost::property_tree::ptree& _ptHeader, struct axlf& _axlfHeader);
-  void readXclBinSection(std::fstream& _istream, const boost::property_tree::ptree& _ptSection);
-  void writeXclBinBinaryHeader(std::ostream& _ostream, boost::property_tree::ptree& _mirroredData);
-  void writeXclBinBinarySections(std::ostream& _ostream, boost::property_tree::ptree& _mirroredData);
+  void readXclBinSection(const std::shared_ptr<XclBinUtilities::FileImage>& _image, const boost::property_tree::ptree& _ptSection);
+  void writeXclBinBinaryHeader(XclBinUtilities::OutputFile& _ofile);
+  uint64_t layoutXclBinBinarySections(std::vector<axlf_section_header>& _sectionHeaders);
+  void addSectionMirrorData(const std::vector<axlf_section_header>& _sectionHeaders, boost::property_tree::ptree& _mirroredData) const;
+  void writeXclBinBinarySections(XclBinUtilities::OutputFile& _ofile, const std::vector<axlf_section_header>& _sectionHeaders) const;
 
 
  protected:
@@ -26,6 +26,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <vector>
+#include <algorithm>
 #include <boost/uuid/uuid.hpp>          // for uuid
 #include <boost/uuid/uuid_io.hpp>       // for to_string
 #include <boost/property_tree/json_parser.hpp>
@@ -36,6 +37,18 @@
   #include <winsock2.h>
 #else
   #include <arpa/inet.h>
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <limits.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/uio.h>
+  #include <unistd.h>
+#endif
+
+#ifdef __linux__
+  #include <sys/sendfile.h>
+  #include <sys/syscall.h>
 #endif
 
 namespace XUtil = XclBinUtilities;
@@ -379,27 +392,319 @@ XclBinUtilities::getUUIDAsString( const unsigned char (&_uuid)[16] )
 }
 
 
+std::shared_ptr<XclBinUtilities::FileImage>
+XclBinUtilities::FileImage::mapFile(const std::string& _sFileName)
+{
+  std::shared_ptr<FileImage> image(new FileImage());
+  image->m_sFileName = _sFileName;
+
+#ifdef _WIN32
+  std::fstream fs;
+  fs.open(_sFileName, std::ifstream::in | std::ifstream::binary);
+  if (!fs.is_open()) {
+    std::string errMsg = "ERROR: Unable to open the file for reading: " + _sFileName;
+    throw std::runtime_error(errMsg);
+  }
+  fs.seekg(0, fs.end);
+  uint64_t fileSize = (uint64_t) fs.tellg();
+  auto copy = readStream(fs, 0, fileSize);
+  image->m_buffer.swap(copy->m_buffer);
+  image->m_pData = image->m_buffer.data();
+  image->m_size = image->m_buffer.size();
+#else
+  int fd = ::open(_sFileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::string errMsg = "ERROR: Unable to open the file for reading: " + _sFileName;
+    throw std::runtime_error(errMsg);
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    std::string errMsg = "ERROR: Unable to determine the size of the file: " + _sFileName;
+    throw std::runtime_error(errMsg);
+  }
+
+  // An empty file cannot be mapped
+  if (st.st_size > 0) {
+    void* addr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      ::close(fd);
+      std::string errMsg = "ERROR: Unable to map the file: " + _sFileName;
+      throw std::runtime_error(errMsg);
+    }
+    image->m_pData = (char*) addr;
+    image->m_size = (uint64_t) st.st_size;
+    image->m_bMapped = true;
+  }
+  image->m_fd = fd;
+#endif
+
+  return image;
+}
+
+std::shared_ptr<XclBinUtilities::FileImage>
+XclBinUtilities::FileImage::readStream(std::istream& _istream, uint64_t _offset, uint64_t _size)
+{
+  std::shared_ptr<FileImage> image(new FileImage());
+  image->m_buffer.resize(_size);
+  image->m_pData = image->m_buffer.data();
+  image->m_size = _size;
+
+  _istream.clear();
+  _istream.seekg(_offset);
+  _istream.read(image->m_pData, _size);
+
+  if (_istream.gcount() != (std::streamsize) _size) {
+    std::string errMsg = "ERROR: Input stream for the binary buffer is smaller then the expected size.";
+    throw std::runtime_error(errMsg);
+  }
+
+  return image;
+}
+
+XclBinUtilities::FileImage::~FileImage()
+{
+#ifndef _WIN32
+  if (m_bMapped) 
+    ::munmap(m_pData, m_size);
+  if (m_fd >= 0) 
+    ::close(m_fd);
+#endif
+}
+
+XclBinUtilities::OutputFile::OutputFile(const std::string& _sFileName)
+  : m_sFileName(_sFileName)
+  , m_offset(0)
+{
+#ifdef _WIN32
+  m_ostream.open(_sFileName, std::ofstream::out | std::ofstream::binary);
+  if (!m_ostream.is_open()) {
+#else
+  m_fd = ::open(_sFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (m_fd < 0) {
+#endif
+    std::string errMsg = "ERROR: Unable to open the file for writing: " + _sFileName;
+    throw std::runtime_error(errMsg);
+  }
+}
+
+XclBinUtilities::OutputFile::~OutputFile()
+{
+#ifndef _WIN32
+  if (m_fd >= 0) 
+    ::close(m_fd);
+#endif
+}
+
+void
+XclBinUtilities::OutputFile::write(const char* _pData, uint64_t _size)
+{
+  if (_size == 0) 
+    return;
+
+  m_pending.emplace_back(_pData, _size);
+  m_offset += _size;
+}
+
+void
+XclBinUtilities::OutputFile::writeBuffer(const char* _pData, uint64_t _size)
+{
+#ifdef _WIN32
+  m_ostream.write(_pData, _size);
+  if (!m_ostream) {
+#else
+  while (_size != 0) {
+    ssize_t count = ::write(m_fd, _pData, _size);
+    if ((count < 0) && (errno == EINTR)) 
+      continue;
+    if (count <= 0) 
+      break;
+    _pData += count;
+    _size -= count;
+  }
+
+  if (_size != 0) {
+#endif
+    std::string errMsg = "ERROR: Unable to write to the file: " + m_sFileName;
+    throw std::runtime_error(errMsg);
+  }
+}
+
+void
+XclBinUtilities::OutputFile::flush()
+{
+#ifdef _WIN32
+  for (auto & entry : m_pending) 
+    writeBuffer(entry.first, entry.second);
+#else
+  // Gather the pending buffers, a short write resumes part way into
+  // the buffer it stopped in
+  size_t index = 0;
+  uint64_t skip = 0;
+  while (index < m_pending.size()) {
+    std::vector<struct iovec> iov;
+    for (size_t entry = index; (entry < m_pending.size()) && (iov.size() < IOV_MAX); ++entry) {
+      uint64_t entrySkip = (entry == index) ? skip : 0;
+      iov.push_back({ (void*) (m_pending[entry].first + entrySkip), m_pending[entry].second - entrySkip });
+    }
+
+    ssize_t count = ::writev(m_fd, iov.data(), (int) iov.size());
+    if ((count < 0) && (errno == EINTR)) 
+      continue;
+    if (count <= 0) {
+      std::string errMsg = "ERROR: Unable to write to the file: " + m_sFileName;
+      throw std::runtime_error(errMsg);
+    }
+
+    uint64_t written = (uint64_t) count;
+    while ((index < m_pending.size()) && (written >= m_pending[index].second - skip)) {
+      written -= m_pending[index].second - skip;
+      skip = 0;
+      ++index;
+    }
+    skip += written;
+  }
+#endif
+  m_pending.clear();
+}
+
+#ifdef __linux__
+static ssize_t
+copyFileRange(int _fdIn, off_t& _offsetIn, int _fdOut, uint64_t _size)
+{
+  // Kernels without copy_file_range, or that cannot use it between
+  // these two files, can still copy with sendfile
+#ifdef SYS_copy_file_range
+  static bool bCopyFileRange = true;
+  if (bCopyFileRange) {
+    loff_t offset = _offsetIn;
+    ssize_t count = ::syscall(SYS_copy_file_range, _fdIn, &offset, _fdOut, nullptr, _size, 0);
+    if (count > 0) {
+      _offsetIn = offset;
+      return count;
+    }
+    if ((count < 0) && (errno != EINTR)) 
+      bCopyFileRange = false;
+  }
+#endif
+  return ::sendfile(_fdOut, _fdIn, &_offsetIn, _size);
+}
+#endif
+
+void
+XclBinUtilities::OutputFile::copyFromImage(const FileImage& _image, const char* _pData, uint64_t _size)
+{
+  flush();
+
+  uint64_t copied = 0;
+#ifdef __linux__
+  // Copy from the file the image was mapped from, not from a file that
+  // may have been replaced under the same name since
+  if (_image.isMapped() && (_image.getFileDescriptor() >= 0)) {
+    off_t offset = (off_t) (_pData - _image.data());
+    while (copied < _size) {
+      ssize_t count = copyFileRange(_image.getFileDescriptor(), offset, m_fd, _size - copied);
+      if ((count < 0) && (errno == EINTR)) 
+        continue;
+      if (count <= 0) 
+        break;
+      copied += (uint64_t) count;
+    }
+  }
+#endif
+
+  // Whatever could not be copied between the files comes from the image
+  writeBuffer(_pData + copied, _size - copied);
+  m_offset += _size;
+}
+
+void
+XclBinUtilities::OutputFile::close()
+{
+  flush();
+
+#ifdef _WIN32
+  m_ostream.close();
+#else
+  int fd = m_fd;
+  m_fd = -1;
+  if (::close(fd) != 0) {
+    std::string errMsg = "ERROR: Unable to close the file: " + m_sFileName;
+    throw std::runtime_error(errMsg);
+  }
+#endif
+}
+
+bool
+XclBinUtilities::findBytesInBuffer(const char* _pBuffer, uint64_t _bufferSize, const std::string& _searchString, uint64_t& _foundOffset)
+{
+  _foundOffset = 0;
+
+  const uint64_t stringLength = _searchString.length();
+  if ((stringLength == 0) || (stringLength > _bufferSize)) 
+    return false;
+
+  // Boyer-Moore-Horspool: on a mismatch skip ahead by the distance of
+  // the last byte of the window to its last occurrence in the pattern
+  const unsigned char* pattern = (const unsigned char*) _searchString.data();
+  const unsigned char* buffer = (const unsigned char*) _pBuffer;
+
+  uint64_t skip[256];
+  for (auto& entry : skip)
+    entry = stringLength;
+  for (uint64_t index = 0; index < stringLength - 1; ++index)
+    skip[pattern[index]] = stringLength - 1 - index;
+
+  const unsigned char lastChar = pattern[stringLength - 1];
+  uint64_t position = 0;
+  while (position <= _bufferSize - stringLength) {
+    unsigned char aChar = buffer[position + stringLength - 1];
+    if ((aChar == lastChar) &&
+        (memcmp(buffer + position, pattern, stringLength - 1) == 0)) {
+      _foundOffset = position;
+      return true;
+    }
+    position += skip[aChar];
+  }
+
+  return false;
+}
+
 bool
 XclBinUtilities::findBytesInStream(std::fstream& _istream, const std::string& _searchString, unsigned int& _foundOffset) {
   _foundOffset = 0;
 
   std::iostream::pos_type savedLocation = _istream.tellg();
 
-  unsigned int stringLength = (unsigned int) _searchString.length();
-  unsigned int matchIndex = 0;
-
-  char aChar;
-  while (_istream.get(aChar)) {
-    ++_foundOffset;
-    if (aChar == _searchString[matchIndex++]) {
-      if (matchIndex == stringLength) {
-        _foundOffset -= stringLength;
-        return true;
-      }
-    } else {
-      matchIndex = 0;
+  // Search the stream in blocks that overlap by the length of the
+  // search string less one, so a match spanning two blocks is found
+  const uint64_t stringLength = _searchString.length();
+  const uint64_t blockSize = std::max<uint64_t>(1024 * 1024, stringLength * 2);
+  std::vector<char> block(blockSize);
+
+  uint64_t blockOffset = 0;   // Stream offset of the block relative to the saved location
+  uint64_t carried = 0;       // Bytes carried over from the previous block
+  while (true) {
+    _istream.read(block.data() + carried, blockSize - carried);
+    uint64_t bytesInBlock = carried + (uint64_t) _istream.gcount();
+
+    uint64_t foundOffset = 0;
+    if (findBytesInBuffer(block.data(), bytesInBlock, _searchString, foundOffset)) {
+      _foundOffset = (unsigned int) (blockOffset + foundOffset);
+      _istream.clear();
+      _istream.seekg(savedLocation + (std::streamoff) (_foundOffset + stringLength));
+      return true;
     }
+
+    if (!_istream || (stringLength == 0)) 
+      break;
+
+    carried = std::min<uint64_t>(stringLength - 1, bytesInBlock);
+    memmove(block.data(), block.data() + bytesInBlock - carried, carried);
+    blockOffset += bytesInBlock - carried;
   }
+
   _istream.clear();
   _istream.seekg(savedLocation);
 
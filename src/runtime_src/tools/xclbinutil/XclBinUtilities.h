@@ -131,6 +131,69 @@ void reportSignature(const std::string& _sInputFile);
 void removeSignature(const std::string& _sInputFile, const std::string& _sOutputFile);
 bool getSignature(std::fstream& _istream, std::string& _sSignature, std::string& _sSignedBy, unsigned int & _totalSize);
 
+// Read only image of an xclbin file.  On Linux the file is mapped
+// privately: pages are read from disk when first touched, and changes
+// made to the image are not written back to the file.  The file stays
+// open for the life of the image so ranges of it can be copied from
+// file to file.
+class FileImage {
+ public:
+  static std::shared_ptr<FileImage> mapFile(const std::string& _sFileName);
+  static std::shared_ptr<FileImage> readStream(std::istream& _istream, uint64_t _offset, uint64_t _size);
+  ~FileImage();
+
+  char* data() const { return m_pData; }
+  uint64_t size() const { return m_size; }
+  bool isMapped() const { return m_bMapped; }
+  const std::string& getFileName() const { return m_sFileName; }
+  int getFileDescriptor() const { return m_fd; }
+
+ private:
+  FileImage() {};
+  FileImage(const FileImage& obj) = delete;
+  FileImage& operator=(const FileImage& obj) = delete;
+
+  char* m_pData = nullptr;
+  uint64_t m_size = 0;
+  bool m_bMapped = false;
+  std::vector<char> m_buffer;
+  std::string m_sFileName;
+  int m_fd = -1;
+};
+
+// Sequential writer for an xclbin file.  Buffers passed to write() are
+// gathered and written with as few system calls as possible, they must
+// remain valid until the next flush().  Ranges of a mapped image are
+// copied from file to file without passing through user memory where
+// the platform supports it.
+class OutputFile {
+ public:
+  OutputFile(const std::string& _sFileName);
+  ~OutputFile();
+
+  void write(const char* _pData, uint64_t _size);
+  void copyFromImage(const FileImage& _image, const char* _pData, uint64_t _size);
+  void flush();
+  void close();
+  uint64_t tellp() const { return m_offset; }
+
+ private:
+  OutputFile(const OutputFile& obj) = delete;
+  OutputFile& operator=(const OutputFile& obj) = delete;
+
+  void writeBuffer(const char* _pData, uint64_t _size);
+
+  std::string m_sFileName;
+#ifdef _WIN32
+  std::ofstream m_ostream;
+#else
+  int m_fd;
+#endif
+  uint64_t m_offset;
+  std::vector<std::pair<const char*, uint64_t>> m_pending;
+};
+
+bool findBytesInBuffer(const char* _pBuffer, uint64_t _bufferSize, const std::string& _searchString, uint64_t& _foundOffset);
 bool findBytesInStream(std::fstream& _istream, const std::string& _searchString, unsigned int& _foundOffset);
 void setVerbose(bool _bVerbose);
 bool getVerbose();
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "ParameterSectionData.h"
+#include "XclBinClass.h"
+#include "XclBinUtilities.h"
+#include "Section.h"
+namespace XUtil = XclBinUtilities;
+
+#include "globals.h"
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+TEST(FindBytes, OverlappingPrefix) {
+   // A partial match must not hide a match that starts inside of it
+   const std::string sBuffer = "XCLBXCLBXCLBIN_MIRROR_DATA_START";
+   uint64_t offset = 0;
+   ASSERT_TRUE(XUtil::findBytesInBuffer(sBuffer.data(), sBuffer.size(), "XCLBIN_MIRROR_DATA_START", offset));
+   ASSERT_EQ(offset, 8);
+
+   ASSERT_TRUE(XUtil::findBytesInBuffer("aaab", 4, "aab", offset));
+   ASSERT_EQ(offset, 1);
+
+   ASSERT_FALSE(XUtil::findBytesInBuffer("aaaa", 4, "aab", offset));
+   ASSERT_FALSE(XUtil::findBytesInBuffer("aa", 2, "aab", offset));
+}
+
+TEST(FindBytes, StreamBlockBoundary) {
+   // Place the search string across the internal block boundary of the stream search
+   const std::string sSearch = "XCLBIN_MIRROR_DATA_END";
+   const uint64_t matchOffset = 1024 * 1024 - 5;
+   std::string sData(2 * 1024 * 1024, 'X');
+   sData.replace(matchOffset, sSearch.size(), sSearch);
+
+   const std::string sFileName = "FindBytesStream.bin";
+   {
+      std::ofstream ofs(sFileName, std::ofstream::binary);
+      ofs.write(sData.data(), sData.size());
+   }
+
+   std::fstream fs;
+   fs.open(sFileName, std::ifstream::in | std::ifstream::binary);
+   unsigned int foundOffset = 0;
+   ASSERT_TRUE(XUtil::findBytesInStream(fs, sSearch, foundOffset));
+   ASSERT_EQ(foundOffset, matchOffset);
+   ASSERT_EQ((uint64_t) fs.tellg(), matchOffset + sSearch.size());
+
+   // The search continues from the current position
+   ASSERT_FALSE(XUtil::findBytesInStream(fs, sSearch, foundOffset));
+   ASSERT_EQ((uint64_t) fs.tellg(), matchOffset + sSearch.size());
+}
+
+TEST(FindBytes, LargeXclbinTiming) {
+   // Create a large bitstream whose content is full of partial matches
+   // of the mirror data marker
+   const uint64_t bitstreamSize = 256 * 1024 * 1024;
+   const std::string sBitstreamFile = "LargeBitstream.bin";
+   const std::string sXclbinFile = "LargeXclbin.xclbin";
+   {
+      std::mt19937 rng(1);
+      const std::string sFragment = "XCLBIN_MIRROR_DATA_STAR_";
+      std::vector<char> block(1024 * 1024);
+      std::ofstream ofs(sBitstreamFile, std::ofstream::binary);
+      for (uint64_t written = 0; written < bitstreamSize; written += block.size()) {
+        for (auto & aChar : block)
+          aChar = (char) rng();
+        for (uint64_t index = 0; index + sFragment.size() < block.size(); index += 4096)
+          memcpy(block.data() + index, sFragment.data(), sFragment.size());
+        ofs.write(block.data(), block.size());
+      }
+   }
+
+   {
+      XclBin xclBin;
+      ParameterSectionData psd("BITSTREAM:RAW:" + sBitstreamFile);
+      xclBin.addSection(psd);
+      xclBin.writeXclBinBinary(sXclbinFile, true /* Skip UUID insertion */);
+   }
+
+   auto time = [](const std::string & _sLabel, const std::function<void()> & _func) {
+      auto start = std::chrono::steady_clock::now();
+      _func();
+      auto end = std::chrono::steady_clock::now();
+      std::cout << "   " << _sLabel << ": "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+   };
+
+   time("Read", [&]() {
+      XclBin xclBin;
+      xclBin.readXclBinBinary(sXclbinFile, false /* bMigrateForward */);
+      const Section * pSection = xclBin.findSection(BITSTREAM);
+      ASSERT_NE(pSection, nullptr);
+      ASSERT_EQ(pSection->getSize(), bitstreamSize);
+   });
+
+   time("Migrate", [&]() {
+      XclBin xclBin;
+      xclBin.readXclBinBinary(sXclbinFile, true /* bMigrateForward */);
+      const Section * pSection = xclBin.findSection(BITSTREAM);
+      ASSERT_NE(pSection, nullptr);
+      ASSERT_EQ(pSection->getSize(), bitstreamSize);
+   });
+
+   time("Signature", [&]() {
+      std::fstream fs;
+      fs.open(sXclbinFile, std::ifstream::in | std::ifstream::binary);
+      std::string sSignature, sSignedBy;
+      unsigned int totalSize = 0;
+      ASSERT_FALSE(XUtil::getSignature(fs, sSignature, sSignedBy, totalSize));
+   });
+
+   // Rewrite the file from its own image
+   {
+      XclBin xclBin;
+      xclBin.readXclBinBinary(sXclbinFile, false /* bMigrateForward */);
+      xclBin.writeXclBinBinary(sXclbinFile, true /* Skip UUID insertion */);
+   }
+
+   XclBin xclBin;
+   xclBin.readXclBinBinary(sXclbinFile, false /* bMigrateForward */);
+   const Section * pSection = xclBin.findSection(BITSTREAM);
+   ASSERT_NE(pSection, nullptr);
+   std::ostringstream contents;
+   pSection->dumpContents(contents, Section::FT_RAW);
+   std::ifstream ifs(sBitstreamFile, std::ifstream::binary);
+   std::ostringstream expected;
+   expected << ifs.rdbuf();
+   ASSERT_TRUE(contents.str() == expected.str()) << "Bitstream changed after rewriting the xclbin in place";
+
+   boost::filesystem::remove(sBitstreamFile);
+   boost::filesystem::remove(sXclbinFile);
+}
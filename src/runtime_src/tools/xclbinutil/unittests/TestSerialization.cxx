@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 #include "ParameterSectionData.h"
 #include "XclBinClass.h"
+#include "Section.h"
 
 #include "globals.h"
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
 
 TEST(Serialization, ReadXclbin_2018_2) {
    XclBin xclBin;
@@ -30,3 +33,51 @@ TEST(Serialization, ReadWriteReadXclbin) {
    XclBin xclBin2;
    xclBin2.readXclBinBinary("ReadWriteReadXclbin.xclbin", false /* bMigrateForward */);
 }
+
+TEST(Serialization, WriteReadSections) {
+   boost::filesystem::path resourceDir(TestUtilities::getResourceDir());
+   const std::string sXclbinFile = "WriteReadSections.xclbin";
+
+   XclBin xclBin;
+   const std::vector<std::string> sections = { "IP_LAYOUT:JSON:" + (resourceDir / "ip_layout_base.json").string(),
+                                               "BUILD_METADATA:JSON:" + (resourceDir / "metadata.json").string(),
+                                               "DEBUG_DATA:RAW:" + (resourceDir / "unique_data1.bin").string() };
+   for (auto & sSection : sections) {
+      ParameterSectionData psd(sSection);
+      xclBin.addSection(psd);
+   }
+   xclBin.writeXclBinBinary(sXclbinFile, true /* Skip UUID insertion */);
+
+   // The header carries the length of the file
+   axlf header = axlf {0};
+   std::ifstream ifs(sXclbinFile, std::ifstream::binary);
+   ifs.read((char*) &header, sizeof(axlf));
+   ASSERT_EQ(header.m_header.m_length, boost::filesystem::file_size(sXclbinFile));
+   ASSERT_EQ(header.m_header.m_numSections, sections.size());
+
+   // Sections read back match the originals
+   XclBin xclBin2;
+   xclBin2.readXclBinBinary(sXclbinFile, false /* bMigrateForward */);
+   for (auto eKind : { IP_LAYOUT, BUILD_METADATA, DEBUG_DATA }) {
+      const Section * pSection = xclBin.findSection(eKind);
+      const Section * pSection2 = xclBin2.findSection(eKind);
+      ASSERT_NE(pSection, nullptr);
+      ASSERT_NE(pSection2, nullptr);
+
+      std::ostringstream contents, contents2;
+      pSection->dumpContents(contents, Section::FT_RAW);
+      pSection2->dumpContents(contents2, Section::FT_RAW);
+      ASSERT_TRUE(contents.str() == contents2.str()) << "Section contents differ: " << pSection->getSectionKindAsString();
+   }
+
+   // So does a section rebuilt from its mirror data
+   XclBin xclBin3;
+   xclBin3.readXclBinBinary(sXclbinFile, true /* bMigrateForward */);
+   std::ostringstream contents, contents3;
+   xclBin.findSection(IP_LAYOUT)->dumpContents(contents, Section::FT_RAW);
+   xclBin3.findSection(IP_LAYOUT)->dumpContents(contents3, Section::FT_RAW);
+   ASSERT_TRUE(contents.str() == contents3.str()) << "Section contents differ: IP_LAYOUT";
+
+   ifs.close();
+   boost::filesystem::remove(sXclbinFile);
+}
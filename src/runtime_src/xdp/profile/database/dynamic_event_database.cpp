@@ -19,9 +19,11 @@
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/database/dynamic_event_database.h"
 #include "xdp/profile/database/events/device_events.h"
+#include "xdp/profile/database/events/event_arena.h"
 
 #include "core/common/time.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace xdp {
@@ -50,8 +52,9 @@ namespace xdp {
 
     {
       std::lock_guard<std::mutex> lock(hostEventsLock) ;
+      mergeHostEvents() ;
       for (auto event : hostEvents) {
-      delete event.second;
+        delete event ;
       }
     }
 
@@ -64,6 +67,9 @@ namespace xdp {
         device.second.clear();
       }
     }
+
+    // Events still alive keep their slabs
+    EventArena::trim() ;
   }
 
   void VPDynamicDatabase::markXclbinEnd(uint64_t deviceId)
@@ -73,19 +79,40 @@ namespace xdp {
 
   void VPDynamicDatabase::addHostEvent(VTFEvent* event)
   {
-    std::lock_guard<std::mutex> lock(hostEventsLock) ;
-
     event->setEventId(eventId++) ;
-    hostEvents.emplace(event->getTimestamp(), event) ;
-    //hostEvents.push_back(event) ;
+    hostEventBuffer.append(event) ;
   }
 
   void VPDynamicDatabase::addUnsortedEvent(VTFEvent* event)
   {
-    std::lock_guard<std::mutex> lock(unsortedEventsLock) ;
     event->setEventId(eventId++) ;
+    unsortedEventBuffer.append(event) ;
+  }
+
+  // Must be called with hostEventsLock held.  Events from one thread
+  //  are mostly in timestamp order already, so sort the newly logged
+  //  events and merge them with the sorted events.  Both sorts are
+  //  stable, so events with equal timestamps stay in logged order.
+  void VPDynamicDatabase::mergeHostEvents()
+  {
+    auto sorted = hostEvents.size() ;
+    hostEventBuffer.drain(hostEvents) ;
+    if (hostEvents.size() == sorted)
+      return ;
+
+    auto compare = [](VTFEvent* x, VTFEvent* y)
+                   {
+                     return x->getTimestamp() < y->getTimestamp() ;
+                   } ;
+    auto middle = hostEvents.begin() + sorted ;
+    std::stable_sort(middle, hostEvents.end(), compare) ;
+    std::inplace_merge(hostEvents.begin(), middle, hostEvents.end(), compare) ;
+  }
 
-    unsortedHostEvents.push_back(event) ;
+  // Must be called with unsortedEventsLock held
+  void VPDynamicDatabase::mergeUnsortedHostEvents()
+  {
+    unsortedEventBuffer.drain(unsortedHostEvents) ;
   }
 
   void VPDynamicDatabase::addDeviceEvent(uint64_t deviceId, VTFEvent* event)
@@ -231,8 +258,9 @@ namespace xdp {
     // For now, go through both host events and device events.
     {
       std::lock_guard<std::mutex> lock(hostEventsLock) ;
+      mergeHostEvents() ;
       for (auto e : hostEvents) {
-        if (filter(e.second)) collected.push_back(e.second) ;
+        if (filter(e)) collected.push_back(e) ;
       }
     }
 
@@ -251,11 +279,12 @@ namespace xdp {
   std::vector<VTFEvent*> VPDynamicDatabase::filterHostEvents(std::function<bool(VTFEvent*)> filter)
   {
     std::lock_guard<std::mutex> lock(hostEventsLock) ;
+    mergeHostEvents() ;
     std::vector<VTFEvent*> collected ;
 
     for (auto e : hostEvents)
     {
-      if (filter(e.second)) collected.push_back(e.second) ;
+      if (filter(e)) collected.push_back(e) ;
     }
     return collected ;
   }
@@ -263,16 +292,19 @@ namespace xdp {
   std::vector<std::unique_ptr<VTFEvent>> VPDynamicDatabase::filterEraseHostEvents(std::function<bool(VTFEvent*)> filter)
   {
     std::lock_guard<std::mutex> lock(hostEventsLock) ;
+    mergeHostEvents() ;
     std::vector<std::unique_ptr<VTFEvent>> collected ;
 
-    for (auto it=hostEvents.begin(); it!=hostEvents.end();) {
-      if (filter(it->second)) {
-        collected.emplace_back(it->second);
-        it = hostEvents.erase(it);
-      } else {
-        ++it;
-      }
+    // Compact the remaining events in place rather than erasing
+    //  one at a time
+    auto kept = hostEvents.begin() ;
+    for (auto e : hostEvents) {
+      if (filter(e))
+        collected.emplace_back(e);
+      else
+        *kept++ = e;
     }
+    hostEvents.erase(kept, hostEvents.end());
     return collected ;
   }
 
@@ -281,34 +313,33 @@ namespace xdp {
   filterEraseUnsortedHostEvents(std::function<bool(VTFEvent*)> filter)
   {
     std::lock_guard<std::mutex> lock(unsortedEventsLock);
+    mergeUnsortedHostEvents() ;
     std::vector<VTFEvent*> collected ;
 
-    for (auto it=unsortedHostEvents.begin(); it!=unsortedHostEvents.end();){
-      if (filter(*it)) {
-        collected.emplace_back(*it);
-        it = unsortedHostEvents.erase(it);
-      } else {
-        ++it ;
-      }
+    auto kept = unsortedHostEvents.begin() ;
+    for (auto e : unsortedHostEvents) {
+      if (filter(e))
+        collected.emplace_back(e);
+      else
+        *kept++ = e;
     }
+    unsortedHostEvents.erase(kept, unsortedHostEvents.end());
     return collected ;
   }
 
   std::vector<VTFEvent*> VPDynamicDatabase::getHostEvents()
   {
     std::lock_guard<std::mutex> lock(hostEventsLock) ;
-    std::vector<VTFEvent*> events;
-    for(auto e : hostEvents) {
-      events.push_back(e.second);
-    }
-    return events;
+    mergeHostEvents() ;
+    return hostEvents;
   }
 
   bool VPDynamicDatabase::hostEventsExist(std::function<bool(VTFEvent*)> filter)
   {
     std::lock_guard<std::mutex> lock(hostEventsLock) ;
-    for (auto it=hostEvents.begin(); it!=hostEvents.end(); it++) {
-      if (filter(it->second))
+    mergeHostEvents() ;
+    for (auto e : hostEvents) {
+      if (filter(e))
         return true;
     }
     return false;
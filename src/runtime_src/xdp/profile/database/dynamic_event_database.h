@@ -27,6 +27,7 @@
 #include <atomic>
 
 #include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/database/host_event_buffer.h"
 
 #include "xdp/config.h"
 #include "core/common/uuid.h"
@@ -66,12 +67,15 @@ namespace xdp {
     typedef std::map<double, std::string> CounterNames ;
 
   private:
-    // For sorted host events, we need a multimap because multithreaded
-    //  applications can create unsorted events
-    std::multimap<double, VTFEvent*> hostEvents ;
+    // Host events are logged into per thread buffers without taking
+    //  a shared lock.  They are merged into hostEvents, sorted on
+    //  timestamp, only when they are requested, typically by a writer.
+    HostEventBuffer hostEventBuffer ;
+    std::vector<VTFEvent*> hostEvents ;
 
     // For host events that we don't care about sorting, we can just store
     //  in a simple vector
+    HostEventBuffer unsortedEventBuffer ;
     std::vector<VTFEvent*> unsortedHostEvents ;
 
     // Every device will have its own set of events.  Since the actual
@@ -148,6 +152,8 @@ namespace xdp {
     //std::map<uint64_t, uint64_t> traceIDMap;
 
     void addHostEvent(VTFEvent* event) ;
+    void mergeHostEvents() ;
+    void mergeUnsortedHostEvents() ;
     void addDeviceEvent(uint64_t deviceId, VTFEvent* event) ;
 
   public:
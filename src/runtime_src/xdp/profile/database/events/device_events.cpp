@@ -52,7 +52,7 @@ namespace xdp {
   void VTFDeviceEvent::dump(std::ofstream& fout, uint32_t bucket)
   { 
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n";
   } 
 
   KernelEvent::KernelEvent(uint64_t s_id, double ts, VTFEventType ty,
@@ -87,7 +87,7 @@ namespace xdp {
   void KernelStall::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl;
+    fout << "\n";
   }
 
   DeviceMemoryAccess::DeviceMemoryAccess(uint64_t s_id, double ts, VTFEventType ty,
@@ -0,0 +1,262 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_SOURCE
+
+#include "xdp/profile/database/events/event_arena.h"
+
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  constexpr size_t granularity = 8 ;
+  constexpr size_t numClasses  = xdp::EventArena::maxSize / granularity ;
+  constexpr size_t slabSize    = 64 * 1024 ;
+  constexpr size_t batchSize   = 256 ;
+
+  struct FreeBlock
+  {
+    FreeBlock* next ;
+  } ;
+
+  // A list of free blocks with its length
+  struct FreeList
+  {
+    FreeBlock* head = nullptr ;
+    size_t count = 0 ;
+  } ;
+
+  // Shared state of one size class.  Accessed only when a thread
+  //  runs out of free blocks or has too many.
+  struct SizeClass
+  {
+    std::mutex lock ;
+    std::vector<FreeList> batches ;
+    std::vector<char*> slabs ;
+    char* slab = nullptr ;
+    size_t slabRemaining = 0 ;
+    size_t numCarved = 0 ;  // Blocks carved from all slabs
+    size_t numFree = 0 ;    // Blocks in batches
+  } ;
+
+  // The size classes are never destroyed, events may be deleted
+  //  during static destruction after this translation unit is done.
+  SizeClass* getSizeClasses()
+  {
+    static SizeClass* classes = new SizeClass[numClasses] ;
+    return classes ;
+  }
+
+  inline size_t classIndex(size_t size)
+  {
+    return (size + granularity - 1) / granularity - 1 ;
+  }
+
+  // Carve a batch of blocks from the slab of a size class,
+  //  must be called with the size class lock held
+  FreeList carve(SizeClass& sc, size_t blockSize)
+  {
+    FreeList list ;
+    for (size_t i = 0 ; i < batchSize ; ++i) {
+      if (sc.slabRemaining < blockSize) {
+        sc.slab = static_cast<char*>(::operator new(slabSize)) ;
+        sc.slabRemaining = slabSize ;
+        sc.slabs.push_back(sc.slab) ;
+      }
+      auto block = reinterpret_cast<FreeBlock*>(sc.slab) ;
+      sc.slab += blockSize ;
+      sc.slabRemaining -= blockSize ;
+      block->next = list.head ;
+      list.head = block ;
+      ++list.count ;
+    }
+    sc.numCarved += list.count ;
+    return list ;
+  }
+
+  FreeList acquire(size_t idx)
+  {
+    auto& sc = getSizeClasses()[idx] ;
+    std::lock_guard<std::mutex> lock(sc.lock) ;
+    if (!sc.batches.empty()) {
+      auto list = sc.batches.back() ;
+      sc.batches.pop_back() ;
+      sc.numFree -= list.count ;
+      return list ;
+    }
+    return carve(sc, (idx + 1) * granularity) ;
+  }
+
+  void release(size_t idx, FreeList list)
+  {
+    if (list.head == nullptr)
+      return ;
+    auto& sc = getSizeClasses()[idx] ;
+    std::lock_guard<std::mutex> lock(sc.lock) ;
+    sc.batches.push_back(list) ;
+    sc.numFree += list.count ;
+  }
+
+  // Per thread free lists.  This object is trivially destructible so
+  //  it stays accessible during thread exit, when events can still be
+  //  deleted after the cache has been flushed.
+  struct ThreadCache
+  {
+    FreeList lists[numClasses] ;
+    bool registered ;
+    bool flushed ;
+  } ;
+
+  thread_local ThreadCache threadCache ;
+
+  // Return the blocks of an exiting thread to the global lists
+  struct ThreadCacheFlusher
+  {
+    ~ThreadCacheFlusher()
+    {
+      for (size_t idx = 0 ; idx < numClasses ; ++idx) {
+        release(idx, threadCache.lists[idx]) ;
+        threadCache.lists[idx] = FreeList() ;
+      }
+      threadCache.flushed = true ;
+    }
+  } ;
+
+  thread_local ThreadCacheFlusher threadCacheFlusher ;
+
+  inline ThreadCache* getThreadCache()
+  {
+    auto cache = &threadCache ;
+    if (cache->flushed)
+      return nullptr ;
+    if (!cache->registered) {
+      // Odr-use of the flusher constructs it for this thread
+      (void)&threadCacheFlusher ;
+      cache->registered = true ;
+    }
+    return cache ;
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  size_t EventArena::trim()
+  {
+    // Hand the blocks cached by this thread back first
+    if (auto cache = getThreadCache()) {
+      for (size_t idx = 0 ; idx < numClasses ; ++idx) {
+        release(idx, cache->lists[idx]) ;
+        cache->lists[idx] = FreeList() ;
+      }
+    }
+
+    // A size class can only go when all of its blocks are in the
+    //  global batches, none are used by events or cached by threads
+    size_t released = 0 ;
+    auto classes = getSizeClasses() ;
+    for (size_t idx = 0 ; idx < numClasses ; ++idx) {
+      auto& sc = classes[idx] ;
+      std::lock_guard<std::mutex> lock(sc.lock) ;
+      if (sc.slabs.empty() || sc.numFree != sc.numCarved)
+        continue ;
+      for (auto slab : sc.slabs)
+        ::operator delete(slab) ;
+      released += sc.slabs.size() * slabSize ;
+      sc.slabs.clear() ;
+      sc.batches.clear() ;
+      sc.slab = nullptr ;
+      sc.slabRemaining = 0 ;
+      sc.numCarved = 0 ;
+      sc.numFree = 0 ;
+    }
+    return released ;
+  }
+
+  void* EventArena::allocate(size_t size)
+  {
+    if (size == 0 || size > maxSize)
+      return ::operator new(size) ;
+
+    auto idx = classIndex(size) ;
+    auto cache = getThreadCache() ;
+    if (cache == nullptr) {
+      // Thread is exiting, take a single block from a global batch
+      auto list = acquire(idx) ;
+      auto block = list.head ;
+      list.head = block->next ;
+      --list.count ;
+      release(idx, list) ;
+      return block ;
+    }
+
+    auto& list = cache->lists[idx] ;
+    if (list.head == nullptr)
+      list = acquire(idx) ;
+
+    auto block = list.head ;
+    list.head = block->next ;
+    --list.count ;
+    return block ;
+  }
+
+  void EventArena::deallocate(void* ptr, size_t size)
+  {
+    if (ptr == nullptr)
+      return ;
+
+    if (size == 0 || size > maxSize) {
+      ::operator delete(ptr) ;
+      return ;
+    }
+
+    auto idx = classIndex(size) ;
+    auto block = static_cast<FreeBlock*>(ptr) ;
+    auto cache = getThreadCache() ;
+    if (cache == nullptr) {
+      FreeList single ;
+      block->next = nullptr ;
+      single.head = block ;
+      single.count = 1 ;
+      release(idx, single) ;
+      return ;
+    }
+
+    auto& list = cache->lists[idx] ;
+    block->next = list.head ;
+    list.head = block ;
+    ++list.count ;
+
+    // A thread that only deletes events, such as a trace writer,
+    //  hands them back to the threads that create events
+    if (list.count >= 2 * batchSize) {
+      FreeList batch ;
+      batch.head = list.head ;
+      auto last = list.head ;
+      for (size_t i = 1 ; i < batchSize ; ++i)
+        last = last->next ;
+      list.head = last->next ;
+      last->next = nullptr ;
+      batch.count = batchSize ;
+      list.count -= batchSize ;
+      release(idx, batch) ;
+    }
+  }
+
+} // end namespace xdp
@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef EVENT_ARENA_DOT_H
+#define EVENT_ARENA_DOT_H
+
+#include <cstddef>
+
+#include "xdp/config.h"
+
+namespace xdp {
+
+  // The EventArena is the allocator behind VTFEvent::operator new.
+  //  Long running applications with trace enabled create tens of
+  //  millions of small event objects.  Allocating them individually
+  //  from the heap costs a malloc header and alignment padding per
+  //  event and scatters events of the same type across memory.
+  //
+  // Instead, events are carved from large slabs, one set of slabs per
+  //  8 byte size class, without any per event header.  Freed events
+  //  go to a per thread free list and are exchanged in batches with
+  //  a global free list per size class, so both allocation and
+  //  deallocation are lock free in the common case.  Slab memory is
+  //  reused for new events and returned to the system by trim().
+  class EventArena
+  {
+  public:
+    // Objects larger than this are allocated from the heap
+    static constexpr size_t maxSize = 256 ;
+
+    XDP_EXPORT static void* allocate(size_t size) ;
+    XDP_EXPORT static void deallocate(void* ptr, size_t size) ;
+
+    // Free the slabs of every size class that has no live events and
+    //  no blocks cached by other threads.  Returns the number of
+    //  bytes released.  Called when the database deletes its events.
+    XDP_EXPORT static size_t trim() ;
+  } ;
+
+} // end namespace xdp
+
+#endif
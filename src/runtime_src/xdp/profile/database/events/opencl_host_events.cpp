@@ -50,7 +50,7 @@ namespace xdp {
     fout << "," << workgroupConfiguration ;
     fout << "," << workgroupSize ;
     fout << "," << 0 ; // This is the "size"
-    fout << std::endl; 
+    fout << "\n"; 
   }
 
   LOPKernelEnqueue::LOPKernelEnqueue(uint64_t s_id, double ts) :
@@ -65,7 +65,7 @@ namespace xdp {
   void LOPKernelEnqueue::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << std::endl ;
+    fout << "\n" ;
   }
 
   /*
@@ -99,7 +99,7 @@ namespace xdp {
     if(0 == start_id) {  // Dump the detailed information only for start event
       fout << "," << size;
     }
-    fout << std::endl;
+    fout << "\n";
   }
 
   OpenCLBufferTransfer::OpenCLBufferTransfer(uint64_t s_id, double ts,
@@ -127,7 +127,7 @@ namespace xdp {
       fout << "," << memoryResource ;
       fout << ",0x" << std::hex << threadId << std::dec ;
     }
-    fout << std::endl ;
+    fout << "\n" ;
   }
 
 
@@ -159,7 +159,7 @@ namespace xdp {
 	   << "," << dstMemoryResource 
 	   << ",0x" << std::hex << threadId << std::dec ;
     }
-    fout << std::endl ;
+    fout << "\n" ;
   }
 
   LOPBufferTransfer::LOPBufferTransfer(uint64_t s_id, double ts, 
@@ -176,7 +176,7 @@ namespace xdp {
   void LOPBufferTransfer::dump(std::ofstream& fout, uint32_t bucket)
   {
     VTFEvent::dump(fout, bucket) ;
-    fout << "," << std::hex << "0x" << threadId << std::dec << std::endl ;
+    fout << "," << std::hex << "0x" << threadId << std::dec << "\n" ;
   }
 
   StreamRead::StreamRead(uint64_t s_id, double ts) :
@@ -20,6 +20,7 @@
 #define XDP_SOURCE
 
 #include "xdp/profile/database/events/vtf_event.h"
+#include "xdp/profile/database/events/event_arena.h"
 
 namespace xdp {
 
@@ -36,6 +37,16 @@ namespace xdp {
   {
   }
 
+  void* VTFEvent::operator new(std::size_t size)
+  {
+    return EventArena::allocate(size) ;
+  }
+
+  void VTFEvent::operator delete(void* ptr, std::size_t size)
+  {
+    EventArena::deallocate(ptr, size) ;
+  }
+
   void VTFEvent::dump(std::ofstream& fout, uint32_t bucket)
   {
     fout << id << "," << start_id << "," ;
@@ -17,6 +17,7 @@
 #ifndef VTF_EVENT_DOT_H
 #define VTF_EVENT_DOT_H
 
+#include <cstddef>
 #include <fstream>
 
 #include "xdp/config.h"
@@ -94,6 +95,11 @@ namespace xdp {
     XDP_EXPORT VTFEvent(uint64_t s_id, double ts, VTFEventType ty) ;
     XDP_EXPORT virtual ~VTFEvent() ;
 
+    // All events are allocated from the EventArena.  The virtual
+    //  destructor passes the size of the most derived event.
+    XDP_EXPORT static void* operator new(std::size_t size) ;
+    XDP_EXPORT static void operator delete(void* ptr, std::size_t size) ;
+
     // Getters and Setters
     inline double       getTimestamp()    const { return timestamp ; }
     inline void         setTimestamp(double ts) { timestamp = ts ; }
@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_SOURCE
+
+#include "xdp/profile/database/host_event_buffer.h"
+#include "xdp/profile/database/events/vtf_event.h"
+
+#include <utility>
+
+namespace {
+
+  std::atomic<uint64_t> nextBufferId{1} ;
+
+  // Per thread map of HostEventBuffer ids to the thread's buffer.
+  //  There are only a few HostEventBuffer objects in a process, so a
+  //  linear search with a cache of the last hit is fast enough.
+  struct ThreadLocalBuffers
+  {
+    std::vector<std::pair<uint64_t, void*>> entries ;
+    uint64_t lastId = 0 ;
+    void* last = nullptr ;
+  } ;
+
+  thread_local ThreadLocalBuffers threadBuffers ;
+
+} // end anonymous namespace
+
+namespace xdp {
+
+  HostEventBuffer::ThreadBuffer::~ThreadBuffer()
+  {
+    // Events still in the buffer were never drained and are
+    //  owned by the buffer
+    size_t first = consumed ;
+    while (head) {
+      size_t count = head->count.load(std::memory_order_acquire) ;
+      for (size_t i = first ; i < count ; ++i)
+        delete head->events[i] ;
+      auto next = head->next.load(std::memory_order_acquire) ;
+      delete head ;
+      head = next ;
+      first = 0 ;
+    }
+  }
+
+  HostEventBuffer::HostEventBuffer() : id(nextBufferId++)
+  {
+  }
+
+  HostEventBuffer::~HostEventBuffer()
+  {
+  }
+
+  HostEventBuffer::ThreadBuffer* HostEventBuffer::getThreadBuffer()
+  {
+    auto& local = threadBuffers ;
+    if (local.lastId == id)
+      return static_cast<ThreadBuffer*>(local.last) ;
+
+    ThreadBuffer* buffer = nullptr ;
+    for (auto& entry : local.entries) {
+      if (entry.first == id) {
+        buffer = static_cast<ThreadBuffer*>(entry.second) ;
+        break ;
+      }
+    }
+
+    // First event logged from this thread
+    if (buffer == nullptr) {
+      std::unique_ptr<ThreadBuffer> created(new ThreadBuffer) ;
+      buffer = created.get() ;
+      {
+        std::lock_guard<std::mutex> lock(buffersLock) ;
+        buffers.push_back(std::move(created)) ;
+      }
+      local.entries.emplace_back(id, buffer) ;
+    }
+
+    local.lastId = id ;
+    local.last = buffer ;
+    return buffer ;
+  }
+
+  void HostEventBuffer::append(VTFEvent* event)
+  {
+    auto buffer = getThreadBuffer() ;
+    auto tail = buffer->tail ;
+    size_t count = tail->count.load(std::memory_order_relaxed) ;
+
+    if (count == chunkSize) {
+      // The consumer may free the full chunk as soon as the
+      //  next chunk is linked, so it must not be touched after
+      auto chunk = new Chunk ;
+      chunk->events[0] = event ;
+      chunk->count.store(1, std::memory_order_relaxed) ;
+      buffer->tail = chunk ;
+      tail->next.store(chunk, std::memory_order_release) ;
+      return ;
+    }
+
+    tail->events[count] = event ;
+    tail->count.store(count + 1, std::memory_order_release) ;
+  }
+
+  void HostEventBuffer::drain(std::vector<VTFEvent*>& events)
+  {
+    std::vector<ThreadBuffer*> current ;
+    {
+      std::lock_guard<std::mutex> lock(buffersLock) ;
+      current.reserve(buffers.size()) ;
+      for (auto& buffer : buffers)
+        current.push_back(buffer.get()) ;
+    }
+
+    for (auto buffer : current) {
+      while (true) {
+        auto head = buffer->head ;
+        size_t count = head->count.load(std::memory_order_acquire) ;
+        for (size_t i = buffer->consumed ; i < count ; ++i)
+          events.push_back(head->events[i]) ;
+        buffer->consumed = count ;
+
+        if (count < chunkSize)
+          break ;
+
+        // The producer links the next chunk only after it has
+        //  finished with this one
+        auto next = head->next.load(std::memory_order_acquire) ;
+        if (next == nullptr)
+          break ;
+        buffer->head = next ;
+        buffer->consumed = 0 ;
+        delete head ;
+      }
+    }
+  }
+
+} // end namespace xdp
@@ -0,0 +1,90 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef HOST_EVENT_BUFFER_DOT_H
+#define HOST_EVENT_BUFFER_DOT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace xdp {
+
+  // Forward declarations
+  class VTFEvent ;
+
+  // The HostEventBuffer collects events logged from any number of
+  //  threads without a shared lock.  Every thread appends to its own
+  //  list of fixed size chunks.  A single reader at a time drains
+  //  the events of all threads, typically when a writer runs.
+  //
+  // Each per thread list is a single producer, single consumer queue.
+  //  The producer publishes an event by incrementing the count of the
+  //  tail chunk and a full chunk by linking in the next chunk.  The
+  //  consumer only frees chunks the producer has moved past.
+  class HostEventBuffer
+  {
+  private:
+    static constexpr size_t chunkSize = 512 ;
+
+    struct Chunk
+    {
+      VTFEvent* events[chunkSize] ;
+      std::atomic<size_t> count{0} ;
+      std::atomic<Chunk*> next{nullptr} ;
+    } ;
+
+    struct ThreadBuffer
+    {
+      Chunk* head ;         // Owned by the consumer
+      size_t consumed = 0 ; // Owned by the consumer
+      Chunk* tail ;         // Owned by the producer
+
+      ThreadBuffer() : head(new Chunk), tail(head) { }
+      ~ThreadBuffer() ;
+    } ;
+
+    // Unique id so a thread local lookup never matches a buffer
+    //  that was destroyed and reallocated at the same address
+    uint64_t id ;
+
+    // Buffers of all threads that ever logged to this object.
+    //  The lock is taken only when a thread logs its first event
+    //  and when the buffers are drained.
+    std::mutex buffersLock ;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers ;
+
+    ThreadBuffer* getThreadBuffer() ;
+
+  public:
+    HostEventBuffer() ;
+    ~HostEventBuffer() ;
+
+    // Append an event from the calling thread
+    void append(VTFEvent* event) ;
+
+    // Move all events appended so far into the vector, per thread in
+    //  the order they were appended.  Calls to drain must be
+    //  serialized by the caller.
+    void drain(std::vector<VTFEvent*>& events) ;
+  } ;
+
+} // end namespace xdp
+
+#endif
@@ -17,15 +17,31 @@
 #include <vector>
 #include <thread>
 #include <iostream>
+#include <atomic>
 
 #define XDP_SOURCE
 
 #include "xdp/profile/database/statistics_database.h"
 
+namespace {
+
+  std::atomic<uint64_t> nextStatisticsId{1} ;
+
+  // Last call table used by this thread and the id of its database
+  struct CachedCallTable
+  {
+    uint64_t id = 0 ;
+    void* table = nullptr ;
+  } ;
+
+  thread_local CachedCallTable cachedCallTable ;
+
+} // end anonymous namespace
+
 namespace xdp {
 
   VPStatisticsDatabase::VPStatisticsDatabase(VPDatabase* d) :
-    db(d), numMigrateMemCalls(0), numHostP2PTransfers(0),
+    db(d), id(nextStatisticsId++), numMigrateMemCalls(0), numHostP2PTransfers(0),
     numObjectsReleased(0), contextEnabled(false),
     totalHostReadTime(0), totalHostWriteTime(0), totalBufferStartTime(0),
     totalBufferEndTime(0), firstKernelStartTime(0.0), lastKernelEndTime(0.0)
@@ -205,39 +221,68 @@ namespace xdp {
     }
   }
 
+  VPStatisticsDatabase::ThreadCallTable*
+  VPStatisticsDatabase::getThreadCallTable()
+  {
+    auto& cached = cachedCallTable ;
+    if (cached.id == id)
+      return static_cast<ThreadCallTable*>(cached.table) ;
+
+    std::lock_guard<std::mutex> lock(callTablesLock) ;
+    auto& table = callTables[std::this_thread::get_id()] ;
+    if (!table)
+      table.reset(new ThreadCallTable) ;
+
+    cached.id = id ;
+    cached.table = table.get() ;
+    return table.get() ;
+  }
+
   void VPStatisticsDatabase::logFunctionCallStart(const std::string& name,
                                                   double timestamp)
   {
-    std::lock_guard<std::mutex> lock(dbLock) ;
-
-    auto threadId = std::this_thread::get_id() ;
-    auto key      = std::make_pair(name, threadId) ;
-    auto value    = std::make_pair(timestamp, (double)0.0) ;
-
-    if (callCount.find(key) == callCount.end())
-    {
-      std::vector<std::pair<double, double>> newVector ;
-      newVector.push_back(value) ;
-      callCount[key] = newVector ;
-    }
-    else
+    auto table = getThreadCallTable() ;
     {
-      callCount[key].push_back(value) ;
+      std::lock_guard<std::mutex> lock(table->lock) ;
+      table->calls[name].starts.push_back(timestamp) ;
     }
 
     // OpenCL specific information 
-    if (name == "clEnqueueMigrateMemObjects") addMigrateMemCall() ;
+    if (name == "clEnqueueMigrateMemObjects") {
+      std::lock_guard<std::mutex> lock(dbLock) ;
+      addMigrateMemCall() ;
+    }
   }
 
   void VPStatisticsDatabase::logFunctionCallEnd(const std::string& name,
                                                  double timestamp)
   {
-    std::lock_guard<std::mutex> lock(dbLock) ;
+    auto table = getThreadCallTable() ;
+    std::lock_guard<std::mutex> lock(table->lock) ;
 
-    auto threadId = std::this_thread::get_id() ;
-    auto key      = std::make_pair(name, threadId) ;
-    
-    callCount[key].back().second = timestamp ;
+    auto& entry = table->calls[name] ;
+    if (entry.starts.empty())
+      return ;
+
+    entry.stats.update(timestamp - entry.starts.back()) ;
+    entry.starts.pop_back() ;
+  }
+
+  std::map<std::pair<std::string, std::thread::id>, CallStatistics>
+  VPStatisticsDatabase::getCallStats()
+  {
+    std::map<std::pair<std::string, std::thread::id>, CallStatistics> stats ;
+
+    std::lock_guard<std::mutex> lock(callTablesLock) ;
+    for (auto& table : callTables) {
+      std::lock_guard<std::mutex> tableLock(table.second->lock) ;
+      for (auto& call : table.second->calls) {
+        if (call.second.stats.count == 0)
+          continue ;
+        stats[std::make_pair(call.first, table.first)] = call.second.stats ;
+      }
+    }
+    return stats ;
   }
 
   void VPStatisticsDatabase::logMemoryTransfer(uint64_t deviceId,
@@ -427,16 +472,9 @@ namespace xdp {
     //  the number of calls
     std::map<std::string, uint64_t> counts ;
 
-    for (auto c : callCount)
+    for (auto& c : getCallStats())
     {
-      if (counts.find(c.first.first) == counts.end())
-      {
-        counts[c.first.first] = c.second.size() ;
-      }
-      else
-      {
-        counts[c.first.first] += c.second.size() ;
-      }
+      counts[c.first.first] += c.second.count ;
     }
 
     for (auto i : counts)
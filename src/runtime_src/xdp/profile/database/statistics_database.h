@@ -25,6 +25,9 @@
 #include <fstream>
 #include <tuple>
 #include <list>
+#include <memory>
+#include <cmath>
+#include <limits>
 
 // For the device results structures
 #include "xclperf.h"
@@ -147,6 +150,99 @@ namespace xdp {
     }
   } ;
 
+  // The CallStatistics struct aggregates the durations of all calls
+  //  to one API function in fixed memory.  Besides count, min, max,
+  //  and a running mean and variance (Welford), durations are counted
+  //  in a log scale histogram with 8 buckets per power of two, from
+  //  which percentiles are estimated within about 5%.
+  struct CallStatistics
+  {
+    static constexpr unsigned int subBuckets = 8 ;
+    static constexpr unsigned int numBuckets = 40 * subBuckets ;
+
+    uint64_t count ;
+    double totalTime ;
+    double minTime ;
+    double maxTime ;
+    double mean ;
+    double m2 ; // Sum of squared differences from the mean
+    uint64_t histogram[numBuckets] ;
+
+    CallStatistics() : count(0), totalTime(0), 
+      minTime((std::numeric_limits<double>::max)()), maxTime(0),
+      mean(0), m2(0), histogram{} { }
+
+    static unsigned int bucket(double duration)
+    {
+      if (duration < 1.0) return 0 ;
+      int exponent = 0 ;
+      double fraction = std::frexp(duration, &exponent) ; // [0.5, 1)
+      auto idx = static_cast<unsigned int>(exponent - 1) * subBuckets +
+        static_cast<unsigned int>((fraction * 2 - 1) * subBuckets) ;
+      return (idx < numBuckets) ? idx : numBuckets - 1 ;
+    }
+
+    // Midpoint of the durations counted in a bucket
+    static double bucketValue(unsigned int idx)
+    {
+      double base = std::ldexp(1.0, static_cast<int>(idx / subBuckets)) ;
+      double step = base / subBuckets ;
+      return base + step * (idx % subBuckets) + step / 2 ;
+    }
+
+    void update(double duration)
+    {
+      ++count ;
+      totalTime += duration ;
+      if (duration < minTime) minTime = duration ;
+      if (duration > maxTime) maxTime = duration ;
+      double delta = duration - mean ;
+      mean += delta / count ;
+      m2 += delta * (duration - mean) ;
+      ++histogram[bucket(duration)] ;
+    }
+
+    void merge(const CallStatistics& other)
+    {
+      if (other.count == 0) return ;
+      auto total = count + other.count ;
+      double delta = other.mean - mean ;
+      m2 += other.m2 + delta * delta * count * other.count / total ;
+      mean += delta * other.count / total ;
+      count = total ;
+      totalTime += other.totalTime ;
+      if (other.minTime < minTime) minTime = other.minTime ;
+      if (other.maxTime > maxTime) maxTime = other.maxTime ;
+      for (unsigned int i = 0 ; i < numBuckets ; ++i)
+        histogram[i] += other.histogram[i] ;
+    }
+
+    double variance() const
+    {
+      return (count > 1) ? m2 / (count - 1) : 0 ;
+    }
+
+    // Estimated duration below which the fraction p of calls fall
+    double percentile(double p) const
+    {
+      if (count == 0) return 0 ;
+      auto rank = static_cast<uint64_t>(std::ceil(p * count)) ;
+      if (rank == 0) rank = 1 ;
+      if (rank >= count) return maxTime ; // The slowest call is known
+      uint64_t seen = 0 ;
+      for (unsigned int i = 0 ; i < numBuckets ; ++i) {
+        seen += histogram[i] ;
+        if (seen >= rank) {
+          double value = bucketValue(i) ;
+          if (value < minTime) value = minTime ;
+          if (value > maxTime) value = maxTime ;
+          return value ;
+        }
+      }
+      return maxTime ;
+    }
+  } ;
+
   struct MemoryChannelStatistics
   {
     uint64_t transactionCount ;
@@ -174,9 +270,26 @@ namespace xdp {
     VPDatabase* db ;
 
   private:
-    // Statistics on API calls (OpenCL and HAL) have to be thread specific
-    std::map<std::pair<std::string, std::thread::id>,
-             std::vector<std::pair<double, double>>> callCount ;
+    // Statistics on API calls (OpenCL and HAL) have to be thread specific.
+    //  Every thread logs into its own table so application threads
+    //  do not contend on a lock.  Only the start timestamps of calls
+    //  that have not yet ended are stored, completed calls are
+    //  aggregated.
+    struct CallEntry
+    {
+      CallStatistics stats ;
+      std::vector<double> starts ; // Nested or recursive calls
+    } ;
+    struct ThreadCallTable
+    {
+      std::mutex lock ;
+      std::map<std::string, CallEntry> calls ;
+    } ;
+    uint64_t id ; // Unique id for lookup of the thread's table
+    std::map<std::thread::id, std::unique_ptr<ThreadCallTable>> callTables ;
+    std::mutex callTablesLock ;
+
+    ThreadCallTable* getThreadCallTable() ;
 
     // **** User Level Event Statistics ****
     std::map<std::string, uint64_t> eventCounts ;
@@ -252,9 +365,9 @@ namespace xdp {
     XDP_EXPORT ~VPStatisticsDatabase() ;
 
     // Getters and setters
-    inline const std::map<std::pair<std::string, std::thread::id>,
-                    std::vector<std::pair<double, double>>>& getCallCount() 
-      { return callCount ; }
+    // Snapshot of the API call statistics of every function and thread
+    XDP_EXPORT std::map<std::pair<std::string, std::thread::id>, CallStatistics>
+    getCallStats() ;
     inline const std::map<uint64_t, DeviceMemoryStatistics>& getMemoryStats() 
       { return memoryStats ; }
     inline const std::map<std::string, TimeStatistics>& getKernelExecutionStats() 
@@ -48,6 +48,7 @@ DeviceTraceOffload::~DeviceTraceOffload()
   if (offload_thread.joinable()) {
     offload_thread.join();
   }
+  stop_pipeline();
 }
 
 void DeviceTraceOffload::offload_device_continuous()
@@ -57,6 +58,9 @@ void DeviceTraceOffload::offload_device_continuous()
     return;
   }
 
+  if (has_ts2mm())
+    start_pipeline();
+
   while (should_continue()) {
     train_clock();
     m_read_trace(false);
@@ -69,6 +73,42 @@ void DeviceTraceOffload::offload_device_continuous()
   offload_finished();
 }
 
+void DeviceTraceOffload::start_pipeline()
+{
+  if (m_pipeline)
+    return;
+
+  // Decoding and logging run on their own threads so the next chunk
+  //  of the trace buffer can be synced while the previous one is
+  //  processed.  The stages still run in order on one chunk at a time,
+  //  so decoder and logger state carry over between chunks as before.
+  m_pipeline.reset(new TraceOffloadPipeline(
+    [this] (void* buf, uint64_t bytes, std::vector<xclTraceResults>& results) {
+      dev_intf->parseTraceData(buf, bytes, results);
+    },
+    [this] (std::vector<xclTraceResults>& results) {
+      deviceTraceLogger->processTraceData(results);
+    }));
+}
+
+void DeviceTraceOffload::stop_pipeline()
+{
+  if (!m_pipeline)
+    return;
+
+  m_pipeline->stop();
+  auto stats = m_pipeline->getStatistics();
+  debug_stream
+    << "Trace offload pipeline processed " << stats.buffers << " buffers, "
+    << stats.bytes << " bytes. Sync waited on decode " << stats.pushStalls
+    << " times for "
+    << std::chrono::duration_cast<std::chrono::microseconds>(stats.pushStallTime).count()
+    << " µs, decode waited on logging " << stats.decodeStalls << " times for "
+    << std::chrono::duration_cast<std::chrono::microseconds>(stats.decodeStallTime).count()
+    << " µs" << std::endl;
+  m_pipeline.reset();
+}
+
 void DeviceTraceOffload::train_clock_continuous()
 {
   while (should_continue()) {
@@ -194,6 +234,10 @@ void DeviceTraceOffload::read_trace_end()
     m_read_trace(true);
   }
 
+  // All trace must be logged before the logger and the data mover
+  //  are reset
+  stop_pipeline();
+
   // Trace logger will clear it's state and add approximations 
   // for pending events
   m_trace_vector.clear();
@@ -243,9 +287,13 @@ void DeviceTraceOffload::read_trace_s2mm(bool force)
     m_trace_warn_big_done = true;
   }
 
-  dev_intf->parseTraceData(host_buf, nBytes, m_trace_vector);
-  deviceTraceLogger->processTraceData(m_trace_vector);
-  m_trace_vector.clear();
+  if (m_pipeline) {
+    m_pipeline->push(host_buf, nBytes);
+  } else {
+    dev_intf->parseTraceData(host_buf, nBytes, m_trace_vector);
+    deviceTraceLogger->processTraceData(m_trace_vector);
+    m_trace_vector.clear();
+  }
 
   if (m_trbuf_sz == m_trbuf_alloc_sz && m_use_circ_buf == false)
     m_trbuf_full = true;
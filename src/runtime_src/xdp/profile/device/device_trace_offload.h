@@ -23,12 +23,14 @@
 #include <thread>
 #include <chrono>
 #include <functional>
+#include <memory>
 
 #include "xdp/config.h"
 #include "core/include/xclperf.h"
 #include "xdp/profile/device/device_intf.h"
 #include "xdp/profile/device/tracedefs.h"
 #include "xdp/profile/device/device_trace_logger.h"
+#include "xdp/profile/device/trace_offload_pipeline.h"
 
 namespace xdp {
 
@@ -122,6 +124,9 @@ private:
     bool trbuf_offload_done = false;
     uint64_t m_trbuf_addr = 0;
 
+    // Decodes and logs trace on worker threads during continuous offload
+    std::unique_ptr<TraceOffloadPipeline> m_pipeline;
+
 protected:
     bool m_initialized = false;
     // Default dma chunk size
@@ -139,6 +144,8 @@ private:
     void train_clock_continuous();
     void offload_device_continuous();
     void offload_finished();
+    void start_pipeline();
+    void stop_pipeline();
 
     // Clock Training Params
     bool m_force_clk_train = true;
@@ -213,16 +213,37 @@ uint64_t TraceS2MM::seekClockTraining(uint64_t* arr, uint64_t count)
   if (count < n)
     return count;
 
-  count -= n;
-  for (uint64_t i=0; i <= count; i++) {
-    for (uint64_t j=i; j < i + n; j++) {
-      if (!((arr[j] >> 63) & 0x1))
-        break;
-      if (j == i+n-1)
-        return i;
-    }
+  // Single pass over the buffer counting the current run of
+  //  packets with the clock training bit set
+  uint64_t run = 0;
+  for (uint64_t i=0; i < count; i++) {
+    run = ((arr[i] >> 63) & 0x1) ? run + 1 : 0;
+    if (run == n)
+      return i + 1 - n;
+  }
+  return count - n;
+}
+
+void TraceS2MM::decodePackets(const uint64_t* packets, uint64_t count,
+                              uint64_t firstTimestamp, xclTraceResults* results)
+{
+  // Same decoding as parsePacket, without debug output, so the
+  //  compiler can keep the loop free of branches
+  for (uint64_t i=0; i < count; i++) {
+    auto packet = packets[i];
+    auto flags = static_cast<unsigned char>((packet >> 45) & 0xF);
+
+    xclTraceResults result = {};
+    result.Timestamp = (packet & 0x1FFFFFFFFFFF) - firstTimestamp;
+    result.EventType = flags ? XCL_PERF_MON_END_EVENT : XCL_PERF_MON_START_EVENT;
+    result.TraceID = (packet >> 49) & 0xFFF;
+    result.Reserved = (packet >> 61) & 0x1;
+    result.Overflow = (packet >> 62) & 0x1;
+    result.EventID = XCL_PERF_MON_HW_EVENT;
+    result.EventFlags = flags | ((packet >> 57) & 0x10);
+    result.isClockTrain = 0;
+    results[i] = result;
   }
-  return count;
 }
 
 void TraceS2MM::parseTraceBuf(void* buf, uint64_t size, std::vector<xclTraceResults>& traceVector)
@@ -247,39 +268,64 @@ void TraceS2MM::parseTraceBuf(void* buf, uint64_t size, std::vector<xclTraceResu
     if (idx == count)
       return;
 
-    for (auto i = idx; i < count; i++) {
-      auto currentPacket = pos[i];
-      if (!currentPacket)
-        break;
-      // Poor man's reset
-      if (i == 0 && !mPacketFirstTs)
-        mPacketFirstTs = currentPacket & 0x1FFFFFFFFFFF;
+    // Valid data ends at the first empty packet
+    uint64_t end = idx;
+    while (end < count && pos[end])
+      end++;
+    if (end == idx) {
+      mclockTrainingdone = true;
+      return;
+    }
+
+    // Poor man's reset
+    if (idx == 0 && !mPacketFirstTs)
+      mPacketFirstTs = pos[0] & 0x1FFFFFFFFFFF;
 
-      bool isClockTrain = false;
+    // Every packet produces at most one result, so the results are
+    //  written in place and the vector is trimmed at the end
+    traceVector.resize(end - idx);
+    auto results = traceVector.data();
+    uint64_t numResults = 0;
+
+    uint64_t i = idx;
+    while (i < end) {
+      // Find the run of regular packets starting at i
+      uint64_t runEnd = i;
       if (mTraceFormat == 1) {
-        isClockTrain = ((currentPacket >> 63) & 0x1);
-      } else {
-        isClockTrain = (i < 8 && !mclockTrainingdone);
+        while (runEnd < end && !((pos[runEnd] >> 63) & 0x1))
+          runEnd++;
+      } else if (i >= 8 || mclockTrainingdone) {
+        runEnd = end;
       }
 
-      if (isClockTrain) {
-        parsePacketClockTrain(currentPacket);
-        if (mModulus == 3) {
-          mModulus = 0 ;
-          traceVector.push_back(partialResult) ;
-          partialResult = {} ;
+      if (runEnd > i) {
+        if (out_stream) {
+          for (auto j = i; j < runEnd; j++) {
+            xclTraceResults result = {};
+            parsePacket(pos[j], mPacketFirstTs, result);
+            results[numResults++] = result;
+          }
+        } else {
+          decodePackets(pos + i, runEnd - i, mPacketFirstTs, results + numResults);
+          numResults += runEnd - i;
         }
-        else {
-          mModulus = mModulus + 1 ;
-	}
+        i = runEnd;
+        continue;
+      }
+
+      parsePacketClockTrain(pos[i]);
+      if (mModulus == 3) {
+        mModulus = 0 ;
+        results[numResults++] = partialResult ;
+        partialResult = {} ;
       }
       else {
-        xclTraceResults result = {};
-        parsePacket(currentPacket, mPacketFirstTs, result);
-        traceVector.push_back(result);
+        mModulus = mModulus + 1 ;
       }
+      i++;
+    }
 
-    } // For i < count
+    traceVector.resize(numResults);
     mclockTrainingdone = true;
 }
 
@@ -88,6 +88,8 @@ protected:
     void parsePacketClockTrain(uint64_t packet);
     void parsePacket(uint64_t packet, uint64_t firstTimestamp, xclTraceResults &result);
     uint64_t seekClockTraining(uint64_t* arr, uint64_t count);
+    void decodePackets(const uint64_t* packets, uint64_t count,
+                       uint64_t firstTimestamp, xclTraceResults* results);
 
 protected:
     uint64_t mPacketFirstTs = 0;
@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#define XDP_SOURCE
+
+#include <cstring>
+
+#include "xdp/profile/device/trace_offload_pipeline.h"
+
+namespace xdp {
+
+TraceOffloadPipeline::TraceOffloadPipeline(decode_function decode,
+                                           log_function log,
+                                           size_t depth)
+                     : decode_stage(std::move(decode)),
+                       log_stage(std::move(log))
+{
+  if (depth == 0)
+    depth = 1;
+  for (size_t i = 0; i < depth; ++i) {
+    free_chunks.emplace_back(new Chunk);
+    free_results.emplace_back(new std::vector<xclTraceResults>);
+  }
+
+  decode_thread = std::thread(&TraceOffloadPipeline::decode_loop, this);
+  log_thread = std::thread(&TraceOffloadPipeline::log_loop, this);
+}
+
+TraceOffloadPipeline::~TraceOffloadPipeline()
+{
+  stop();
+}
+
+void TraceOffloadPipeline::push(const void* data, uint64_t bytes)
+{
+  ChunkPtr chunk;
+  {
+    std::unique_lock<std::mutex> lk(lock);
+    if (free_chunks.empty()) {
+      auto start = std::chrono::steady_clock::now();
+      chunk_freed.wait(lk, [this] { return !free_chunks.empty(); });
+      stats.pushStalls++;
+      stats.pushStallTime += std::chrono::steady_clock::now() - start;
+    }
+    chunk = std::move(free_chunks.front());
+    free_chunks.pop_front();
+  }
+
+  // The device can overwrite the trace buffer once it has been read,
+  //  so decoding works on a copy
+  if (chunk->data.size() < bytes)
+    chunk->data.resize(bytes);
+  std::memcpy(chunk->data.data(), data, bytes);
+  chunk->bytes = bytes;
+
+  {
+    std::lock_guard<std::mutex> lk(lock);
+    decode_queue.push_back(std::move(chunk));
+    pushed++;
+    stats.buffers++;
+    stats.bytes += bytes;
+  }
+  chunk_ready.notify_one();
+}
+
+void TraceOffloadPipeline::flush()
+{
+  std::unique_lock<std::mutex> lk(lock);
+  results_logged.wait(lk, [this] { return logged == pushed; });
+}
+
+void TraceOffloadPipeline::stop()
+{
+  {
+    std::lock_guard<std::mutex> lk(lock);
+    if (stopping)
+      return;
+    stopping = true;
+  }
+  chunk_ready.notify_all();
+  results_ready.notify_all();
+
+  // Workers drain their queues before they exit
+  if (decode_thread.joinable())
+    decode_thread.join();
+  if (log_thread.joinable())
+    log_thread.join();
+}
+
+TraceOffloadPipeline::Statistics TraceOffloadPipeline::getStatistics()
+{
+  std::lock_guard<std::mutex> lk(lock);
+  return stats;
+}
+
+void TraceOffloadPipeline::decode_loop()
+{
+  while (true) {
+    ChunkPtr chunk;
+    ResultsPtr results;
+    {
+      std::unique_lock<std::mutex> lk(lock);
+      chunk_ready.wait(lk, [this] { return !decode_queue.empty() || stopping; });
+      if (decode_queue.empty())
+        break;
+      chunk = std::move(decode_queue.front());
+      decode_queue.pop_front();
+
+      if (free_results.empty()) {
+        auto start = std::chrono::steady_clock::now();
+        results_freed.wait(lk, [this] { return !free_results.empty(); });
+        stats.decodeStalls++;
+        stats.decodeStallTime += std::chrono::steady_clock::now() - start;
+      }
+      results = std::move(free_results.front());
+      free_results.pop_front();
+    }
+
+    decode_stage(chunk->data.data(), chunk->bytes, *results);
+
+    {
+      std::lock_guard<std::mutex> lk(lock);
+      free_chunks.push_back(std::move(chunk));
+      log_queue.push_back(std::move(results));
+    }
+    chunk_freed.notify_one();
+    results_ready.notify_one();
+  }
+
+  // Let the log thread finish once everything decoded has been queued
+  {
+    std::lock_guard<std::mutex> lk(lock);
+    log_queue.push_back(nullptr);
+  }
+  results_ready.notify_one();
+}
+
+void TraceOffloadPipeline::log_loop()
+{
+  while (true) {
+    ResultsPtr results;
+    {
+      std::unique_lock<std::mutex> lk(lock);
+      results_ready.wait(lk, [this] { return !log_queue.empty(); });
+      results = std::move(log_queue.front());
+      log_queue.pop_front();
+    }
+
+    // End of the decoded data
+    if (!results)
+      break;
+
+    log_stage(*results);
+    results->clear();
+
+    {
+      std::lock_guard<std::mutex> lk(lock);
+      free_results.push_back(std::move(results));
+      logged++;
+    }
+    results_freed.notify_one();
+    results_logged.notify_all();
+  }
+}
+
+}
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#ifndef XDP_PROFILE_DEVICE_TRACE_OFFLOAD_PIPELINE_H_
+#define XDP_PROFILE_DEVICE_TRACE_OFFLOAD_PIPELINE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "xdp/config.h"
+#include "core/include/xclperf.h"
+
+namespace xdp {
+
+/**
+ * TraceOffloadPipeline overlaps the stages of PL trace offload.
+ *
+ * The offload thread syncs a chunk of the trace buffer and pushes it
+ * into the pipeline, a decode thread turns the raw packets into
+ * xclTraceResults and a log thread hands the results to the trace
+ * logger.  Stages are connected by bounded queues: a fixed number of
+ * staging buffers and result vectors circulate between the threads,
+ * so the offload thread can sync the next chunk while the previous
+ * one is decoded, and blocks when decoding falls behind.
+ *
+ * Buffers are decoded and logged in the order they are pushed.
+ */
+class TraceOffloadPipeline {
+public:
+    using decode_function =
+      std::function<void(void*, uint64_t, std::vector<xclTraceResults>&)>;
+    using log_function = std::function<void(std::vector<xclTraceResults>&)>;
+
+    struct Statistics {
+      uint64_t buffers = 0;
+      uint64_t bytes = 0;
+      // Number of times and total time a stage waited on the next stage
+      uint64_t pushStalls = 0;
+      uint64_t decodeStalls = 0;
+      std::chrono::nanoseconds pushStallTime {0};
+      std::chrono::nanoseconds decodeStallTime {0};
+    };
+
+    XDP_EXPORT
+    TraceOffloadPipeline(decode_function decode, log_function log,
+                         size_t depth = 2);
+    XDP_EXPORT
+    ~TraceOffloadPipeline();
+
+    // Copy the data into a staging buffer and queue it for decoding.
+    //  Blocks while all staging buffers are in use.
+    XDP_EXPORT
+    void push(const void* data, uint64_t bytes);
+    // Wait until all pushed data has been logged
+    XDP_EXPORT
+    void flush();
+    // Flush and stop the worker threads
+    XDP_EXPORT
+    void stop();
+    XDP_EXPORT
+    Statistics getStatistics();
+
+private:
+    struct Chunk {
+      std::vector<char> data;
+      uint64_t bytes = 0;
+    };
+    using ChunkPtr = std::unique_ptr<Chunk>;
+    using ResultsPtr = std::unique_ptr<std::vector<xclTraceResults>>;
+
+    void decode_loop();
+    void log_loop();
+
+    decode_function decode_stage;
+    log_function log_stage;
+
+    std::mutex lock;
+    std::condition_variable chunk_freed;
+    std::condition_variable chunk_ready;
+    std::condition_variable results_freed;
+    std::condition_variable results_ready;
+    std::condition_variable results_logged;
+
+    std::deque<ChunkPtr> free_chunks;
+    std::deque<ChunkPtr> decode_queue;
+    std::deque<ResultsPtr> free_results;
+    std::deque<ResultsPtr> log_queue;
+
+    uint64_t pushed = 0;
+    uint64_t logged = 0;
+    bool stopping = false;
+    Statistics stats;
+
+    std::thread decode_thread;
+    std::thread log_thread;
+};
+
+}
+
+#endif
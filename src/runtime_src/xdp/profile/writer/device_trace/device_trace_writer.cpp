@@ -47,11 +47,11 @@ namespace xdp {
     } else if(xdp::getFlowMode() == xdp::HW_EMU) {
       targetRun = "Hardware Emulation";
     }
-    fout << "TraceID," << traceID << std::endl
-         << "XRT  Version," << xrtVersion  << std::endl
-         << "Tool Version," << toolVersion << std::endl
-         << "Platform," << (db->getStaticInfo()).getDeviceName(deviceId) << std::endl
-         << "Target," << targetRun << std::endl;
+    fout << "TraceID," << traceID << "\n"
+         << "XRT  Version," << xrtVersion  << "\n"
+         << "Tool Version," << toolVersion << "\n"
+         << "Platform," << (db->getStaticInfo()).getDeviceName(deviceId) << "\n"
+         << "Target," << targetRun << "\n";
   }
 
   // This function writes the portion of the structure that is true for
@@ -62,13 +62,13 @@ namespace xdp {
     uint64_t numKDMA = (db->getStaticInfo()).getKDMACount(deviceId) ;
     if(numKDMA) {
 #if 0
-      fout << "Group_Start,KDMA" << std::endl ;
+      fout << "Group_Start,KDMA" << "\n" ;
       for (unsigned int i = 0 ; i < numKDMA ; ++i)
       {
-              fout << "Dynamic_Row," << ++rowCount << ",Read, ,KERNEL_READ" << std::endl;
-              fout << "Dynamic_Row," << ++rowCount << ",Write, ,KERNEL_WRITE" << std::endl;
+              fout << "Dynamic_Row," << ++rowCount << ",Read, ,KERNEL_READ" << "\n";
+              fout << "Dynamic_Row," << ++rowCount << ",Write, ,KERNEL_WRITE" << "\n";
       }
-      fout << "Group_End,KDMA" << std::endl ;
+      fout << "Group_End,KDMA" << "\n" ;
 #endif
     }
   }
@@ -80,9 +80,9 @@ namespace xdp {
       (db->getStaticInfo()).getLoadedXclbins(deviceId) ;
 
     for (auto xclbin : xclbins) {
-      fout << "Group_Start," << xclbin->name << std::endl ;
+      fout << "Group_Start," << xclbin->name << "\n" ;
       writeSingleXclbinStructure(xclbin, rowCount) ;
-      fout << "Group_End," << xclbin->name << std::endl ;
+      fout << "Group_End," << xclbin->name << "\n" ;
     }
   }
 
@@ -94,13 +94,13 @@ namespace xdp {
       ComputeUnitInstance* cu = iter.second ;
       fout << "Group_Start,Compute Unit " << cu->getName() 
            << ",Activity in accelerator "<< cu->getKernelName() 
-           << ":" << cu->getName() << std::endl ;
+           << ":" << cu->getName() << "\n" ;
 
       writeCUExecutionStructure(xclbin, cu, rowCount) ;
       writeCUMemoryTransfersStructure(xclbin, cu, rowCount) ;
       writeCUStreamTransfersStructure(xclbin, cu, rowCount) ;
 
-      fout << "Group_End," << cu->getName() << std::endl ;
+      fout << "Group_End," << cu->getName() << "\n" ;
     }
     // Create structure for all floating monitors not attached to a CU
     writeFloatingMemoryTransfersStructure(xclbin, rowCount) ;
@@ -113,7 +113,7 @@ namespace xdp {
   {
     fout << "Dynamic_Row_Summary," << ++rowCount
          << ",Executions,Execution in accelerator " 
-         << cu->getName() << std::endl;
+         << cu->getName() << "\n";
 
     if(xdp::getFlowMode() == xdp::HW_EMU) {
       size_t pos = xclbin->name.find(".xclbin");
@@ -122,7 +122,7 @@ namespace xdp {
            << "," << (db->getStaticInfo()).getDeviceName(deviceId) << "-0"
            << "," << xclbin->name.substr(0, pos)
            << "," << cu->getKernelName()
-           << "," << cu->getName() << std::endl;
+           << "," << cu->getName() << "\n";
     }
 
     std::pair<XclbinInfo*, int32_t> index =
@@ -131,11 +131,11 @@ namespace xdp {
 
     // Generate wave group for Kernel Stall if Stall monitoring is enabled in CU
     if (cu->stallEnabled()) {
-      fout << "Group_Summary_Start,Stall,Stalls in accelerator " << cu->getName() << std::endl;
-      fout << "Static_Row," << (rowCount + KERNEL_STALL_EXT_MEM - KERNEL)  << ",External Memory Stall, Stalls from accessing external memory" << std::endl;
-      fout << "Static_Row," << (rowCount + KERNEL_STALL_DATAFLOW - KERNEL) << ",Intra-Kernel Dataflow Stall,Stalls from dataflow streams inside compute unit" << std::endl;
-      fout << "Static_Row," << (rowCount + KERNEL_STALL_PIPE - KERNEL) << ",Inter-Kernel Pipe Stall,Stalls from accessing pipes between kernels" << std::endl;
-      fout << "Group_End,Stall" << std::endl;
+      fout << "Group_Summary_Start,Stall,Stalls in accelerator " << cu->getName() << "\n";
+      fout << "Static_Row," << (rowCount + KERNEL_STALL_EXT_MEM - KERNEL)  << ",External Memory Stall, Stalls from accessing external memory" << "\n";
+      fout << "Static_Row," << (rowCount + KERNEL_STALL_DATAFLOW - KERNEL) << ",Intra-Kernel Dataflow Stall,Stalls from dataflow streams inside compute unit" << "\n";
+      fout << "Static_Row," << (rowCount + KERNEL_STALL_PIPE - KERNEL) << ",Inter-Kernel Pipe Stall,Stalls from accessing pipes between kernels" << "\n";
+      fout << "Group_End,Stall" << "\n";
 
       rowCount += (KERNEL_STALL_PIPE - KERNEL);
     }
@@ -161,10 +161,10 @@ namespace xdp {
       }
 
       // Data Transfers
-      fout << "Group_Start," << portAndArgs << ",Data Transfers between " << cu->getName() << " and Global Memory over read and write channels of " << aim->name << std::endl;
-      fout << "Static_Row," << rowCount   << ",Read Channel,Read Data Transfers " << std::endl;
-      fout << "Static_Row," << ++rowCount << ",Write Channel,Write Data Transfers " << std::endl;
-      fout << "Group_End," << portAndArgs << std::endl;
+      fout << "Group_Start," << portAndArgs << ",Data Transfers between " << cu->getName() << " and Global Memory over read and write channels of " << aim->name << "\n";
+      fout << "Static_Row," << rowCount   << ",Read Channel,Read Data Transfers " << "\n";
+      fout << "Static_Row," << ++rowCount << ",Write Channel,Write Data Transfers " << "\n";
+      fout << "Group_End," << portAndArgs << "\n";
     }
   }
 
@@ -182,18 +182,18 @@ namespace xdp {
       asmBucketIdMap[index] = ++rowCount ;
 
       // KERNEL_STREAM_READ/WRITE
-      fout << "Group_Start," << ASM->name << ",AXI Stream transaction over " << ASM->name << std::endl;
-      fout << "Static_Row," << rowCount << ",Stream Activity,AXI Stream transactions over " << ASM->name << std::endl;
-      fout << "Static_Row," << ++rowCount << ",Link Stall" << std::endl;
-      fout << "Static_Row," << ++rowCount << ",Link Starve" << std::endl;
-      fout << "Group_End," << ASM->name << std::endl;
+      fout << "Group_Start," << ASM->name << ",AXI Stream transaction over " << ASM->name << "\n";
+      fout << "Static_Row," << rowCount << ",Stream Activity,AXI Stream transactions over " << ASM->name << "\n";
+      fout << "Static_Row," << ++rowCount << ",Link Stall" << "\n";
+      fout << "Static_Row," << ++rowCount << ",Link Starve" << "\n";
+      fout << "Group_End," << ASM->name << "\n";
     }
   }
 
   void DeviceTraceWriter::writeFloatingMemoryTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount)
   {
     if (!(db->getStaticInfo().hasFloatingAIM(deviceId, xclbin))) return ;
-    fout << "Group_Start,AXI Memory Monitors,Read/Write data transfers over AXI Memory Mapped connection " << std::endl;
+    fout << "Group_Start,AXI Memory Monitors,Read/Write data transfers over AXI Memory Mapped connection " << "\n";
 
     // Go through all of the AIMs in this xclbin to find the floating ones
     std::map<uint64_t, Monitor*> *aimMap =
@@ -218,19 +218,19 @@ namespace xdp {
       if(!aim->args.empty()) {
         portAndArgs += " (" + aim->args + ")";
       }
-      fout << "Group_Start," << portAndArgs << ",Data Transfers over read and write channels of AXI Memory Mapped " << aim->name << std::endl;
-      fout << "Static_Row,"  << rowCount   << ",Read Channel,Read Data Transfers " << std::endl;
-      fout << "Static_Row,"  << ++rowCount << ",Write Channel,Write Data Transfers " << std::endl;
-      fout << "Group_End,"   << portAndArgs << std::endl ;
+      fout << "Group_Start," << portAndArgs << ",Data Transfers over read and write channels of AXI Memory Mapped " << aim->name << "\n";
+      fout << "Static_Row,"  << rowCount   << ",Read Channel,Read Data Transfers " << "\n";
+      fout << "Static_Row,"  << ++rowCount << ",Write Channel,Write Data Transfers " << "\n";
+      fout << "Group_End,"   << portAndArgs << "\n" ;
       i++;
     }
-    fout << "Group_End,AXI Memory Monitors" << std::endl ;
+    fout << "Group_End,AXI Memory Monitors" << "\n" ;
   }
 
   void DeviceTraceWriter::writeFloatingStreamTransfersStructure(XclbinInfo* xclbin, uint32_t& rowCount)
   {
     if (!(db->getStaticInfo()).hasFloatingASM(deviceId, xclbin)) return ;
-    fout << "Group_Start,AXI Stream Monitors,Data transfers over AXI Stream connection " << std::endl;
+    fout << "Group_Start,AXI Stream Monitors,Data transfers over AXI Stream connection " << "\n";
 
     std::map<uint64_t, Monitor*> *asmMap =
       (db->getStaticInfo()).getASMonitors(deviceId, xclbin);
@@ -248,40 +248,40 @@ namespace xdp {
 
       std::pair<XclbinInfo*, uint32_t> index = std::make_pair(xclbin, static_cast<uint32_t>(i)) ;
       asmBucketIdMap[index] = ++rowCount;
-      fout << "Group_Start," << asM->name << ",AXI Stream transactions over " << asM->name << std::endl;
-      fout << "Static_Row," << rowCount << ",Stream Activity,AXI Stream transactions over " << asM->name << std::endl;
-      fout << "Static_Row," << ++rowCount << ",Link Stall" << std::endl;
-      fout << "Static_Row," << ++rowCount << ",Link Starve" << std::endl;
-      fout << "Group_End," << asM->name << std::endl;
+      fout << "Group_Start," << asM->name << ",AXI Stream transactions over " << asM->name << "\n";
+      fout << "Static_Row," << rowCount << ",Stream Activity,AXI Stream transactions over " << asM->name << "\n";
+      fout << "Static_Row," << ++rowCount << ",Link Stall" << "\n";
+      fout << "Static_Row," << ++rowCount << ",Link Starve" << "\n";
+      fout << "Group_End," << asM->name << "\n";
       i++;
     }
-    fout << "Group_End,AXI Stream Monitors" << std::endl ;
+    fout << "Group_End,AXI Stream Monitors" << "\n" ;
   }
 
   void DeviceTraceWriter::writeStructure()
   {
-    fout << "STRUCTURE" << std::endl ;
+    fout << "STRUCTURE" << "\n" ;
     
     // Use the database's "static" information to discover how many
     //  kernels, compute units, etc. this device has.  Then, use that
     //  to build up the structure of the file we are generating
     
     std::string deviceName = (db->getStaticInfo()).getDeviceName(deviceId) ;
-    fout << "Group_Start," << deviceName << std::endl ;
+    fout << "Group_Start," << deviceName << "\n" ;
     writeDeviceStructure() ;
     writeLoadedXclbinsStructure() ;
-    fout << "Group_End," << deviceName << std::endl ;
+    fout << "Group_End," << deviceName << "\n" ;
   }
 
   void DeviceTraceWriter::writeStringTable()
   {
-    fout << "MAPPING" << std::endl ;
+    fout << "MAPPING" << "\n" ;
     (db->getDynamicInfo()).dumpStringTable(fout) ;
   }
 
   void DeviceTraceWriter::writeTraceEvents()
   {
-    fout << "EVENTS" << std::endl;
+    fout << "EVENTS" << "\n";
     auto DeviceEvents = (db->getDynamicInfo()).getEraseDeviceEvents(deviceId);
 
     std::vector<XclbinInfo*> loadedXclbins =
@@ -316,7 +316,7 @@ namespace xdp {
             fout << "," << db->getDynamicInfo().addString(cu->getName());
           }
         }
-        fout << std::endl ;
+        fout << "\n" ;
       } else if(KERNEL_STALL_EXT_MEM == eventType
                 || KERNEL_STALL_DATAFLOW == eventType
                 || KERNEL_STALL_PIPE == eventType) {
@@ -351,7 +351,7 @@ namespace xdp {
 
   void DeviceTraceWriter::writeDependencies()
   {
-    fout << "DEPENDENCIES" << std::endl ;
+    fout << "DEPENDENCIES" << "\n" ;
     // No dependencies in device events
   }
 
@@ -369,15 +369,15 @@ namespace xdp {
     initialize() ;
 
     writeHeader() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeStructure() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeStringTable() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeTraceEvents() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeDependencies() ;
-    fout << std::endl ;
+    fout << "\n" ;
 
     if (openNewFile) switchFiles() ;
     return true;
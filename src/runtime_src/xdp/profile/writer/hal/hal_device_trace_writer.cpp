@@ -47,17 +47,17 @@ namespace xdp {
   void HALDeviceTraceWriter::writeHeader()
   {
     VPTraceWriter::writeHeader() ;
-    fout << "TraceID," << traceID << std::endl
-         << "XRT  Version," << xrtVersion  << std::endl
-         << "Tool Version," << toolVersion << std::endl
-         << "Platform," << (db->getStaticInfo()).getDeviceName(deviceId) << std::endl
-         << "Target,System Run" << std::endl;    // hardcoded for now
+    fout << "TraceID," << traceID << "\n"
+         << "XRT  Version," << xrtVersion  << "\n"
+         << "Tool Version," << toolVersion << "\n"
+         << "Platform," << (db->getStaticInfo()).getDeviceName(deviceId) << "\n"
+         << "Target,System Run" << "\n";    // hardcoded for now
   }
 
   void HALDeviceTraceWriter::writeStructure()
   {
     uint32_t rowCount = 0;
-    fout << "STRUCTURE" << std::endl ;
+    fout << "STRUCTURE" << "\n" ;
     
     // Use the database's "static" information to discover how many
     //  kernels, compute units, etc. this device has.  Then, use that
@@ -67,19 +67,19 @@ namespace xdp {
     std::string xclbinName = (db->getStaticInfo()).getXclbinName(deviceId) ;
 //    std::string xclbinName = "xclbin";
     
-    fout << "Group_Start," << deviceName << std::endl ;
-    fout << "Group_Start," << xclbinName << std::endl ;
+    fout << "Group_Start," << deviceName << "\n" ;
+    fout << "Group_Start," << xclbinName << "\n" ;
 
     uint64_t numKDMA = (db->getStaticInfo()).getKDMACount(deviceId) ;
     if(numKDMA) {
 #if 0
-      fout << "Group_Start,KDMA" << std::endl ;
+      fout << "Group_Start,KDMA" << "\n" ;
       for (unsigned int i = 0 ; i < numKDMA ; ++i)
       {
-	      fout << "Dynamic_Row," << ++rowCount << ",Read, ,KERNEL_READ" << std::endl;
-	      fout << "Dynamic_Row," << ++rowCount << ",Write, ,KERNEL_WRITE" << std::endl;
+	      fout << "Dynamic_Row," << ++rowCount << ",Read, ,KERNEL_READ" << "\n";
+	      fout << "Dynamic_Row," << ++rowCount << ",Write, ,KERNEL_WRITE" << "\n";
       }
-      fout << "Group_End,KDMA" << std::endl ;
+      fout << "Group_End,KDMA" << "\n" ;
 #endif
     }
 
@@ -90,56 +90,56 @@ namespace xdp {
         std::string cuName = cu->getName();
 
         // Wave Group for CU
-        fout << "Group_Start,Compute Unit " << cuName << ",Activity in accelerator "<< cu->getKernelName() << ":" << cuName << std::endl ;
-        fout << "Dynamic_Row_Summary," << ++rowCount << ",Executions,Execution in accelerator " << cuName << std::endl;
+        fout << "Group_Start,Compute Unit " << cuName << ",Activity in accelerator "<< cu->getKernelName() << ":" << cuName << "\n" ;
+        fout << "Dynamic_Row_Summary," << ++rowCount << ",Executions,Execution in accelerator " << cuName << "\n";
         cuBucketIdMap[cu->getIndex()] = rowCount;
 
         // Wave Group for Kernel Stall, if Stall monitoring is enabled in CU
         if(cu->stallEnabled()) {
           // KERNEL_STALL : stall type
-          fout << "Group_Summary_Start,Stall,Stalls in accelerator " << cuName << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STALL_EXT_MEM - KERNEL)  << ",External Memory Stall, Stalls from accessing external memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STALL_DATAFLOW - KERNEL) << ",Intra-Kernel Dataflow Stall,Stalls from dataflow streams inside compute unit" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STALL_PIPE - KERNEL) << ",Inter-Kernel Pipe Stall,Stalls from accessing pipes between kernels" << std::endl;
-          fout << "Group_End,Stall" << std::endl;
+          fout << "Group_Summary_Start,Stall,Stalls in accelerator " << cuName << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STALL_EXT_MEM - KERNEL)  << ",External Memory Stall, Stalls from accessing external memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STALL_DATAFLOW - KERNEL) << ",Intra-Kernel Dataflow Stall,Stalls from dataflow streams inside compute unit" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STALL_PIPE - KERNEL) << ",Inter-Kernel Pipe Stall,Stalls from accessing pipes between kernels" << "\n";
+          fout << "Group_End,Stall" << "\n";
         }
 
         // Wave Group for Read and Write, if Data transfer monitoring is enabled in CU
         if(cu->dataTransferEnabled()) {
           // Read : KERNEL_READ
-          fout << "Group_Start,Read,Read data transfers between " << cuName << " and Global Memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_READ - KERNEL) << ",M_AXI_GMEM-MEMORY (port_names)," << "Read Data Transfers " << std::endl;
-          fout << "Group_End,Read" << std::endl;
+          fout << "Group_Start,Read,Read data transfers between " << cuName << " and Global Memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_READ - KERNEL) << ",M_AXI_GMEM-MEMORY (port_names)," << "Read Data Transfers " << "\n";
+          fout << "Group_End,Read" << "\n";
 
           // Write : KERNEL_WRITE
-          fout << "Group_Start,Write,Write data transfers between " << cuName << " and Global Memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_WRITE - KERNEL) << ",M_AXI_GMEM-MEMORY (port_names)," << "Write Data Transfers " << std::endl;
-          fout << "Group_End,Read" << std::endl;
+          fout << "Group_Start,Write,Write data transfers between " << cuName << " and Global Memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_WRITE - KERNEL) << ",M_AXI_GMEM-MEMORY (port_names)," << "Write Data Transfers " << "\n";
+          fout << "Group_End,Read" << "\n";
         }
 
         if(cu->streamEnabled()) {
           // KERNEL_STREAM_READ
-          fout << "Group_Start,Stream Read,Read AXI Stream transaction between " << cuName << " and Global Memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ - KERNEL) << ",Stream Port,Read AXI Stream transaction between port and memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ_STALL - KERNEL) << ",Link Stall" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ_STARVE - KERNEL) << ",Link Starve" << std::endl;
-          fout << "Group_End,Stream Read" << std::endl;
+          fout << "Group_Start,Stream Read,Read AXI Stream transaction between " << cuName << " and Global Memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ - KERNEL) << ",Stream Port,Read AXI Stream transaction between port and memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ_STALL - KERNEL) << ",Link Stall" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_READ_STARVE - KERNEL) << ",Link Starve" << "\n";
+          fout << "Group_End,Stream Read" << "\n";
 
           // KERNEL_STREAM_WRITE
-          fout << "Group_Start,Stream Write,Write AXI Stream transaction between " << cuName << " and Global Memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE - KERNEL) << ",Stream Port,Write AXI Stream transaction between port and memory" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE_STALL - KERNEL) << ",Link Stall" << std::endl;
-          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE_STARVE - KERNEL) << ",Link Starve" << std::endl;
-          fout << "Group_End,Stream Write" << std::endl;
+          fout << "Group_Start,Stream Write,Write AXI Stream transaction between " << cuName << " and Global Memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE - KERNEL) << ",Stream Port,Write AXI Stream transaction between port and memory" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE_STALL - KERNEL) << ",Link Stall" << "\n";
+          fout << "Static_Row," << (rowCount + KERNEL_STREAM_WRITE_STARVE - KERNEL) << ",Link Starve" << "\n";
+          fout << "Group_End,Stream Write" << "\n";
         }
         rowCount += (KERNEL_STREAM_WRITE_STARVE - KERNEL);
-        fout << "Group_End," << cuName << std::endl ;
+        fout << "Group_End," << cuName << "\n" ;
 // HOST READ?WRITE
       }
     }
 
     if((db->getStaticInfo()).hasFloatingAIM(deviceId)) {
-      fout << "Group_Start,AXI Memory Monitors,Read/Write data transfers over AXI Memory Mapped connection " << std::endl;
+      fout << "Group_Start,AXI Memory Monitors,Read/Write data transfers over AXI Memory Mapped connection " << "\n";
       std::map<uint64_t, Monitor*> *aimMap = (db->getStaticInfo()).getAIMonitors(deviceId);
       size_t i = 0;
       for(auto& entry : *aimMap) {
@@ -158,17 +158,17 @@ namespace xdp {
         }
 #endif
         aimBucketIdMap[i] = ++rowCount;
-        fout << "Group_Start," << aim->name  << " AXI Memory Monitor,Read/Write data transfers over AXI Memory Mapped " << aim->name << std::endl;
-        fout << "Static_Row,"  << rowCount   << ",Read transfers,Read transfers for "  << aim->name << std::endl;
-        fout << "Static_Row,"  << ++rowCount << ",Write transfers,Write transfers for " << aim->name << std::endl;
-        fout << "Group_End,"   << aim->name  << " AXI Memory Monitor" << std::endl ;
+        fout << "Group_Start," << aim->name  << " AXI Memory Monitor,Read/Write data transfers over AXI Memory Mapped " << aim->name << "\n";
+        fout << "Static_Row,"  << rowCount   << ",Read transfers,Read transfers for "  << aim->name << "\n";
+        fout << "Static_Row,"  << ++rowCount << ",Write transfers,Write transfers for " << aim->name << "\n";
+        fout << "Group_End,"   << aim->name  << " AXI Memory Monitor" << "\n" ;
         i++;
       }
-      fout << "Group_End,AXI Memory Monitors" << std::endl ;
+      fout << "Group_End,AXI Memory Monitors" << "\n" ;
     }
 
     if((db->getStaticInfo()).hasFloatingASM(deviceId)) {
-      fout << "Group_Start,AXI Stream Monitors,Data transfers over AXI Stream connection " << std::endl;
+      fout << "Group_Start,AXI Stream Monitors,Data transfers over AXI Stream connection " << "\n";
       std::map<uint64_t, Monitor*> *asmMap = (db->getStaticInfo()).getASMonitors(deviceId);
       size_t i = 0;
       for(auto& entry : *asmMap) {
@@ -187,29 +187,29 @@ namespace xdp {
         }
 #endif
         asmBucketIdMap[i] = ++rowCount;
-        fout << "Group_Start," << asM->name  << " AXI Stream Monitor,Read/Write data transfers over AXI Stream " << asM->name << std::endl;
-        fout << "Static_Row,"  << rowCount   << ",Stream Port,AXI Stream Read/Write transaction over " << asM->name << std::endl;
-        fout << "Static_Row,"  << ++rowCount << ",Link Stall,Stall during transaction over " << asM->name << std::endl;
-        fout << "Static_Row,"  << ++rowCount << ",Link Starve,Starve during transaction over " << asM->name << std::endl;
-        fout << "Group_End,"   << asM->name  << " AXI Stream Monitor" << std::endl;
+        fout << "Group_Start," << asM->name  << " AXI Stream Monitor,Read/Write data transfers over AXI Stream " << asM->name << "\n";
+        fout << "Static_Row,"  << rowCount   << ",Stream Port,AXI Stream Read/Write transaction over " << asM->name << "\n";
+        fout << "Static_Row,"  << ++rowCount << ",Link Stall,Stall during transaction over " << asM->name << "\n";
+        fout << "Static_Row,"  << ++rowCount << ",Link Starve,Starve during transaction over " << asM->name << "\n";
+        fout << "Group_End,"   << asM->name  << " AXI Stream Monitor" << "\n";
         i++;
       }
-      fout << "Group_End,AXI Stream Monitors" << std::endl ;
+      fout << "Group_End,AXI Stream Monitors" << "\n" ;
     }
 
-    fout << "Group_End," << xclbinName << std::endl ;
-    fout << "Group_End," << deviceName << std::endl ;
+    fout << "Group_End," << xclbinName << "\n" ;
+    fout << "Group_End," << deviceName << "\n" ;
   }
 
   void HALDeviceTraceWriter::writeStringTable()
   {
-    fout << "MAPPING" << std::endl ;
+    fout << "MAPPING" << "\n" ;
     (db->getDynamicInfo()).dumpStringTable(fout) ;
   }
 
   void HALDeviceTraceWriter::writeTraceEvents()
   {
-    fout << "EVENTS" << std::endl;
+    fout << "EVENTS" << "\n";
     std::vector<VTFEvent*> DeviceEvents = (db->getDynamicInfo()).getDeviceEvents(deviceId);
 
     for(auto e : DeviceEvents) {
@@ -246,22 +246,22 @@ namespace xdp {
 
   void HALDeviceTraceWriter::writeDependencies()
   {
-    fout << "DEPENDENCIES" << std::endl ;
+    fout << "DEPENDENCIES" << "\n" ;
     // No dependencies in device events
   }
 
   bool HALDeviceTraceWriter::write(bool openNewFile)
   {
     writeHeader() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeStructure() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeStringTable() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeTraceEvents() ;
-    fout << std::endl ;
+    fout << "\n" ;
     writeDependencies() ;
-    fout << std::endl ;
+    fout << "\n" ;
 
     if (openNewFile) switchFiles() ;
     return true;
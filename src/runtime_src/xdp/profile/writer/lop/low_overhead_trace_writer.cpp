@@ -59,47 +59,47 @@ namespace xdp {
   void LowOverheadTraceWriter::writeHumanReadableHeader()
   {
     VPTraceWriter::writeHeader() ;
-    fout << "TraceID," << traceID << std::endl
-         << "XRT Version," << getToolVersion() << std::endl ;
+    fout << "TraceID," << traceID << "\n"
+         << "XRT Version," << getToolVersion() << "\n" ;
   }
 
   void LowOverheadTraceWriter::writeHumanReadableStructure()
   {
-    fout << "STRUCTURE" << std::endl ;
-    fout << "Group_Start,Host APIs" << std::endl ;
-    fout << "Group_Start,OpenCL API Calls" << std::endl ;
+    fout << "STRUCTURE" << "\n" ;
+    fout << "Group_Start,Host APIs" << "\n" ;
+    fout << "Group_Start,OpenCL API Calls" << "\n" ;
     fout << "Dynamic_Row," << generalAPIBucket
-         << ",General,API Events not associated with a Queue" << std::endl ;
+         << ",General,API Events not associated with a Queue" << "\n" ;
 
     for (auto a : (db->getStaticInfo()).getCommandQueueAddresses())
     {
       fout << "Static_Row," << commandQueueToBucket[a] << ",Queue 0x" 
            << std::hex << a << ",API events associated with the command queue"
-           << std::dec << std::endl ;
+           << std::dec << "\n" ;
     }
-    fout << "Group_End,OpenCL API Calls" << std::endl ;
-    fout << "Group_Start,Data Transfer" << std::endl ;
+    fout << "Group_End,OpenCL API Calls" << "\n" ;
+    fout << "Group_Start,Data Transfer" << "\n" ;
     fout << "Dynamic_Row," << readBucket 
          << ",Read,Read data transfers from global memory to host" 
-         << std::endl ;
+         << "\n" ;
     fout << "Dynamic_Row," << writeBucket
          << ",Write,Write data transfer from host to global memory"
-         << std::endl ;
-    fout << "Group_End,Data Transfer" << std::endl ;
+         << "\n" ;
+    fout << "Group_End,Data Transfer" << "\n" ;
     fout << "Dynamic_Row_Summary," << enqueueBucket 
-         << ",Kernel Enqueues,Activity in kernel enqueues" << std::endl ;
-    fout << "Group_End,Host APIs" << std::endl ;
+         << ",Kernel Enqueues,Activity in kernel enqueues" << "\n" ;
+    fout << "Group_End,Host APIs" << "\n" ;
   }
 
   void LowOverheadTraceWriter::writeHumanReadableStringTable()
   {
-    fout << "MAPPING" << std::endl ;
+    fout << "MAPPING" << "\n" ;
     (db->getDynamicInfo()).dumpStringTable(fout) ;
   }
 
   void LowOverheadTraceWriter::writeHumanReadableTraceEvents()
   {
-    fout << "EVENTS" << std::endl ;
+    fout << "EVENTS" << "\n" ;
     auto APIEvents = 
       (db->getDynamicInfo()).filterEraseHostEvents( [](VTFEvent* e)
                                            {
@@ -134,7 +134,7 @@ namespace xdp {
 
   void LowOverheadTraceWriter::writeHumanReadableDependencies()
   {
-    fout << "DEPENDENCIES" << std::endl ;
+    fout << "DEPENDENCIES" << "\n" ;
     // No dependencies in low overhead profiling
   }
 
@@ -216,15 +216,15 @@ namespace xdp {
     //setupCommandQueueBuckets() ;
 
     writeHeader() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeStructure() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeStringTable() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeTraceEvents() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeDependencies() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
 
     if (openNewFile) switchFiles() ;
     return true;
@@ -377,55 +377,22 @@ namespace xdp {
     
     // For each function call, across all of the threads, 
     //  consolidate all the information into what we need
-    std::map<std::string,
-	     std::tuple<uint64_t,
-			double,
-			double,
-			double> > rows ;
-
-    std::map<std::pair<std::string, std::thread::id>,
-	     std::vector<std::pair<double, double>>> callCount =
-      (db->getStats()).getCallCount() ;
-    
-    for (auto call : callCount)
-    {
-      auto callAndThread = call.first ;
-      auto APIName = callAndThread.first ;
-
-      std::vector<std::pair<double, double>> timesOfCalls = call.second ;
-
-      if (rows.find(APIName) == rows.end())
-      {
-	std::tuple<uint64_t, double, double, double> blank = 
-	  std::make_tuple<uint64_t, double, double, double>(0,0,std::numeric_limits<double>::max(),0) ;
-
-	rows[APIName] = blank ;
-      }
-
-      for (auto executionTime : timesOfCalls)
-      {
-	auto timeTaken = executionTime.second - executionTime.first ;
-
-	++(std::get<0>(rows[APIName])) ;
-	std::get<1>(rows[APIName]) += timeTaken ;
-	if (timeTaken < std::get<2>(rows[APIName]))
-	  std::get<2>(rows[APIName]) = timeTaken ;
-	if (timeTaken > std::get<3>(rows[APIName]))
-	  std::get<3>(rows[APIName]) = timeTaken ;
-      }
+    std::map<std::string, CallStatistics> rows ;
 
+    for (auto& call : (db->getStats()).getCallStats())
+    {
+      rows[call.first.first].merge(call.second) ;
     }
 
-    for (auto row : rows)
+    for (auto& row : rows)
     {
-      auto averageTime = 
-	(double)(std::get<1>(row.second)) / (double)(std::get<0>(row.second)) ;
+      auto& stats = row.second ;
       fout << row.first                      << ","         // API Name
-	   << std::get<0>(row.second)        << ","         // Number of calls
-	   << (std::get<1>(row.second)/1e06) << ","         // Total time
-	   << (std::get<2>(row.second)/1e06) << ","         // Minimum time
-	   << (averageTime/1e06)             << ","         // Average time
-	   << (std::get<3>(row.second)/1e06) << "," // Maximum time
+	   << stats.count                    << ","         // Number of calls
+	   << (stats.totalTime/1e06)         << ","         // Total time
+	   << (stats.minTime/1e06)           << ","         // Minimum time
+	   << (stats.totalTime/stats.count/1e06) << ","         // Average time
+	   << (stats.maxTime/1e06)           << "," // Maximum time
 	   << std::endl ;
     }
 
@@ -66,57 +66,57 @@ namespace xdp {
   void OpenCLTraceWriter::writeHumanReadableHeader()
   {
     VPTraceWriter::writeHeader() ;
-    fout << "TraceID," << traceID << std::endl
-         << "XRT Version," << getToolVersion() << std::endl ;
+    fout << "TraceID," << traceID << "\n"
+         << "XRT Version," << getToolVersion() << "\n" ;
   }
 
   void OpenCLTraceWriter::writeHumanReadableStructure()
   {
-    fout << "STRUCTURE" << std::endl ;
-    fout << "Group_Start,Host APIs" << std::endl ;
-    fout << "Group_Start,OpenCL API Calls" << std::endl ;
+    fout << "STRUCTURE" << "\n" ;
+    fout << "Group_Start,Host APIs" << "\n" ;
+    fout << "Group_Start,OpenCL API Calls" << "\n" ;
     fout << "Dynamic_Row," << generalAPIBucket
-         << ",General,API Events not associated with a Queue" << std::endl ;
+         << ",General,API Events not associated with a Queue" << "\n" ;
 
     for (auto a : (db->getStaticInfo()).getCommandQueueAddresses())
     {
       fout << "Static_Row," << commandQueueToBucket[a] << ",Queue 0x" 
            << std::hex << a << ",API events associated with the command queue"
-           << std::dec << std::endl ;
+           << std::dec << "\n" ;
     }
-    fout << "Group_End,OpenCL API Calls" << std::endl ;
-    fout << "Group_Start,Data Transfer" << std::endl ;
+    fout << "Group_End,OpenCL API Calls" << "\n" ;
+    fout << "Group_Start,Data Transfer" << "\n" ;
     fout << "Dynamic_Row," << readBucket 
          << ",Read,Read data transfers from global memory to host" 
-         << std::endl ;
+         << "\n" ;
     fout << "Dynamic_Row," << writeBucket
          << ",Write,Write data transfer from host to global memory"
-         << std::endl ;
+         << "\n" ;
     fout << "Dynamic_Row," << copyBucket
 	 << ",Copy,Copy data transfers from global memory to global memory"
-	 << std::endl ;
-    fout << "Group_End,Data Transfer" << std::endl ;
-    fout << "Group_Start,Kernel Enqueues" << std::endl ;
+	 << "\n" ;
+    fout << "Group_End,Data Transfer" << "\n" ;
+    fout << "Group_Start,Kernel Enqueues" << "\n" ;
     //fout << "Dynamic_Row_Summary," << enqueueSummaryBucket 
-    //	 << ",Kernel Enqueues,Activity in kernel enqueues" << std::endl ;
+    //	 << ",Kernel Enqueues,Activity in kernel enqueues" << "\n" ;
     for (auto b : enqueueBuckets)
     {
       fout << "Dynamic_Row_Summary," << b.second << "," << b.first 
-           << ",Kernel Enqueue" << std::endl ;
+           << ",Kernel Enqueue" << "\n" ;
     }
-    fout << "Group_End,Kernel Enqueues" << std::endl ;
-    fout << "Group_End,Host APIs" << std::endl ;
+    fout << "Group_End,Kernel Enqueues" << "\n" ;
+    fout << "Group_End,Host APIs" << "\n" ;
   }
 
   void OpenCLTraceWriter::writeHumanReadableStringTable()
   {
-    fout << "MAPPING" << std::endl ;
+    fout << "MAPPING" << "\n" ;
     (db->getDynamicInfo()).dumpStringTable(fout) ;
   }
 
   void OpenCLTraceWriter::writeHumanReadableTraceEvents()
   {
-    fout << "EVENTS" << std::endl ;
+    fout << "EVENTS" << "\n" ;
     auto APIEvents = 
       (db->getDynamicInfo()).filterEraseHostEvents( [](VTFEvent* e)
                                                   {
@@ -158,7 +158,7 @@ namespace xdp {
 
   void OpenCLTraceWriter::writeHumanReadableDependencies()
   {
-    fout << "DEPENDENCIES" << std::endl ;
+    fout << "DEPENDENCIES" << "\n" ;
     std::map<uint64_t, std::vector<uint64_t>> dependencies = 
       (db->getDynamicInfo()).getDependencyMap() ;
 
@@ -182,7 +182,7 @@ namespace xdp {
         //  we need to output the end event ID of the first transaction
         //  followed by the start event ID of the second transaction.
         if (firstValue.second != 0 && secondValue.first != 0)
-          fout << secondValue.first << "," << firstValue.second << std::endl ;
+          fout << secondValue.first << "," << firstValue.second << "\n" ;
       }
     }
   }
@@ -292,15 +292,15 @@ namespace xdp {
     //setupCommandQueueBuckets() ;
 
     writeHeader() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeStructure() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeStringTable() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeTraceEvents() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
     writeDependencies() ;
-    if (humanReadable) fout << std::endl ;
+    if (humanReadable) fout << "\n" ;
 
     if (openNewFile) switchFiles() ;
 
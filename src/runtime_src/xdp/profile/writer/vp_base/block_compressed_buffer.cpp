@@ -0,0 +1,309 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#define XDP_SOURCE
+
+#include "xdp/profile/writer/vp_base/block_compressed_buffer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+  constexpr size_t minMatch   = 4 ;
+  constexpr size_t maxOffset  = 65535 ;
+  constexpr unsigned int hashBits = 14 ;
+
+  // The last bytes of a block are always literals, which keeps the
+  //  match search from reading past the end
+  constexpr size_t lastLiterals = 5 ;
+
+  inline uint32_t read32(const char* p)
+  {
+    uint32_t v ;
+    std::memcpy(&v, p, sizeof(v)) ;
+    return v ;
+  }
+
+  inline uint32_t hash(uint32_t v)
+  {
+    return (v * 2654435761U) >> (32 - hashBits) ;
+  }
+
+  inline void writeLength(size_t length, std::string& dst)
+  {
+    while (length >= 255) {
+      dst.push_back(static_cast<char>(255)) ;
+      length -= 255 ;
+    }
+    dst.push_back(static_cast<char>(length)) ;
+  }
+
+  void writeSequence(const char* literals, size_t numLiterals,
+                     size_t offset, size_t matchLength, std::string& dst)
+  {
+    size_t m = matchLength ? matchLength - minMatch : 0 ;
+    auto token = static_cast<unsigned char>
+      (((numLiterals < 15 ? numLiterals : 15) << 4) | (m < 15 ? m : 15)) ;
+    dst.push_back(static_cast<char>(token)) ;
+    if (numLiterals >= 15)
+      writeLength(numLiterals - 15, dst) ;
+    dst.append(literals, numLiterals) ;
+
+    if (matchLength == 0)
+      return ;
+
+    dst.push_back(static_cast<char>(offset & 0xff)) ;
+    dst.push_back(static_cast<char>(offset >> 8)) ;
+    if (m >= 15)
+      writeLength(m - 15, dst) ;
+  }
+
+  inline size_t readLength(const unsigned char*& ip, const unsigned char* end)
+  {
+    size_t length = 0 ;
+    unsigned char b = 255 ;
+    while (b == 255) {
+      if (ip >= end)
+        throw std::runtime_error("corrupt trace block: truncated length") ;
+      b = *ip++ ;
+      length += b ;
+    }
+    return length ;
+  }
+
+  void put32(std::streambuf* sink, uint32_t v)
+  {
+    char bytes[4] = { static_cast<char>(v & 0xff),
+                      static_cast<char>((v >> 8) & 0xff),
+                      static_cast<char>((v >> 16) & 0xff),
+                      static_cast<char>((v >> 24) & 0xff) } ;
+    sink->sputn(bytes, 4) ;
+  }
+
+  uint32_t get32(const unsigned char* p)
+  {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24) ;
+  }
+
+} // end anonymous namespace
+
+namespace xdp {
+namespace block_format {
+
+  void compress(const char* src, size_t size, std::string& dst)
+  {
+    size_t anchor = 0 ;
+
+    if (size > minMatch + lastLiterals) {
+      std::vector<uint32_t> table(size_t(1) << hashBits, 0) ; // position + 1
+      size_t searchEnd = size - lastLiterals - minMatch ;
+      size_t matchEnd  = size - lastLiterals ;
+      size_t i = 0 ;
+
+      while (i <= searchEnd) {
+        auto h = hash(read32(src + i)) ;
+        size_t candidate = table[h] ;
+        table[h] = static_cast<uint32_t>(i + 1) ;
+
+        if (candidate == 0 || i - (candidate - 1) > maxOffset ||
+            read32(src + candidate - 1) != read32(src + i)) {
+          ++i ;
+          continue ;
+        }
+
+        size_t match = candidate - 1 ;
+        size_t length = minMatch ;
+        while (i + length < matchEnd && src[match + length] == src[i + length])
+          ++length ;
+
+        writeSequence(src + anchor, i - anchor, i - match, length, dst) ;
+        i += length ;
+        anchor = i ;
+      }
+    }
+
+    writeSequence(src + anchor, size - anchor, 0, 0, dst) ;
+  }
+
+  void decompress(const char* src, size_t size, size_t rawSize, std::string& dst)
+  {
+    auto ip  = reinterpret_cast<const unsigned char*>(src) ;
+    auto end = ip + size ;
+    size_t base = dst.size() ;
+
+    while (ip < end) {
+      unsigned char token = *ip++ ;
+
+      size_t numLiterals = token >> 4 ;
+      if (numLiterals == 15)
+        numLiterals += readLength(ip, end) ;
+      if (static_cast<size_t>(end - ip) < numLiterals)
+        throw std::runtime_error("corrupt trace block: truncated literals") ;
+      dst.append(reinterpret_cast<const char*>(ip), numLiterals) ;
+      ip += numLiterals ;
+
+      if (ip == end)
+        break ;
+
+      if (end - ip < 2)
+        throw std::runtime_error("corrupt trace block: truncated offset") ;
+      size_t offset = ip[0] | (ip[1] << 8) ;
+      ip += 2 ;
+
+      size_t length = token & 0xf ;
+      if (length == 15)
+        length += readLength(ip, end) ;
+      length += minMatch ;
+
+      size_t written = dst.size() - base ;
+      if (offset == 0 || offset > written || written + length > rawSize)
+        throw std::runtime_error("corrupt trace block: bad match") ;
+
+      // Matches may overlap the bytes they produce
+      size_t from = dst.size() - offset ;
+      for (size_t i = 0 ; i < length ; ++i)
+        dst.push_back(dst[from + i]) ;
+    }
+
+    if (dst.size() - base != rawSize)
+      throw std::runtime_error("corrupt trace block: size mismatch") ;
+  }
+
+  bool isCompressed(std::istream& in)
+  {
+    char header[magicSize] ;
+    auto pos = in.tellg() ;
+    in.read(header, magicSize) ;
+    bool match = (in.gcount() == static_cast<std::streamsize>(magicSize)) &&
+      std::memcmp(header, magic, magicSize) == 0 ;
+    in.clear() ;
+    in.seekg(pos) ;
+    return match ;
+  }
+
+  void decode(std::istream& in, std::ostream& out)
+  {
+    std::vector<char> stored ;
+    std::string text ;
+    unsigned char header[magicSize] ;
+
+    while (in.read(reinterpret_cast<char*>(header), magicSize)) {
+      if (std::memcmp(header, magic, magicSize) == 0)
+        continue ;
+
+      uint32_t rawSize    = get32(header) ;
+      uint32_t storedSize = get32(header + 4) ;
+      if (rawSize > blockSize || storedSize > 2 * blockSize)
+        throw std::runtime_error("corrupt trace block: bad block header") ;
+
+      stored.resize(storedSize) ;
+      if (!in.read(stored.data(), storedSize))
+        throw std::runtime_error("corrupt trace block: truncated block") ;
+
+      if (storedSize == rawSize) {
+        out.write(stored.data(), storedSize) ;
+        continue ;
+      }
+
+      text.clear() ;
+      decompress(stored.data(), storedSize, rawSize, text) ;
+      out.write(text.data(), text.size()) ;
+    }
+
+    if (in.gcount() != 0)
+      throw std::runtime_error("corrupt trace block: truncated block header") ;
+  }
+
+  void convert(const std::string& input, const std::string& output)
+  {
+    std::ifstream in(input, std::ios::binary) ;
+    if (!in)
+      throw std::runtime_error("Cannot open '" + input + "'") ;
+    if (!isCompressed(in))
+      throw std::runtime_error("'" + input + "' is not a block compressed trace file") ;
+
+    std::ofstream out(output, std::ios::binary) ;
+    if (!out)
+      throw std::runtime_error("Cannot open '" + output + "'") ;
+    decode(in, out) ;
+    if (!out.flush())
+      throw std::runtime_error("Cannot write '" + output + "'") ;
+  }
+
+} // end namespace block_format
+
+  BlockCompressedBuffer::BlockCompressedBuffer(std::streambuf* s) :
+    sink(s), buffer(block_format::blockSize)
+  {
+    setp(buffer.data(), buffer.data() + buffer.size()) ;
+  }
+
+  void BlockCompressedBuffer::start()
+  {
+    setp(buffer.data(), buffer.data() + buffer.size()) ;
+    sink->sputn(block_format::magic, block_format::magicSize) ;
+  }
+
+  bool BlockCompressedBuffer::writeBlock()
+  {
+    size_t rawSize = pptr() - pbase() ;
+    if (rawSize == 0)
+      return true ;
+
+    compressed.clear() ;
+    block_format::compress(pbase(), rawSize, compressed) ;
+
+    // Store incompressible data as is
+    const char* data = compressed.data() ;
+    size_t storedSize = compressed.size() ;
+    if (storedSize >= rawSize) {
+      data = pbase() ;
+      storedSize = rawSize ;
+    }
+
+    put32(sink, static_cast<uint32_t>(rawSize)) ;
+    put32(sink, static_cast<uint32_t>(storedSize)) ;
+    auto written = sink->sputn(data, storedSize) ;
+
+    setp(buffer.data(), buffer.data() + buffer.size()) ;
+    return written == static_cast<std::streamsize>(storedSize) ;
+  }
+
+  BlockCompressedBuffer::int_type BlockCompressedBuffer::overflow(int_type c)
+  {
+    if (!writeBlock())
+      return traits_type::eof() ;
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(c) ;
+      pbump(1) ;
+    }
+    return traits_type::not_eof(c) ;
+  }
+
+  int BlockCompressedBuffer::sync()
+  {
+    if (!writeBlock())
+      return -1 ;
+    return sink->pubsync() ;
+  }
+
+} // end namespace xdp
@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BLOCK_COMPRESSED_BUFFER_DOT_H
+#define BLOCK_COMPRESSED_BUFFER_DOT_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "xdp/config.h"
+
+namespace xdp {
+
+  // Block compressed trace file format
+  //
+  // A file starts with an 8 byte magic followed by any number of
+  //  blocks.  Each block holds up to blockSize bytes of the text that
+  //  the trace writers produce:
+  //
+  //    uint32_t rawSize    (little endian)
+  //    uint32_t storedSize (little endian)
+  //    uint8_t  data[storedSize]
+  //
+  // If storedSize equals rawSize the data is stored uncompressed,
+  //  otherwise it is LZ77 compressed in the byte oriented sequence
+  //  encoding used by LZ4.  Blocks are independent, so a file can be
+  //  appended to, and complete files can be concatenated; the magic
+  //  may appear again between blocks.  Files in this format get the
+  //  extension appended to the name of the text file they hold, so
+  //  readers of the text files do not pick them up.
+  namespace block_format {
+
+    constexpr char magic[] = "XDPBLK01" ;
+    constexpr size_t magicSize = 8 ;
+    constexpr size_t blockSize = 1024 * 1024 ;
+    constexpr char extension[] = ".xdpz" ;
+
+    // Append the compressed form of src to dst
+    XDP_EXPORT void compress(const char* src, size_t size, std::string& dst) ;
+
+    // Decompress src into exactly rawSize bytes appended to dst.
+    //  Throws std::runtime_error if the data is corrupt.
+    XDP_EXPORT void decompress(const char* src, size_t size,
+                               size_t rawSize, std::string& dst) ;
+
+    // Check if the stream starts with the magic, without consuming it
+    XDP_EXPORT bool isCompressed(std::istream& in) ;
+
+    // Decode a complete block compressed stream into its text
+    XDP_EXPORT void decode(std::istream& in, std::ostream& out) ;
+
+    // Decode the block compressed file input into the text file output.
+    //  Throws std::runtime_error if input is not in the block format.
+    XDP_EXPORT void convert(const std::string& input, const std::string& output) ;
+
+  } // end namespace block_format
+
+  // The BlockCompressedBuffer is a stream buffer that collects the
+  //  text written to it and writes it to the sink stream buffer as
+  //  compressed blocks.  A partial block is written on sync.
+  class BlockCompressedBuffer : public std::streambuf
+  {
+  private:
+    std::streambuf* sink ;
+    std::vector<char> buffer ;
+    std::string compressed ;
+
+    bool writeBlock() ;
+
+  protected:
+    XDP_EXPORT virtual int_type overflow(int_type c) override ;
+    XDP_EXPORT virtual int sync() override ;
+
+  public:
+    XDP_EXPORT explicit BlockCompressedBuffer(std::streambuf* s) ;
+
+    // Start a new file on the sink by writing the magic
+    XDP_EXPORT void start() ;
+  } ;
+
+} // end namespace xdp
+
+#endif
@@ -38,6 +38,8 @@ namespace xdp {
     addParameter("stall_trace", xrt_core::config::get_stall_trace());
     addParameter("trace_buffer_size",
                  xrt_core::config::get_trace_buffer_size());
+    addParameter("trace_file_compression",
+                 xrt_core::config::get_trace_file_compression());
     addParameter("verbosity", xrt_core::config::get_verbosity());
     addParameter("continuous_trace", xrt_core::config::get_continuous_trace());
     addParameter("continuous_trace_interval_ms",
@@ -346,19 +346,10 @@ namespace xdp {
  
     // For each function call, across all of the threads, 
     //  consolidate all the information into what we need
-    std::map<std::string,
-	     std::tuple<uint64_t,
-			double,
-			double,
-			double> > rows ;
-
-    std::map<std::pair<std::string, std::thread::id>,
-	     std::vector<std::pair<double, double>>> callCount =
-      (db->getStats()).getCallCount() ;
-    
-    for (auto call : callCount) {
-      auto callAndThread = call.first ;
-      auto APIName = callAndThread.first ;
+    std::map<std::string, CallStatistics> rows ;
+
+    for (auto& call : (db->getStats()).getCallStats()) {
+      auto& APIName = call.first.first ;
 
       switch (type) {
       case OPENCL:
@@ -375,37 +366,23 @@ namespace xdp {
         break ;
       }
 
-      std::vector<std::pair<double, double>> timesOfCalls = call.second ;
-
-      if (rows.find(APIName) == rows.end()) {
-	std::tuple<uint64_t, double, double, double> blank = 
-	  std::make_tuple<uint64_t, double, double, double>(0,0,std::numeric_limits<double>::max(),0) ;
-
-	rows[APIName] = blank ;
-      }
-
-      for (auto executionTime : timesOfCalls) {
-	auto timeTaken = executionTime.second - executionTime.first ;
-
-	++(std::get<0>(rows[APIName])) ;
-	std::get<1>(rows[APIName]) += timeTaken ;
-	if (timeTaken < std::get<2>(rows[APIName]))
-	  std::get<2>(rows[APIName]) = timeTaken ;
-	if (timeTaken > std::get<3>(rows[APIName]))
-	  std::get<3>(rows[APIName]) = timeTaken ;
-      }
+      rows[APIName].merge(call.second) ;
     }
 
-    for (auto row : rows) {
-      auto averageTime = 
-	(double)(std::get<1>(row.second)) / (double)(std::get<0>(row.second)) ;
+    for (auto& row : rows) {
+      auto& stats = row.second ;
       if (type != OPENCL) fout << "ENTRY:" ;
       fout << row.first                      << ","     // API Name
-	   << std::get<0>(row.second)        << ","     // Number of calls
-	   << (std::get<1>(row.second)/one_million) << ","     // Total time
-	   << (std::get<2>(row.second)/one_million) << ","     // Minimum time
-	   << (averageTime/one_million)             << ","     // Average time
-	   << (std::get<3>(row.second)/one_million) << ",\n" ; // Maximum time
+	   << stats.count                    << ","     // Number of calls
+	   << (stats.totalTime/one_million)  << ","     // Total time
+	   << (stats.minTime/one_million)    << ","     // Minimum time
+	   << (stats.totalTime/stats.count/one_million) << ","     // Average time
+	   << (stats.maxTime/one_million)    << "," ;   // Maximum time
+      // The OpenCL table has a fixed set of columns
+      if (type != OPENCL)
+        fout << (stats.percentile(0.5)/one_million)  << ","     // P50 time
+             << (stats.percentile(0.99)/one_million) << "," ;   // P99 time
+      fout << "\n" ;
     }
   }
 
@@ -429,6 +406,8 @@ namespace xdp {
     fout << "COLUMN:Minimum Time (ms),float,Minimum execution time (in ms),\n";
     fout << "COLUMN:Average Time (ms),float,Average execution time (in ms),\n";
     fout << "COLUMN:Maximum Time (ms),float,Maximum execution time (in ms),\n";
+    fout << "COLUMN:P50 Time (ms),float,Median execution time (in ms),\n";
+    fout << "COLUMN:P99 Time (ms),float,99th percentile execution time (in ms),\n";
     writeAPICalls(NATIVE) ;
   }
 
@@ -442,6 +421,8 @@ namespace xdp {
     fout << "COLUMN:Minimum Time (ms),float,Minimum execution time (in ms),\n";
     fout << "COLUMN:Average Time (ms),float,Average execution time (in ms),\n";
     fout << "COLUMN:Maximum Time (ms),float,Maximum execution time (in ms),\n";
+    fout << "COLUMN:P50 Time (ms),float,Median execution time (in ms),\n";
+    fout << "COLUMN:P99 Time (ms),float,99th percentile execution time (in ms),\n";
     writeAPICalls(HAL) ;
   }
 
@@ -18,6 +18,7 @@
 
 #include "xdp/profile/writer/vp_base/vp_trace_writer.h"
 #include "xdp/profile/database/database.h"
+#include "core/common/config_reader.h"
 #include <iostream>
 
 namespace xdp {
@@ -33,6 +34,8 @@ namespace xdp {
     humanReadable(true)
   {
     setUniqueTraceID();
+    if (xrt_core::config::get_trace_file_compression())
+      enableCompression() ;
   }
 
   VPTraceWriter::~VPTraceWriter()
@@ -41,19 +44,19 @@ namespace xdp {
 
   void VPTraceWriter::writeHeader()
   {
-    fout << "HEADER" << std::endl
-         << "VTF File Version," << version << std::endl ;
+    fout << "HEADER" << "\n"
+         << "VTF File Version," << version << "\n" ;
     fout << "VTF File Type," ;
     if      (isHost())   fout << "0" ;
     else if (isDevice()) fout << "1" ;
     else if (isAIE())    fout << "2" ;
     else if (isKernel()) fout << "3" ;
-    fout << std::endl ;
-    fout << "PID," << (db->getStaticInfo()).getPid() << std::endl
-         << "Generated on," << creationTime << std::endl
-         << "Resolution,ms" << std::endl
-         << "Min Resolution," << (resolution == 6 ? "us" : "ns") << std::endl
-         << "Trace Version," << version << std::endl; 
+    fout << "\n" ;
+    fout << "PID," << (db->getStaticInfo()).getPid() << "\n"
+         << "Generated on," << creationTime << "\n"
+         << "Resolution,ms" << "\n"
+         << "Min Resolution," << (resolution == 6 ? "us" : "ns") << "\n"
+         << "Trace Version," << version << "\n"; 
   }
 
   void VPTraceWriter::setUniqueTraceID()
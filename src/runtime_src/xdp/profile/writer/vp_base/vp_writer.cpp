@@ -18,10 +18,13 @@
 
 #include "xdp/profile/database/database.h"
 #include "xdp/profile/writer/vp_base/vp_writer.h"
+#include "xdp/profile/writer/vp_base/block_compressed_buffer.h"
 #include "xdp/profile/device/tracedefs.h"
 #include "core/common/message.h"
 #include "core/common/config_reader.h"
 
+#include <cstdio>
+
 #ifdef _WIN32
 #else
 #include <sys/types.h>
@@ -50,7 +53,7 @@ namespace xdp {
     if (!useDir || directory == "") {
       // If no directory was specified, just use the file in
       //  the working directory
-      fout.open(filename) ;
+      openFile(filename) ;
       return ;
     }
 
@@ -85,17 +88,57 @@ namespace xdp {
     if (!dirExists || !writeable) {
       // If we cannot create the directory, or if we cannot write to
       //  the directory, then just use the filename
-      fout.open(filename) ;
+      openFile(filename) ;
       return ;
     }
 
     // Set the file name to directory + filename
     currentFileName = directory + separator + basename ;
-    fout.open(currentFileName) ;
+    openFile(currentFileName) ;
   }
 
   VPWriter::~VPWriter()
   {
+    if (compressedBuffer) {
+      // Write the last partial block before fout closes the file
+      fout.flush() ;
+      static_cast<std::ostream&>(fout).rdbuf(fout.rdbuf()) ;
+    }
+  }
+
+  void VPWriter::openFile(const std::string& name)
+  {
+    if (!compressedBuffer) {
+      fout.open(name) ;
+      return ;
+    }
+
+    fout.open(name + block_format::extension,
+              std::ios::out | std::ios::trunc | std::ios::binary) ;
+    // Text written to fout goes through the compressed buffer
+    //  into the file buffer of fout
+    static_cast<std::ostream&>(fout).rdbuf(compressedBuffer.get()) ;
+    compressedBuffer->start() ;
+  }
+
+  void VPWriter::closeFile()
+  {
+    if (compressedBuffer)
+      fout.flush() ;
+    fout.close() ;
+    fout.clear() ;
+  }
+
+  void VPWriter::enableCompression()
+  {
+    if (compressedBuffer)
+      return ;
+    // The text file opened by the constructor is replaced by the
+    //  compressed file
+    closeFile() ;
+    std::remove(currentFileName.c_str()) ;
+    compressedBuffer.reset(new BlockCompressedBuffer(fout.rdbuf())) ;
+    openFile(currentFileName) ;
   }
 
   // After write is called, if we are doing continuous offload
@@ -103,8 +146,7 @@ namespace xdp {
   bool VPWriter::warnFileNum = false;
   void VPWriter::switchFiles()
   {
-    fout.close() ;
-    fout.clear() ;
+    closeFile() ;
 
     ++fileNum ;
     currentFileName = std::to_string(fileNum) + std::string("-") + basename ;
@@ -117,21 +159,21 @@ namespace xdp {
       warnFileNum = true;
     }
 
-    fout.open(currentFileName.c_str()) ;
+    openFile(currentFileName) ;
   }
 
   // If we are overwriting a file that was previously written (but not
   //  switching files), then this function resets the output stream
   void VPWriter::refreshFile()
   {
-    fout.close() ;
-    fout.clear() ;
-
-    fout.open(currentFileName.c_str()) ;
+    closeFile() ;
+    openFile(currentFileName) ;
   }
 
   std::string VPWriter::getcurrentFileName()
   {
+    if (compressedBuffer)
+      return currentFileName + block_format::extension ;
     return currentFileName ;
   }
 
@@ -18,6 +18,7 @@
 #define VP_WRITER_DOT_H
 
 #include <fstream>
+#include <memory>
 #include <string>
 
 #include "xdp/config.h"
@@ -27,6 +28,7 @@ namespace xdp {
   // Forward declarations
   class VPDatabase ;
   class DeviceIntf ;
+  class BlockCompressedBuffer ;
 
   // The base class for all writers, including summaries, traces, 
   //  and any others.
@@ -47,6 +49,12 @@ namespace xdp {
     uint32_t fileNum ;
     static bool warnFileNum;
 
+    // When set, everything written to fout is block compressed
+    std::unique_ptr<BlockCompressedBuffer> compressedBuffer ;
+
+    void openFile(const std::string& name) ;
+    void closeFile() ;
+
   protected:
     // Connection to the database where all the information is stored
     VPDatabase* db ;
@@ -59,6 +67,9 @@ namespace xdp {
     inline const char* getRawBasename() { return basename.c_str() ; } 
     XDP_EXPORT virtual void switchFiles() ;
     XDP_EXPORT virtual void refreshFile() ;
+
+    // Reopen the current file in the block compressed trace format
+    XDP_EXPORT void enableCompression() ;
   public:
     XDP_EXPORT VPWriter(const char* filename) ;
     XDP_EXPORT VPWriter(const char* filename, VPDatabase* inst, bool useDir = true) ;
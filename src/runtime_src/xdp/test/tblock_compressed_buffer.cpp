@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include "xdp/profile/writer/vp_base/block_compressed_buffer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace xdp;
+
+namespace {
+
+// Write text to file through the compressed buffer the way VPWriter
+// does, optionally appending to an existing file
+void writeCompressed(const std::string& file, const std::string& text,
+                     bool append = false)
+{
+  auto mode = std::ios::out | std::ios::binary
+    | (append ? std::ios::app : std::ios::trunc);
+  std::ofstream fout(file, mode);
+  BlockCompressedBuffer compressed(fout.rdbuf());
+  static_cast<std::ostream&>(fout).rdbuf(&compressed);
+  compressed.start();
+  fout << text;
+  fout.flush();
+  static_cast<std::ostream&>(fout).rdbuf(fout.rdbuf());
+}
+
+std::string readFile(const std::string& file)
+{
+  std::ifstream in(file, std::ios::binary);
+  std::ostringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+// Compress, convert back to the text file as xdp_trace_convert does,
+// and return the converted text
+std::string roundTrip(const std::string& text)
+{
+  std::string csv = "tblock_compressed_buffer.csv";
+  std::string compressed = csv + block_format::extension;
+  writeCompressed(compressed, text);
+  block_format::convert(compressed, csv);
+  auto result = readFile(csv);
+  std::remove(compressed.c_str());
+  std::remove(csv.c_str());
+  return result;
+}
+
+std::string traceLines(size_t count)
+{
+  std::ostringstream text;
+  text << "HEADER\nVTF File Version,1.0\nVTF File Type,1\n";
+  for (size_t i = 0; i < count; ++i)
+    text << i << "," << (i * 7) % 1000 << "," << 1000.0 + i * 0.125
+         << ",4," << i % 16 << "\n";
+  return text.str();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE ( test_block_compressed_buffer )
+
+BOOST_AUTO_TEST_CASE( test_round_trip )
+{
+  BOOST_CHECK_EQUAL(roundTrip(""), "");
+  BOOST_CHECK_EQUAL(roundTrip("a"), "a");
+
+  auto small = traceLines(10);
+  BOOST_CHECK_EQUAL(roundTrip(small), small);
+
+  // Several blocks, the last one partial
+  auto large = traceLines(200000);
+  BOOST_REQUIRE(large.size() > 2 * block_format::blockSize);
+  BOOST_CHECK(roundTrip(large) == large);
+
+  // Incompressible data is stored as is
+  std::mt19937 gen(1);
+  std::string random(block_format::blockSize + 1000, '\0');
+  for (auto& c : random)
+    c = static_cast<char>(gen());
+  BOOST_CHECK(roundTrip(random) == random);
+}
+
+BOOST_AUTO_TEST_CASE( test_compression )
+{
+  // Trace text must get smaller, one block at a time
+  auto text = traceLines(30000);
+  BOOST_REQUIRE(text.size() <= block_format::blockSize);
+  std::string compressed;
+  block_format::compress(text.data(), text.size(), compressed);
+  BOOST_CHECK(compressed.size() < text.size() * 3 / 4);
+
+  std::string decompressed;
+  block_format::decompress(compressed.data(), compressed.size(),
+                           text.size(), decompressed);
+  BOOST_CHECK(decompressed == text);
+}
+
+BOOST_AUTO_TEST_CASE( test_append )
+{
+  // A file appended to after a restart converts to both texts
+  std::string csv = "tblock_compressed_buffer_append.csv";
+  std::string compressed = csv + block_format::extension;
+  auto first = traceLines(1000);
+  auto second = traceLines(500);
+  writeCompressed(compressed, first);
+  writeCompressed(compressed, second, true);
+  block_format::convert(compressed, csv);
+  BOOST_CHECK(readFile(csv) == first + second);
+  std::remove(compressed.c_str());
+  std::remove(csv.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( test_reject )
+{
+  // Text files and corrupt files are not converted
+  std::string csv = "tblock_compressed_buffer_text.csv";
+  std::string out = "tblock_compressed_buffer_out.csv";
+  {
+    std::ofstream fout(csv);
+    fout << traceLines(10);
+  }
+  {
+    std::ifstream in(csv, std::ios::binary);
+    BOOST_CHECK(!block_format::isCompressed(in));
+  }
+  BOOST_CHECK_THROW(block_format::convert(csv, out), std::runtime_error);
+
+  std::string compressed = csv + block_format::extension;
+  writeCompressed(compressed, traceLines(1000));
+  auto data = readFile(compressed);
+  {
+    std::ofstream fout(compressed, std::ios::binary | std::ios::trunc);
+    fout.write(data.data(), data.size() / 2);
+  }
+  BOOST_CHECK_THROW(block_format::convert(compressed, out), std::runtime_error);
+
+  std::remove(csv.c_str());
+  std::remove(compressed.c_str());
+  std::remove(out.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
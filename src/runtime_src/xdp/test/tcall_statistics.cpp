@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include "xdp/profile/database/statistics_database.h"
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using xdp::CallStatistics;
+
+namespace {
+
+// Durations of an exponential distribution with the given mean
+std::vector<double> exponential(size_t count, double mean, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::exponential_distribution<double> dist(1.0 / mean);
+  std::vector<double> durations(count);
+  for (auto& d : durations)
+    d = dist(gen);
+  return durations;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE ( test_call_statistics )
+
+BOOST_AUTO_TEST_CASE( test_buckets )
+{
+  // Everything below 1 shares the first bucket, then 8 per power of two
+  const unsigned int subBuckets = CallStatistics::subBuckets;
+  const unsigned int numBuckets = CallStatistics::numBuckets;
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(0), 0);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(0.5), 0);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(1.0), 0);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(1.125), 1);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(2.0), subBuckets);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(3.0), subBuckets + 4);
+  BOOST_CHECK_EQUAL(CallStatistics::bucket(1e300), numBuckets - 1);
+
+  // Every bucket value falls in its own bucket
+  for (unsigned int i = 0; i < numBuckets; ++i)
+    BOOST_CHECK_EQUAL(CallStatistics::bucket(CallStatistics::bucketValue(i)), i);
+}
+
+BOOST_AUTO_TEST_CASE( test_constant )
+{
+  CallStatistics stats;
+  BOOST_CHECK_EQUAL(stats.percentile(0.5), 0);
+
+  for (int i = 0; i < 1000; ++i)
+    stats.update(42.0);
+  BOOST_CHECK_EQUAL(stats.count, 1000);
+  BOOST_CHECK_CLOSE(stats.totalTime, 42000.0, 1e-9);
+  BOOST_CHECK_EQUAL(stats.minTime, 42.0);
+  BOOST_CHECK_EQUAL(stats.maxTime, 42.0);
+  BOOST_CHECK_CLOSE(stats.mean, 42.0, 1e-9);
+  BOOST_CHECK_SMALL(stats.variance(), 1e-9);
+
+  // Percentiles are clamped to the observed range
+  BOOST_CHECK_EQUAL(stats.percentile(0.5), 42.0);
+  BOOST_CHECK_EQUAL(stats.percentile(0.99), 42.0);
+}
+
+BOOST_AUTO_TEST_CASE( test_uniform )
+{
+  // 1..n once each: mean (n+1)/2, sample variance n(n+1)/12
+  const int n = 10000;
+  CallStatistics stats;
+  for (int i = n; i >= 1; --i)
+    stats.update(i);
+
+  BOOST_CHECK_EQUAL(stats.count, n);
+  BOOST_CHECK_EQUAL(stats.minTime, 1.0);
+  BOOST_CHECK_EQUAL(stats.maxTime, n);
+  BOOST_CHECK_CLOSE(stats.mean, (n + 1) / 2.0, 1e-9);
+  BOOST_CHECK_CLOSE(stats.variance(), n * (n + 1.0) / 12.0, 1e-9);
+
+  // Bucket width is 1/8 of a power of two, the midpoint is within 6.25%
+  BOOST_CHECK_CLOSE(stats.percentile(0.5), n * 0.5, 6.25);
+  BOOST_CHECK_CLOSE(stats.percentile(0.9), n * 0.9, 6.25);
+  BOOST_CHECK_CLOSE(stats.percentile(0.99), n * 0.99, 6.25);
+  BOOST_CHECK_EQUAL(stats.percentile(1.0), n);
+}
+
+BOOST_AUTO_TEST_CASE( test_exponential )
+{
+  // Quantile q of an exponential distribution is -mean * ln(1 - q)
+  const double mean = 5000;
+  CallStatistics stats;
+  for (auto d : exponential(200000, mean, 7))
+    stats.update(d);
+
+  BOOST_CHECK_CLOSE(stats.mean, mean, 1.0);
+  BOOST_CHECK_CLOSE(std::sqrt(stats.variance()), mean, 2.0);
+  BOOST_CHECK_CLOSE(stats.percentile(0.5), mean * std::log(2.0), 8.0);
+  BOOST_CHECK_CLOSE(stats.percentile(0.99), mean * std::log(100.0), 8.0);
+}
+
+BOOST_AUTO_TEST_CASE( test_large_offset )
+{
+  // Running variance stays exact for small spread at large durations
+  CallStatistics stats;
+  for (int i = 0; i < 100000; ++i)
+    stats.update(1e9 + (i % 2));
+  BOOST_CHECK_CLOSE(stats.mean, 1e9 + 0.5, 1e-9);
+  BOOST_CHECK_CLOSE(stats.variance(), 0.25 * 100000 / 99999, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE( test_thread_merge )
+{
+  // Threads aggregate different distributions, the merge must match
+  //  aggregating all durations in one place
+  const unsigned int threads = 8;
+  std::vector<std::vector<double>> durations;
+  for (unsigned int t = 0; t < threads; ++t)
+    durations.push_back(exponential(10000 * (t + 1), 100.0 * (t + 1), t));
+
+  std::vector<CallStatistics> perThread(threads);
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      for (auto d : durations[t])
+        perThread[t].update(d);
+    });
+  for (auto& w : workers)
+    w.join();
+
+  CallStatistics merged;
+  CallStatistics empty;
+  merged.merge(empty);
+  BOOST_CHECK_EQUAL(merged.count, 0);
+  for (auto& s : perThread)
+    merged.merge(s);
+  merged.merge(empty);
+
+  CallStatistics expected;
+  for (auto& d : durations)
+    for (auto duration : d)
+      expected.update(duration);
+
+  BOOST_CHECK_EQUAL(merged.count, expected.count);
+  BOOST_CHECK_CLOSE(merged.totalTime, expected.totalTime, 1e-9);
+  BOOST_CHECK_EQUAL(merged.minTime, expected.minTime);
+  BOOST_CHECK_EQUAL(merged.maxTime, expected.maxTime);
+  BOOST_CHECK_CLOSE(merged.mean, expected.mean, 1e-9);
+  BOOST_CHECK_CLOSE(merged.variance(), expected.variance(), 1e-6);
+  for (unsigned int i = 0; i < CallStatistics::numBuckets; ++i)
+    BOOST_CHECK_EQUAL(merged.histogram[i], expected.histogram[i]);
+  BOOST_CHECK_EQUAL(merged.percentile(0.5), expected.percentile(0.5));
+  BOOST_CHECK_EQUAL(merged.percentile(0.99), expected.percentile(0.99));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include "xdp/profile/database/events/event_arena.h"
+
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+using xdp::EventArena;
+
+BOOST_AUTO_TEST_SUITE ( test_event_arena )
+
+BOOST_AUTO_TEST_CASE( test_size_classes )
+{
+  // Blocks of one size class never overlap and are usable for the
+  // whole rounded up size
+  std::vector<void*> blocks;
+  for (size_t size = 1; size <= EventArena::maxSize; ++size) {
+    auto block = EventArena::allocate(size);
+    BOOST_REQUIRE(block != nullptr);
+    BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(block) % 8, 0);
+    std::memset(block, static_cast<int>(size), (size + 7) / 8 * 8);
+    blocks.push_back(block);
+  }
+  for (size_t size = 1; size <= EventArena::maxSize; ++size) {
+    auto block = static_cast<unsigned char*>(blocks[size - 1]);
+    for (size_t i = 0; i < size; ++i)
+      BOOST_CHECK_EQUAL(block[i], static_cast<unsigned char>(size));
+  }
+  for (size_t size = 1; size <= EventArena::maxSize; ++size)
+    EventArena::deallocate(blocks[size - 1], size);
+
+  // Larger objects come from the heap
+  auto large = EventArena::allocate(EventArena::maxSize + 1);
+  BOOST_REQUIRE(large != nullptr);
+  EventArena::deallocate(large, EventArena::maxSize + 1);
+}
+
+BOOST_AUTO_TEST_CASE( test_reuse )
+{
+  // A freed block is handed out again by the same thread
+  std::set<void*> first;
+  std::vector<void*> blocks;
+  for (int i = 0; i < 100; ++i)
+    blocks.push_back(EventArena::allocate(48));
+  first.insert(blocks.begin(), blocks.end());
+  BOOST_CHECK_EQUAL(first.size(), blocks.size());
+
+  for (auto block : blocks)
+    EventArena::deallocate(block, 48);
+  for (auto& block : blocks) {
+    block = EventArena::allocate(48);
+    BOOST_CHECK(first.count(block));
+  }
+  for (auto block : blocks)
+    EventArena::deallocate(block, 48);
+}
+
+BOOST_AUTO_TEST_CASE( test_thread_local_slabs )
+{
+  // Blocks freed by a thread that only deletes events are handed back
+  // to the allocating thread, and blocks of an exited thread are reused
+  const size_t count = 10000;
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < count; ++i)
+    blocks.push_back(EventArena::allocate(64));
+
+  std::thread deleter([&blocks] {
+    for (auto block : blocks)
+      EventArena::deallocate(block, 64);
+  });
+  deleter.join();
+
+  // This thread still caches part of its last batch, so all freed
+  // blocks are back within one more batch of allocations
+  std::set<void*> freed(blocks.begin(), blocks.end());
+  blocks.clear();
+  size_t reused = 0;
+  for (size_t i = 0; i < count + 256; ++i) {
+    blocks.push_back(EventArena::allocate(64));
+    reused += freed.count(blocks.back());
+  }
+  BOOST_CHECK_EQUAL(reused, count);
+
+  // Concurrent allocation never hands out the same block twice
+  std::vector<std::vector<void*>> per_thread(4);
+  std::vector<std::thread> threads;
+  for (auto& owned : per_thread)
+    threads.emplace_back([&owned] {
+      for (int i = 0; i < 5000; ++i)
+        owned.push_back(EventArena::allocate(64));
+    });
+  for (auto& t : threads)
+    t.join();
+  std::set<void*> unique(blocks.begin(), blocks.end());
+  size_t total = blocks.size();
+  for (auto& owned : per_thread) {
+    unique.insert(owned.begin(), owned.end());
+    total += owned.size();
+  }
+  BOOST_CHECK_EQUAL(unique.size(), total);
+
+  for (auto block : blocks)
+    EventArena::deallocate(block, 64);
+  for (auto& owned : per_thread)
+    for (auto block : owned)
+      EventArena::deallocate(block, 64);
+}
+
+BOOST_AUTO_TEST_CASE( test_trim )
+{
+  // Slabs of a size class with a live block are kept
+  auto live = EventArena::allocate(200);
+  std::vector<void*> blocks;
+  for (int i = 0; i < 1000; ++i)
+    blocks.push_back(EventArena::allocate(16));
+  for (auto block : blocks)
+    EventArena::deallocate(block, 16);
+
+  BOOST_CHECK(EventArena::trim() > 0);
+  std::memset(live, 0, 200);
+
+  // Nothing left to release once the size classes are empty
+  EventArena::deallocate(live, 200);
+  BOOST_CHECK(EventArena::trim() > 0);
+  BOOST_CHECK_EQUAL(EventArena::trim(), 0);
+
+  // The arena is usable after trim
+  auto block = EventArena::allocate(16);
+  BOOST_REQUIRE(block != nullptr);
+  EventArena::deallocate(block, 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,145 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <boost/test/unit_test.hpp>
+
+#include "xdp/profile/device/traceS2MM.h"
+#include "xdp/profile/device/trace_offload_pipeline.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Stands in for DeviceIntf::parseTraceData on a device without hardware
+struct mock_device_intf : xdp::TraceS2MM
+{
+  mock_device_intf() : xdp::TraceS2MM(nullptr, 0, nullptr) { setTraceFormat(1); }
+
+  void
+  parseTraceData(void* buf, uint64_t bytes, std::vector<xclTraceResults>& results)
+  {
+    parseTraceBuf(buf, bytes, results);
+  }
+};
+
+std::vector<std::vector<uint64_t>>
+make_buffers(size_t count, size_t packets)
+{
+  std::mt19937_64 rng(7);
+  std::vector<std::vector<uint64_t>> buffers(count);
+  for (auto& buf : buffers) {
+    for (size_t i = 0; i < packets; ++i) {
+      // Clock training packets split across buffers
+      auto packet = (rng() & ~(1ULL << 63)) | 1;
+      if (rng() % 64 == 0)
+        packet |= (1ULL << 63);
+      buf.push_back(packet);
+    }
+  }
+  // Initial clock training
+  for (int i = 0; i < 8; ++i)
+    buffers[0][i] |= (1ULL << 63);
+  return buffers;
+}
+
+std::vector<uint64_t>
+timestamps(const std::vector<xclTraceResults>& results)
+{
+  std::vector<uint64_t> ts;
+  for (auto& r : results)
+    ts.push_back(r.Timestamp ^ (r.HostTimestamp << 1) ^ r.TraceID);
+  return ts;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE ( test_offload_pipeline )
+
+BOOST_AUTO_TEST_CASE( test_pipeline_matches_serial )
+{
+  auto buffers = make_buffers(64, 4096);
+
+  // Serial offload as done without the pipeline
+  std::vector<xclTraceResults> expected;
+  {
+    mock_device_intf dev;
+    std::vector<xclTraceResults> results;
+    for (auto& buf : buffers) {
+      dev.parseTraceData(buf.data(), buf.size() * sizeof(uint64_t), results);
+      expected.insert(expected.end(), results.begin(), results.end());
+    }
+  }
+
+  mock_device_intf dev;
+  std::vector<xclTraceResults> logged;
+  xdp::TraceOffloadPipeline pipeline(
+    [&dev] (void* buf, uint64_t bytes, std::vector<xclTraceResults>& results) {
+      dev.parseTraceData(buf, bytes, results);
+    },
+    [&logged] (std::vector<xclTraceResults>& results) {
+      logged.insert(logged.end(), results.begin(), results.end());
+    });
+
+  std::vector<uint64_t> staging;
+  for (auto& buf : buffers) {
+    // The device reuses its buffer as soon as push returns
+    staging = buf;
+    pipeline.push(staging.data(), staging.size() * sizeof(uint64_t));
+    std::fill(staging.begin(), staging.end(), 0);
+  }
+  pipeline.flush();
+
+  BOOST_CHECK(timestamps(logged) == timestamps(expected));
+  pipeline.stop();
+
+  auto stats = pipeline.getStatistics();
+  BOOST_CHECK_EQUAL(stats.buffers, buffers.size());
+  BOOST_CHECK_EQUAL(stats.bytes, buffers.size() * 4096 * sizeof(uint64_t));
+}
+
+BOOST_AUTO_TEST_CASE( test_pipeline_backpressure )
+{
+  auto buffers = make_buffers(16, 256);
+
+  mock_device_intf dev;
+  size_t logged = 0;
+  xdp::TraceOffloadPipeline pipeline(
+    [&dev] (void* buf, uint64_t bytes, std::vector<xclTraceResults>& results) {
+      dev.parseTraceData(buf, bytes, results);
+    },
+    [&logged] (std::vector<xclTraceResults>& results) {
+      // Slow database inserts
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      logged += results.size();
+    });
+
+  for (auto& buf : buffers)
+    pipeline.push(buf.data(), buf.size() * sizeof(uint64_t));
+
+  // Stop drains everything that was pushed
+  pipeline.stop();
+
+  auto stats = pipeline.getStatistics();
+  BOOST_CHECK(logged > 0);
+  BOOST_CHECK(stats.pushStalls > 0);
+  BOOST_CHECK(stats.decodeStalls > 0);
+  BOOST_CHECK(stats.pushStallTime.count() > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,238 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "xdp/profile/device/traceS2MM.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// Packet by packet decoder that TraceS2MM::parseTraceBuf must match
+struct reference_decoder
+{
+  uint32_t format = 0;
+  uint64_t firstTs = 0;
+  bool trainingDone = false;
+  uint32_t modulus = 0;
+  xclTraceResults partial = {};
+
+  uint64_t
+  seek(const uint64_t* arr, uint64_t count)
+  {
+    uint64_t n = 8;
+    if (format < 1 || trainingDone)
+      return 0;
+    if (count < n)
+      return count;
+    count -= n;
+    for (uint64_t i = 0; i <= count; i++) {
+      for (uint64_t j = i; j < i + n; j++) {
+        if (!((arr[j] >> 63) & 0x1))
+          break;
+        if (j == i + n - 1)
+          return i;
+      }
+    }
+    return count;
+  }
+
+  void
+  parse(const uint64_t* pos, uint64_t count, std::vector<xclTraceResults>& out)
+  {
+    static const uint64_t tsmask = 0x1FFFFFFFFFFF;
+    out.clear();
+    uint64_t idx = seek(pos, count);
+    if (idx == count)
+      return;
+
+    for (auto i = idx; i < count; i++) {
+      auto packet = pos[i];
+      if (!packet)
+        break;
+      if (i == 0 && !firstTs)
+        firstTs = packet & tsmask;
+
+      bool isClockTrain = (format == 1) ? ((packet >> 63) & 0x1)
+                                        : (i < 8 && !trainingDone);
+      if (isClockTrain) {
+        if (modulus == 0) {
+          uint64_t timestamp = packet & tsmask;
+          partial.Timestamp = (timestamp >= firstTs)
+            ? timestamp - firstTs : timestamp + (tsmask - firstTs);
+          partial.isClockTrain = 1;
+        }
+        partial.HostTimestamp |= (((packet >> 45) & 0xFFFF) << (16 * modulus));
+        if (modulus == 3) {
+          modulus = 0;
+          out.push_back(partial);
+          partial = {};
+        }
+        else {
+          ++modulus;
+        }
+      }
+      else {
+        xclTraceResults result = {};
+        result.Timestamp = (packet & tsmask) - firstTs;
+        result.EventType = ((packet >> 45) & 0xF) ? XCL_PERF_MON_END_EVENT
+                                                  : XCL_PERF_MON_START_EVENT;
+        result.TraceID = (packet >> 49) & 0xFFF;
+        result.Reserved = (packet >> 61) & 0x1;
+        result.Overflow = (packet >> 62) & 0x1;
+        result.EventID = XCL_PERF_MON_HW_EVENT;
+        result.EventFlags = ((packet >> 45) & 0xF) | ((packet >> 57) & 0x10);
+        result.isClockTrain = 0;
+        out.push_back(result);
+      }
+    }
+    trainingDone = true;
+  }
+};
+
+// Expose the decoding state so it can be compared
+struct test_s2mm : xdp::TraceS2MM
+{
+  test_s2mm() : xdp::TraceS2MM(nullptr, 0, nullptr) {}
+
+  void
+  check_state(const reference_decoder& ref)
+  {
+    BOOST_CHECK_EQUAL(mPacketFirstTs, ref.firstTs);
+    BOOST_CHECK_EQUAL(mclockTrainingdone, ref.trainingDone);
+    BOOST_CHECK_EQUAL(mModulus, ref.modulus);
+    BOOST_CHECK_EQUAL(partialResult.Timestamp, ref.partial.Timestamp);
+    BOOST_CHECK_EQUAL(partialResult.HostTimestamp, ref.partial.HostTimestamp);
+  }
+};
+
+void
+check_equal(const std::vector<xclTraceResults>& a, const std::vector<xclTraceResults>& b)
+{
+  BOOST_REQUIRE_EQUAL(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); ++i) {
+    BOOST_CHECK_EQUAL(a[i].EventID, b[i].EventID);
+    BOOST_CHECK_EQUAL(a[i].EventType, b[i].EventType);
+    BOOST_CHECK_EQUAL(a[i].Timestamp, b[i].Timestamp);
+    BOOST_CHECK_EQUAL(a[i].Overflow, b[i].Overflow);
+    BOOST_CHECK_EQUAL(a[i].TraceID, b[i].TraceID);
+    BOOST_CHECK_EQUAL(a[i].Error, b[i].Error);
+    BOOST_CHECK_EQUAL(a[i].Reserved, b[i].Reserved);
+    BOOST_CHECK_EQUAL(a[i].isClockTrain, b[i].isClockTrain);
+    BOOST_CHECK_EQUAL(a[i].HostTimestamp, b[i].HostTimestamp);
+    BOOST_CHECK_EQUAL(a[i].EventFlags, b[i].EventFlags);
+    BOOST_CHECK_EQUAL(a[i].WriteAddrLen, b[i].WriteAddrLen);
+    BOOST_CHECK_EQUAL(a[i].ReadAddrLen, b[i].ReadAddrLen);
+    BOOST_CHECK_EQUAL(a[i].WriteBytes, b[i].WriteBytes);
+    BOOST_CHECK_EQUAL(a[i].ReadBytes, b[i].ReadBytes);
+  }
+}
+
+const uint64_t clock_bit = 1ULL << 63;
+
+// Random buffer of trace packets.  Clock training packets are
+//  placed in groups of four with an optional garbage prefix.
+std::vector<uint64_t>
+make_buffer(std::mt19937_64& rng, uint32_t format, size_t size)
+{
+  std::vector<uint64_t> buf;
+  if (format == 1 && (rng() & 1)) {
+    auto garbage = rng() % 32;
+    for (size_t i = 0; i < garbage; ++i)
+      buf.push_back(rng() | 1);
+  }
+  if (rng() % 8) {
+    for (int i = 0; i < 8; ++i)
+      buf.push_back((rng() | clock_bit) | 1);
+  }
+  while (buf.size() < size) {
+    if (format == 1 && rng() % 16 == 0) {
+      for (int i = 0; i < 4; ++i)
+        buf.push_back((rng() | clock_bit) | 1);
+      continue;
+    }
+    auto packet = (rng() & ~clock_bit) | 1;
+    // Occasional empty packet ends the valid data
+    if (rng() % 512 == 0)
+      packet = 0;
+    buf.push_back(packet);
+  }
+  buf.resize(size);
+  return buf;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE ( test_traceS2MM )
+
+BOOST_AUTO_TEST_CASE( test_parse_matches_reference )
+{
+  std::mt19937_64 rng(42);
+  std::vector<xclTraceResults> results;
+  std::vector<xclTraceResults> expected;
+
+  for (uint32_t format = 0; format < 2; ++format) {
+    for (int iter = 0; iter < 200; ++iter) {
+      test_s2mm s2mm;
+      reference_decoder ref;
+      s2mm.setTraceFormat(format);
+      ref.format = format;
+
+      // Consecutive buffers carry decoding state over
+      for (int chunk = 0; chunk < 3; ++chunk) {
+        auto buf = make_buffer(rng, format, rng() % 2048);
+        s2mm.parseTraceBuf(buf.data(), buf.size() * sizeof(uint64_t), results);
+        ref.parse(buf.data(), buf.size(), expected);
+        check_equal(results, expected);
+        s2mm.check_state(ref);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( test_parse_edge_cases )
+{
+  std::vector<xclTraceResults> results;
+  std::vector<xclTraceResults> expected;
+  std::vector<std::vector<uint64_t>> buffers = {
+    {},
+    { 0 },
+    { clock_bit | 5, clock_bit | 6, clock_bit | 7 },
+    // No run of 8 clock training packets
+    std::vector<uint64_t>(20, 0x1234),
+    // Clock training split by an empty packet
+    { clock_bit | 1, clock_bit | 2, clock_bit | 3, clock_bit | 4,
+      clock_bit | 5, clock_bit | 6, clock_bit | 7, clock_bit | 8,
+      clock_bit | 9, clock_bit | 10, 0, 11 },
+  };
+
+  for (uint32_t format = 0; format < 2; ++format) {
+    for (auto& buf : buffers) {
+      test_s2mm s2mm;
+      reference_decoder ref;
+      s2mm.setTraceFormat(format);
+      ref.format = format;
+      s2mm.parseTraceBuf(buf.data(), buf.size() * sizeof(uint64_t), results);
+      ref.parse(buf.data(), buf.size(), expected);
+      check_equal(results, expected);
+      s2mm.check_state(ref);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
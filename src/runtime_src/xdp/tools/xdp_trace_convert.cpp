@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Convert block compressed trace files, written when trace_file_compression
+// is set in xrt.ini, back to the CSV trace files referenced by the run
+// summary.  Compressed files are named after the CSV file they hold with
+// a .xdpz extension appended.  Without a CSV file the text is written to
+// standard output.
+//
+//  % xdp_trace_convert device_trace_0.csv.xdpz device_trace_0.csv
+//
+// With -b, measure the time to write an existing CSV trace file line by
+// line with a flush per line, with buffered output, and in the block
+// compressed format, and report the resulting file sizes:
+//
+//  % xdp_trace_convert -b <csv file>
+
+// The block format is compiled into the converter, not imported from xdp_core
+#define XDP_SOURCE
+
+#include "xdp/profile/writer/vp_base/block_compressed_buffer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void
+usage()
+{
+  std::cout << "Usage: xdp_trace_convert <trace file> [<csv file>]\n"
+            << "       xdp_trace_convert -b <csv file>\n" ;
+}
+
+int
+convert(const std::string& input, const std::string& output)
+{
+  if (!output.empty()) {
+    xdp::block_format::convert(input, output) ;
+    return 0 ;
+  }
+
+  std::ifstream in(input, std::ios::binary) ;
+  if (!in)
+    throw std::runtime_error("Cannot open '" + input + "'") ;
+  if (!xdp::block_format::isCompressed(in))
+    throw std::runtime_error("'" + input + "' is not a block compressed trace file") ;
+  xdp::block_format::decode(in, std::cout) ;
+  std::cout.flush() ;
+  return 0 ;
+}
+
+enum class write_mode { flush_per_line, buffered, compressed } ;
+
+// Returns elapsed ms to write lines to file in the given mode
+double
+write_lines(const std::vector<std::string>& lines, const std::string& file, write_mode mode)
+{
+  auto start = std::chrono::high_resolution_clock::now() ;
+  {
+    std::ofstream fout(file, std::ios::binary) ;
+    xdp::BlockCompressedBuffer compressed(fout.rdbuf()) ;
+    if (mode == write_mode::compressed) {
+      static_cast<std::ostream&>(fout).rdbuf(&compressed) ;
+      compressed.start() ;
+    }
+
+    for (auto& line : lines) {
+      if (mode == write_mode::flush_per_line)
+        fout << line << std::endl ;
+      else
+        fout << line << "\n" ;
+    }
+
+    fout.flush() ;
+    static_cast<std::ostream&>(fout).rdbuf(fout.rdbuf()) ;
+  }
+  auto end = std::chrono::high_resolution_clock::now() ;
+  return std::chrono::duration<double, std::milli>(end - start).count() ;
+}
+
+size_t
+file_size(const std::string& file)
+{
+  std::ifstream in(file, std::ios::binary | std::ios::ate) ;
+  return static_cast<size_t>(in.tellg()) ;
+}
+
+int
+benchmark(const std::string& input)
+{
+  std::ifstream in(input) ;
+  if (!in)
+    throw std::runtime_error("Cannot open '" + input + "'") ;
+  std::vector<std::string> lines ;
+  for (std::string line ; std::getline(in, line) ; )
+    lines.push_back(std::move(line)) ;
+
+  std::string output = input + ".bench" ;
+  struct { const char* name ; write_mode mode ; } modes[] = {
+    { "flush per line", write_mode::flush_per_line },
+    { "buffered",       write_mode::buffered },
+    { "compressed",     write_mode::compressed }
+  } ;
+
+  std::cout << "Lines: " << lines.size() << "\n" ;
+  for (auto& m : modes) {
+    auto ms = write_lines(lines, output, m.mode) ;
+    std::cout << std::setw(15) << m.name
+              << " write time (ms): " << std::setw(10) << ms
+              << " file size (bytes): " << std::setw(12) << file_size(output)
+              << "\n" ;
+  }
+
+  // Verify the compressed file converts back to the input
+  std::ifstream compressed(output, std::ios::binary) ;
+  std::ostringstream text ;
+  xdp::block_format::decode(compressed, text) ;
+  std::string expected ;
+  for (auto& line : lines)
+    expected.append(line).append("\n") ;
+  std::remove(output.c_str()) ;
+  if (text.str() != expected)
+    throw std::runtime_error("Converted output does not match input") ;
+
+  return 0 ;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    if (argc == 3 && argv[1] == std::string("-b"))
+      return benchmark(argv[2]) ;
+    if (argc == 2 || argc == 3)
+      return convert(argv[1], argc == 3 ? argv[2] : "") ;
+    usage() ;
+    return 1 ;
+  }
+  catch (const std::exception& ex) {
+    std::cerr << "xdp_trace_convert: " << ex.what() << "\n" ;
+  }
+  return 1 ;
+}
@@ -32,6 +32,8 @@
 
 namespace {
 
+using rect = xocl::enqueue::rect;
+
 // Exception pointer for device exceptions during enqueue tasks.  The
 // pointer is set with the exception thrown by the task.
 static std::exception_ptr s_exception_ptr;
@@ -243,6 +245,36 @@ read_image(xocl::event* event,xocl::device* device,cl_mem image,
   }
 }
 
+static void
+read_buffer_rect(xocl::event* event,xocl::device* device,cl_mem buffer,
+                 const rect& r,void* ptr)
+{
+  try {
+    event->set_status(CL_RUNNING);
+    device->read_buffer_rect(xocl::xocl(buffer),r.buffer_origin.data(),r.host_origin.data(),r.region.data()
+                             ,r.buffer_row_pitch,r.buffer_slice_pitch,r.host_row_pitch,r.host_slice_pitch,ptr);
+    event->set_status(CL_COMPLETE);
+  }
+  catch (const std::exception& ex) {
+    handle_device_exception(event,ex);
+  }
+}
+
+static void
+write_buffer_rect(xocl::event* event,xocl::device* device,cl_mem buffer,
+                  const rect& r,const void* ptr)
+{
+  try {
+    event->set_status(CL_RUNNING);
+    device->write_buffer_rect(xocl::xocl(buffer),r.buffer_origin.data(),r.host_origin.data(),r.region.data()
+                              ,r.buffer_row_pitch,r.buffer_slice_pitch,r.host_row_pitch,r.host_slice_pitch,ptr);
+    event->set_status(CL_COMPLETE);
+  }
+  catch (const std::exception& ex) {
+    handle_device_exception(event,ex);
+  }
+}
+
 static void
 write_image(xocl::event* event,xocl::device* device,cl_mem image,
 	const size_t* origin,const size_t* region, size_t row_pitch,size_t slice_pitch,
@@ -421,6 +453,32 @@ action_unmap_svm_buffer(void* svm_ptr)
   };
 }
 
+xocl::event::action_enqueue_type
+action_read_buffer_rect(cl_mem buffer,const rect& r,void* ptr)
+{
+  throw_if_error();
+  return [=](xocl::event* ev) {
+    XOCL_DEBUG(std::cout,"launching read buffer rect DMA event(",ev->get_uid(),")\n");
+    auto command_queue = ev->get_command_queue();
+    auto device = command_queue->get_device();
+    auto xdevice = device->get_xdevice();
+    xdevice->schedule(read_buffer_rect,async_type::read,ev,device,buffer,r,ptr);
+  };
+}
+
+xocl::event::action_enqueue_type
+action_write_buffer_rect(cl_mem buffer,const rect& r,const void* ptr)
+{
+  throw_if_error();
+  return [=](xocl::event* ev) {
+    XOCL_DEBUG(std::cout,"launching write buffer rect DMA event(",ev->get_uid(),")\n");
+    auto command_queue = ev->get_command_queue();
+    auto device = command_queue->get_device();
+    auto xdevice = device->get_xdevice();
+    xdevice->schedule(write_buffer_rect,async_type::write,ev,device,buffer,r,ptr);
+  };
+}
+
 xocl::event::action_enqueue_type
 action_read_image(cl_mem image,const size_t* origin,const size_t* region, size_t row_pitch,size_t slice_pitch,const void* ptr)
 {
@@ -27,10 +27,23 @@
 
 #include "xocl/core/object.h"
 #include "xocl/core/event.h"
+#include <array>
 #include <utility>
 
 namespace xocl { namespace enqueue {
 
+// Geometry of a rect read or write, copied into the enqueued action
+struct rect
+{
+  std::array<size_t,3> buffer_origin;
+  std::array<size_t,3> host_origin;
+  std::array<size_t,3> region;
+  size_t buffer_row_pitch;
+  size_t buffer_slice_pitch;
+  size_t host_row_pitch;
+  size_t host_slice_pitch;
+};
+
 xocl::event::action_enqueue_type
 action_fill_buffer(cl_mem buffer, const void* pattern, size_t pattern_size, size_t offset, size_t size);
 
@@ -62,6 +75,12 @@ action_unmap_buffer(cl_mem memobj,void* mapped_ptr);
 xocl::event::action_enqueue_type
 action_unmap_svm_buffer(void* svm_ptr);
 
+xocl::event::action_enqueue_type
+action_read_buffer_rect(cl_mem buffer,const rect& r,void* ptr);
+
+xocl::event::action_enqueue_type
+action_write_buffer_rect(cl_mem buffer,const rect& r,const void* ptr);
+
 xocl::event::action_enqueue_type
 action_read_image(cl_mem image,const size_t* origin,const size_t* region, size_t row_pitch,size_t slice_pitch,const void* ptr);
 
@@ -39,8 +39,7 @@ PrintfManager::~PrintfManager()
 
 void PrintfManager::enqueueBuffer(cl_kernel kernel, const std::vector<uint8_t>& buf)
 {
-  BufferPrintf bp(buf, xocl::xocl(kernel)->get_stringtable());
-  m_queue.push_back(bp);
+  m_queue.emplace_back(buf, xocl::xocl(kernel)->get_stringtable());
 }
 
 void PrintfManager::clear()
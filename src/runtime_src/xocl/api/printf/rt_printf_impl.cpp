@@ -44,6 +44,30 @@ namespace {
     std::ostream& m_os;
     std::ios::fmtflags m_flags;
   };
+
+  // Flush formatted text to the output stream in chunks of this size
+  const size_t printChunkSize = 64 * 1024;
+
+  // Extract a little endian value of byteCount bytes
+  uint64_t extractField(const uint8_t* buf, int byteCount)
+  {
+    uint64_t val = 0;
+    for (int i = byteCount-1; i >= 0; --i) {
+      val <<= 8;
+      val |= buf[i];
+    }
+    return val;
+  }
+
+  // Append snprintf output of a single value.  The conversion of one
+  // value is limited to 1024 characters.
+  template <typename ValueType>
+  void appendFormatted(std::string& out, const char* format, ValueType val)
+  {
+    char printBuf[1024];
+    snprintf(printBuf, sizeof(printBuf), format, val);
+    out += printBuf;
+  }
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -673,12 +697,10 @@ void FormatString::dbgDump(std::ostream& str) const
 /////////////////////////////////////////////////////////////////////////
 
 BufferPrintf::BufferPrintf()
-  : m_currentOffset(0)
 {
 }
 
 BufferPrintf::BufferPrintf(const MemBuffer& buf, const StringTable& table)
-  : m_currentOffset(0)
 {
   setBuffer(buf);
   setStringTable(table);
@@ -686,13 +708,12 @@ BufferPrintf::BufferPrintf(const MemBuffer& buf, const StringTable& table)
 
 BufferPrintf::~BufferPrintf()
 {
-  m_currentOffset = 0;
   m_buf.clear();
   m_stringTable.clear();
+  m_formatCache.clear();
 }
 
 BufferPrintf::BufferPrintf(const uint8_t* buf, size_t bufLen, const StringTable& table)
-  : m_currentOffset(0)
 {
   setBuffer(buf, bufLen);
   setStringTable(table);
@@ -718,40 +739,42 @@ void BufferPrintf::setBuffer(const MemBuffer& buf)
 void BufferPrintf::setStringTable(const StringTable& table)
 {
   m_stringTable = table;
+  m_formatCache.clear();
 }
 
 void BufferPrintf::print(std::ostream& os)
 {
-  moveToFirstRecord();
-  while ( hasNextRecord() ) {
-    std::string formatStr = getFormat();
-    FormatString format(formatStr);
-    if ( format.isValid() ) {
-      std::vector<XCL::Printf::ConversionSpec> conversionVec;
-      format.getSpecifiers(conversionVec);
-      std::vector<PrintfArg> argVec;
-      int argOffset = getFormatByteCount();
-      for ( auto conversion : conversionVec ) {
-        PrintfArg arg = buildArg(m_currentOffset + argOffset, conversion);
-        argVec.push_back(arg);
-        argOffset += getElementByteCount(conversion) * conversion.m_vectorSize;
-        // HACK: Special handling for vec3 packed strangely from compiler
-        //    float3 += 32 bits
-        //    others += 64 bits
-        if ( conversion.isVector() && conversion.m_vectorSize == 3) {
-          if ( conversion.isFloatClass() ) {
-            argOffset += 4;
-          }
-          else {
-            argOffset += 8;
-          }
-        }
-      }
-      std::string result = string_printf(formatStr, argVec);
+  std::string result;
+  int offset = nextRecordOffset(0);
+  while ( offset != -1 ) {
+    uint32_t id = (uint32_t)extractField(offset, getFormatByteCount());
+    const CompiledFormat& format = getCompiledFormat(id);
+    size_t argOffset = offset + getFormatByteCount();
+    if ( !format.isValid() || argOffset + format.getArgByteCount() > m_buf.size() ) {
+      os << result;
+      std::string msg = "print - Invalid format: ";
+      msg += m_stringTable[id];
+      throwError(msg);
+    }
+    format.format(m_buf.data() + argOffset, result);
+    if ( result.size() >= printChunkSize ) {
       os << result;
+      result.clear();
     }
-    nextRecord();
+    offset = nextRecordOffset(argOffset + format.getArgByteCount());
   }
+  os << result;
+}
+
+const CompiledFormat& BufferPrintf::getCompiledFormat(uint32_t id)
+{
+  auto found = m_formatCache.find(id);
+  if ( found != m_formatCache.end() ) {
+    return found->second;
+  }
+  std::string formatStr;
+  lookup(id, formatStr);
+  return m_formatCache.emplace(id, CompiledFormat(formatStr)).first->second;
 }
 
 void BufferPrintf::dbgDump(std::ostream& os) const
@@ -858,70 +881,6 @@ int BufferPrintf::nextRecordOffset(int currentOffset) const
   return offset;
 }
 
-bool BufferPrintf::hasNextRecord() const
-{
-  bool eof = (nextRecordOffset(m_currentOffset) == -1);
-  return ( !eof );
-}
-
-
-void BufferPrintf::moveToFirstRecord()
-{
-  if ( hasNextRecord() ) {
-    m_currentOffset = nextRecordOffset(0);
-  }
-}
-
-void BufferPrintf::nextRecord()
-{
-  // Assume we are pointing at a valid record and want to move to the next one
-  if (! hasNextRecord() ) {
-    throwError("nextRecord - No next record");
-  }
-
-  std::string formatStr = getFormat();
-  FormatString format(formatStr);
-  if ( !format.isValid() ) {
-    std::string msg = "nextRecord - Invalid format: ";
-    msg += formatStr;
-    throwError(msg);
-  }
-  std::vector<ConversionSpec> conversionVec;
-  format.getSpecifiers(conversionVec);
-  // skip format ID
-  m_currentOffset += getFormatByteCount();
-  // Skip all arguments
-  for (auto conversion : conversionVec) {
-    m_currentOffset += getElementByteCount(conversion) * conversion.m_vectorSize;
-    // HACK: Special handling for vec3 packed strangely from compiler
-    //    float3 += 32 bits
-    //    others += 64 bits
-    if ( conversion.isVector() && conversion.m_vectorSize == 3) {
-      if ( conversion.isFloatClass() ) {
-        m_currentOffset += 4;
-      }
-      else {
-        m_currentOffset += 8;
-      }
-    }
-  }
-  m_currentOffset = nextRecordOffset(m_currentOffset);
-}
-
-std::string BufferPrintf::getFormat() const
-{
-  uint32_t id = getFormatID();
-  std::string retval;
-  lookup(id, retval);
-  return retval;
-}
-
-uint32_t BufferPrintf::getFormatID() const
-{
-  uint32_t id = (uint32_t)extractField(m_currentOffset, getFormatByteCount());
-  return id;
-}
-
 void BufferPrintf::lookup(int id, std::string& retval) const
 {
   auto found = m_stringTable.find(id);
@@ -937,78 +896,14 @@ void BufferPrintf::lookup(int id, std::string& retval) const
 
 uint64_t BufferPrintf::extractField(int idx, int byteCount) const
 {
-  uint64_t val = 0;
-  for (int i = byteCount-1; i >= 0; --i) {
-    val <<= 8;
-    val |= m_buf[idx+i];
-  }
-  return val;
+  return ::extractField(m_buf.data() + idx, byteCount);
 }
 
-PrintfArg BufferPrintf::buildArg(int bufIdx, ConversionSpec& conversion) const
-{
-  int elementBytes = getElementByteCount(conversion);
-  if ( conversion.isIntClass() ) {
-    if ( conversion.isVector() ) {
-      std::vector<uint64_t> vec;
-      for ( int i = 0; i < conversion.m_vectorSize; ++i ) {
-        uint64_t val = extractField(bufIdx + i*elementBytes, elementBytes);
-        vec.push_back(val);
-      }
-      PrintfArg arg(vec);
-      return arg;
-    }
-    else {
-      uint64_t val = extractField(bufIdx, elementBytes);
-      PrintfArg arg(val);
-      return arg;
-    }
-  }
-  else if ( conversion.isFloatClass() ) {
-    if ( conversion.isVector() ) {
-      std::vector<float> vec;
-      for ( int i = 0; i < conversion.m_vectorSize; ++i ) {
-        float val = 0;
-        uint8_t *ptr = (uint8_t*)&val;
-        for ( int ii = elementBytes-1; ii >= 0; --ii ) {
-          ptr[ii] = m_buf[bufIdx+ii+(i*elementBytes)];
-        }
-        vec.push_back(val);
-      }
-      PrintfArg arg(vec);
-      return arg;
-    }
-    else {
-      double val = 0;
-      uint8_t *ptr = (uint8_t*)&val;
-      for ( int i = elementBytes-1; i >= 0; --i ) {
-        ptr[i] = m_buf[bufIdx+i];
-      }
-      PrintfArg arg(val);
-      return arg;
-    }
-  }
-  else if ( conversion.isStringClass() ) {
-    /*uint64_t idx = */ (void)extractField(bufIdx, elementBytes);
-    std::string str = "";
-    // Temporary error - remove when %s works
-    std::cout << std::endl << "ERROR: Printf conversion specifier '%s' is not allowed" << std::endl;
-//    lookup(idx, str);
-    PrintfArg arg(str);
-    return arg;
-  }
-  // TODO: probably best to throw an exception here...
-  PrintfArg arg(0);
-  return arg;
-}
-
-
 /////////////////////////////////////////////////////////////////////////
 
-std::string convertArg(PrintfArg& arg, ConversionSpec& conversion)
+// Build the snprintf format for a single value of a conversion
+static void buildConversionFormat(const ConversionSpec& conversion, char* formatStr)
 {
-  std::string retval = "";
-  char formatStr[32];
   strcpy(formatStr, "%");
   if (conversion.m_leftJustify)
     strcat(formatStr, "-");
@@ -1055,6 +950,13 @@ std::string convertArg(PrintfArg& arg, ConversionSpec& conversion)
 
   strcat(formatStr, " ");
   formatStr[strlen(formatStr)-1] = conversion.m_specifier;
+}
+
+std::string convertArg(PrintfArg& arg, ConversionSpec& conversion)
+{
+  std::string retval = "";
+  char formatStr[32];
+  buildConversionFormat(conversion, formatStr);
   // TODO: later make this dynamically size... for now 1024 should be sufficient
   int bufLen = 1024;
   char *printBuf = new char[bufLen];
@@ -1151,6 +1053,99 @@ std::string string_printf(const std::string& formatStr, std::vector<PrintfArg> a
   return retval;
 }
 
+/////////////////////////////////////////////////////////////////////////
+
+CompiledFormat::CompiledFormat(const std::string& format)
+  : m_valid(false)
+  , m_argBytes(0)
+{
+  FormatString formatString(format);
+  if ( !formatString.isValid() ) {
+    return;
+  }
+  std::vector<ConversionSpec> specVec;
+  formatString.getSpecifiers(specVec);
+  formatString.getSplitFormatString(m_text);
+
+  for ( auto& spec : specVec ) {
+    Conversion conversion;
+    conversion.m_vectorSize = spec.m_vectorSize;
+    conversion.m_elementBytes = BufferPrintf::getElementByteCount(spec);
+    conversion.m_byteCount = conversion.m_elementBytes * spec.m_vectorSize;
+    // HACK: Special handling for vec3 packed strangely from compiler
+    //    float3 += 32 bits
+    //    others += 64 bits
+    if ( spec.isVector() && spec.m_vectorSize == 3) {
+      conversion.m_byteCount += spec.isFloatClass() ? 4 : 8;
+    }
+    if ( spec.isIntClass() ) {
+      conversion.m_kind = spec.isVector() ? AK_INTVEC : AK_INT;
+    }
+    else if ( spec.isFloatClass() ) {
+      conversion.m_kind = spec.isVector() ? AK_FLOATVEC : AK_FLOAT;
+    }
+    else if ( spec.isStringClass() ) {
+      conversion.m_kind = AK_STR;
+    }
+    else {
+      conversion.m_kind = AK_OTHER;
+    }
+    buildConversionFormat(spec, conversion.m_format);
+    m_argBytes += conversion.m_byteCount;
+    m_conversions.push_back(conversion);
+  }
+  m_valid = true;
+}
+
+void CompiledFormat::format(const uint8_t* args, std::string& out) const
+{
+  out += m_text[0];
+  for ( size_t idx = 0; idx < m_conversions.size(); ++idx ) {
+    const Conversion& conversion = m_conversions[idx];
+    switch ( conversion.m_kind ) {
+      case AK_INT: {
+        appendFormatted(out, conversion.m_format, extractField(args, conversion.m_elementBytes));
+        break;
+      }
+      case AK_INTVEC: {
+        for ( int i = 0; i < conversion.m_vectorSize; ++i ) {
+          if (i) out += ",";
+          appendFormatted(out, conversion.m_format,
+                          extractField(args + i*conversion.m_elementBytes, conversion.m_elementBytes));
+        }
+        break;
+      }
+      case AK_FLOAT: {
+        double val = 0;
+        std::memcpy(&val, args, sizeof(val));
+        appendFormatted(out, conversion.m_format, val);
+        break;
+      }
+      case AK_FLOATVEC: {
+        for ( int i = 0; i < conversion.m_vectorSize; ++i ) {
+          if (i) out += ",";
+          float val = 0;
+          std::memcpy(&val, args + i*conversion.m_elementBytes, sizeof(val));
+          appendFormatted(out, conversion.m_format, static_cast<double>(val));
+        }
+        break;
+      }
+      case AK_STR: {
+        // Temporary error - remove when %s works
+        std::cout << std::endl << "ERROR: Printf conversion specifier '%s' is not allowed" << std::endl;
+        appendFormatted(out, conversion.m_format, "");
+        break;
+      }
+      case AK_OTHER: {
+        appendFormatted(out, conversion.m_format, static_cast<int64_t>(0));
+        break;
+      }
+    }
+    args += conversion.m_byteCount;
+    out += m_text[idx+1];
+  }
+}
+
 void throwError(const std::string& errorMsg)
 {
   throw std::runtime_error(errorMsg);
@@ -213,6 +213,48 @@ struct PrintfArg
     std::string toString() const;
 };
 
+/////////////////////////////////////////////////////////////////////////
+// CompiledFormat -
+//
+// A format string compiled once into the text between conversion
+// specifiers, and for each conversion the snprintf format to use and
+// the layout of its argument in a printf buffer record.  Formatting a
+// record is then a loop over the conversions that appends directly to
+// an output string, without parsing the format string or building
+// PrintfArg objects.
+class CompiledFormat {
+
+public:
+    enum ArgKind {
+      AK_INT, AK_INTVEC, AK_FLOAT, AK_FLOATVEC, AK_STR, AK_OTHER
+    };
+
+    struct Conversion {
+      ArgKind m_kind;
+      int m_vectorSize;
+      int m_elementBytes;  // bytes per vector element
+      int m_byteCount;     // bytes of the argument in the record
+      char m_format[32];   // snprintf format for one element
+    };
+
+public:
+    CompiledFormat(const std::string& format);
+
+    bool isValid() const { return m_valid; }
+
+    // Bytes of the arguments of a record that uses this format
+    size_t getArgByteCount() const { return m_argBytes; }
+
+    // Format the arguments of one record and append the text to out
+    void format(const uint8_t* args, std::string& out) const;
+
+private:
+    bool m_valid;
+    size_t m_argBytes;
+    std::vector<std::string> m_text;
+    std::vector<Conversion> m_conversions;
+};
+
 /////////////////////////////////////////////////////////////////////////
 // BufferPrintf -
 //
@@ -233,6 +275,8 @@ struct PrintfArg
 //     Arguments   N*64   Arguments, N is number of aguments
 //     0xFF filling to end of buffer
 //
+// Format strings are compiled when first used and cached by Format_ID.
+//
 // TODO: - Exception when invalid format_id is found in record
 //
 class BufferPrintf {
@@ -268,36 +312,20 @@ public:
     static int getFormatByteCount() { return 8; }
 
 private:
-    // Set the current offset to the first record
-    void moveToFirstRecord();
-
-    // Returns offset of next record or -1 if no more records found
+    // Returns offset of next record or -1 if no more records found.
+    // Either the offset is a record start position -or- it is on the
+    // gap between records (because we advanced to the first byte after
+    // the last record which lies in the gap between work item segments).
     int nextRecordOffset(int currentOffset) const;
 
-    // Returns true if we have another record, false if no more exist
-    bool hasNextRecord() const;
-
-    // Move m_currentOffset to the next record start. Assumes we are either
-    // on a record start position -or- we are positioned on the gap between
-    // records (because we advanced to the first byte after the last record
-    // which lies in the gap between work item segments).
-    void nextRecord();
-
-    // Extracts the Format for the current record
-    std::string getFormat() const;
-
-    // Extracts the Format_ID for the current record
-    uint32_t getFormatID() const;
+    // Returns the compiled format string with the given Format_ID
+    const CompiledFormat& getCompiledFormat(uint32_t id);
 
     // Find an ID in the string table and return the string 
     void lookup(int id, std::string& retval) const;
 
     // Extract a value from buffer
     uint64_t extractField(int idx, int byteCount) const;
-
-    // Build up a printf argument given the conversion specifier
-    // and memory buffer and string table
-    PrintfArg buildArg(int bufIdx, ConversionSpec& conversion) const;
     
     // Convert escape sequences \n, \r, \t, \ to text representation
     // Newline replaced by string: "\n"
@@ -306,10 +334,9 @@ private:
     static std::string escape(const std::string& s);
 
 private:
-    // currentOffset always points at the current format string
-    int m_currentOffset;
     MemBuffer m_buf;
     StringTable m_stringTable;
+    std::map<uint32_t,CompiledFormat> m_formatCache;
 };
 
 
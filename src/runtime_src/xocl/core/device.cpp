@@ -30,6 +30,7 @@
 #include "core/common/query_requests.h"
 #include "core/common/xclbin_parser.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -823,6 +824,100 @@ fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t off
   unmap_buffer(buffer,hbuf);
 }
 
+// Contiguous byte ranges of a buffer touched by a rect operation.
+// Rows that are at most max_gap bytes apart are merged, syncing a
+// small gap is cheaper than an extra DMA transfer.  Only reads can
+// merge across a gap, a write must not push the host copy of bytes
+// outside the rect to the device.
+static std::vector<std::pair<size_t,size_t>>
+rect_spans(size_t offset,const size_t* region,size_t row_pitch,size_t slice_pitch,size_t max_gap)
+{
+  std::vector<std::pair<size_t,size_t>> spans;
+  for (size_t z=0; z<region[2]; ++z) {
+    for (size_t y=0; y<region[1]; ++y) {
+      auto row = offset + z*slice_pitch + y*row_pitch;
+      if (!spans.empty() && row <= spans.back().first + spans.back().second + max_gap) {
+        auto end = std::max(spans.back().first + spans.back().second, row + region[0]);
+        spans.back().second = end - spans.back().first;
+        continue;
+      }
+      spans.emplace_back(row,region[0]);
+    }
+  }
+  return spans;
+}
+
+static void
+rw_buffer_rect(device* device,memory* buffer,
+               const size_t* buffer_origin,const size_t* host_origin,const size_t* region,
+               size_t buffer_row_pitch,size_t buffer_slice_pitch,
+               size_t host_row_pitch,size_t host_slice_pitch,
+               char* read_to,const char* write_from)
+{
+  auto boh = buffer->get_buffer_object(device);
+  auto xdevice = device->get_xdevice();
+
+  size_t buffer_offset = buffer_origin[2]*buffer_slice_pitch
+    + buffer_origin[1]*buffer_row_pitch + buffer_origin[0];
+  size_t host_offset = host_origin[2]*host_slice_pitch
+    + host_origin[1]*host_row_pitch + host_origin[0];
+  auto spans = rect_spans(buffer_offset,region,buffer_row_pitch,buffer_slice_pitch,read_to ? 4096 : 0);
+  bool sync = buffer->is_resident(device) && !buffer->no_host_memory();
+
+  if (read_to && sync)
+    for (auto& span : spans)
+      xdevice->sync(boh,span.second,span.first,xrt_xocl::hal::device::direction::DEVICE2HOST,false);
+
+  auto hbuf = static_cast<char*>(xdevice->map(boh));
+
+  // Host pointer of buffer that is separate from the buffer object
+  // gets the rect rows only, a span may include gap bytes that the
+  // application owns
+  char* ubuf = nullptr;
+  if (buffer->need_extra_sync() && buffer->get_host_ptr() != hbuf)
+    ubuf = static_cast<char*>(buffer->get_host_ptr());
+
+  for (size_t z=0; z<region[2]; ++z) {
+    for (size_t y=0; y<region[1]; ++y) {
+      auto boffset = buffer_offset + z*buffer_slice_pitch + y*buffer_row_pitch;
+      auto hoffset = host_offset + z*host_slice_pitch + y*host_row_pitch;
+      if (read_to)
+        std::memcpy(read_to+hoffset,hbuf+boffset,region[0]);
+      else
+        std::memcpy(hbuf+boffset,write_from+hoffset,region[0]);
+      if (ubuf)
+        std::memcpy(ubuf+boffset,hbuf+boffset,region[0]);
+    }
+  }
+  xdevice->unmap(boh);
+
+  if (write_from && sync)
+    for (auto& span : spans)
+      xdevice->sync(boh,span.second,span.first,xrt_xocl::hal::device::direction::HOST2DEVICE,false);
+}
+
+void
+device::
+write_buffer_rect(memory* buffer,const size_t* buffer_origin,const size_t* host_origin,const size_t* region,
+                  size_t buffer_row_pitch,size_t buffer_slice_pitch,
+                  size_t host_row_pitch,size_t host_slice_pitch,const void* ptr)
+{
+  rw_buffer_rect(this,buffer,buffer_origin,host_origin,region
+                 ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch
+                 ,nullptr,static_cast<const char*>(ptr));
+}
+
+void
+device::
+read_buffer_rect(memory* buffer,const size_t* buffer_origin,const size_t* host_origin,const size_t* region,
+                 size_t buffer_row_pitch,size_t buffer_slice_pitch,
+                 size_t host_row_pitch,size_t host_slice_pitch,void* ptr)
+{
+  rw_buffer_rect(this,buffer,buffer_origin,host_origin,region
+                 ,buffer_row_pitch,buffer_slice_pitch,host_row_pitch,host_slice_pitch
+                 ,static_cast<char*>(ptr),nullptr);
+}
+
 static void
 rw_image(device* device,
          memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch
@@ -414,6 +414,31 @@ public:
   void
   fill_buffer(memory* buffer, const void* pattern, size_t pattern_size, size_t offset, size_t size);
 
+  /**
+   * Write a 2D or 3D region of host memory to a rectangular region of buffer
+   *
+   * Only the byte ranges of buffer covered by the region are synced
+   * to device, and only if the buffer is currently resident on the
+   * device.  Origins, region and pitches are in bytes as in
+   * clEnqueueWriteBufferRect, with pitches already defaulted.
+   */
+  void
+  write_buffer_rect(memory* buffer,const size_t* buffer_origin,const size_t* host_origin,const size_t* region,
+                    size_t buffer_row_pitch,size_t buffer_slice_pitch,
+                    size_t host_row_pitch,size_t host_slice_pitch,const void* ptr);
+
+  /**
+   * Read a rectangular region of buffer into a 2D or 3D region of host memory
+   *
+   * Only the byte ranges of buffer covered by the region are synced
+   * from device, and only if the buffer is currently resident on the
+   * device.
+   */
+  void
+  read_buffer_rect(memory* buffer,const size_t* buffer_origin,const size_t* host_origin,const size_t* region,
+                   size_t buffer_row_pitch,size_t buffer_slice_pitch,
+                   size_t host_row_pitch,size_t host_slice_pitch,void* ptr);
+
   void
   write_image(memory* image,const size_t* origin,const size_t* region,size_t row_pitch,size_t slice_pitch,const void *ptr);
 
@@ -0,0 +1,161 @@
+/**
+ * Copyright (C) 2021 Xilinx, Inc
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+////////////////////////////////////////////////////////////////
+// Unit testing and contention benchmark of task queues in
+// xrt/util/task.h.  Compares the work stealing task::queue with
+// the single lock task::mpmcqueue.
+////////////////////////////////////////////////////////////////
+#include <boost/test/unit_test.hpp>
+
+#include "xrt/util/task.h"
+#include "xrt/util/time.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE ( test_queue )
+
+namespace {
+
+using task_type = xrt_xocl::task::task;
+
+// Consumer loop, same as task::worker but for any queue type
+template <typename Queue>
+static void
+consume(Queue& q)
+{
+  while (true) {
+    auto t = q.getWork();
+    if (!t.valid())
+      break;
+    t();
+  }
+}
+
+// Run 'producers' threads each adding 'tasks' tiny tasks to a queue
+// serviced by 'consumers' threads.  Returns elapsed time in ms.
+template <typename Queue>
+static double
+contention(unsigned int producers, unsigned int consumers, unsigned int tasks)
+{
+  Queue q;
+  std::atomic<unsigned long> executed {0};
+
+  auto start = xrt_xocl::time_ns();
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < consumers; ++i)
+    workers.emplace_back(consume<Queue>, std::ref(q));
+
+  std::vector<std::thread> senders;
+  for (unsigned int i = 0; i < producers; ++i)
+    senders.emplace_back([&q, &executed, tasks] {
+      for (unsigned int j = 0; j < tasks; ++j)
+        q.addWork(task_type([&executed] { ++executed; }));
+    });
+
+  for (auto& t : senders)
+    t.join();
+
+  unsigned long total = static_cast<unsigned long>(producers) * tasks;
+  while (executed < total)
+    std::this_thread::yield();
+
+  auto elapsed = (xrt_xocl::time_ns() - start) * 1e-6;
+
+  q.stop();
+  for (auto& t : workers)
+    t.join();
+
+  BOOST_CHECK_EQUAL(executed, total);
+  return elapsed;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_fifo )
+{
+  // Single consumer must see tasks in order they were added
+  xrt_xocl::task::queue q;
+  std::vector<int> order;
+  std::thread worker(xrt_xocl::task::worker, std::ref(q));
+
+  std::vector<xrt_xocl::task::event<void>> events;
+  for (int i = 0; i < 1000; ++i)
+    events.push_back(xrt_xocl::task::createF(q, [&order, i] { order.push_back(i); }));
+  for (auto& ev : events)
+    ev.wait();
+
+  q.stop();
+  worker.join();
+
+  BOOST_CHECK_EQUAL(order.size(), 1000);
+  for (int i = 0; i < 1000; ++i)
+    BOOST_CHECK_EQUAL(order[i], i);
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_consumer_exit )
+{
+  // Lanes of exited consumers are reused by new consumers and tasks
+  // left in them are not lost
+  xrt_xocl::task::queue q;
+  std::atomic<unsigned int> executed {0};
+  for (int i = 0; i < 200; ++i) {
+    q.addWork(task_type([&executed] { ++executed; }));
+    q.addWork(task_type([&executed] { ++executed; }));
+    std::thread consumer([&q] {
+      auto t = q.getWork();
+      t();
+    });
+    consumer.join();
+  }
+  BOOST_CHECK_EQUAL(q.size(), 200);
+
+  std::thread worker(xrt_xocl::task::worker, std::ref(q));
+  while (executed < 400)
+    std::this_thread::yield();
+  q.stop();
+  worker.join();
+  BOOST_CHECK_EQUAL(executed, 400);
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_many_consumers )
+{
+  // More consumers than cpus, every consumer has its own lane
+  constexpr unsigned int consumers = 100;
+  auto elapsed = contention<xrt_xocl::task::queue>(4, consumers, 10000);
+  BOOST_CHECK(elapsed > 0);
+}
+
+BOOST_AUTO_TEST_CASE( test_queue_contention )
+{
+  constexpr unsigned int tasks = 100000;
+  unsigned int cpus = std::max(2u, std::thread::hardware_concurrency());
+
+  for (auto threads : { 1u, 2u, 4u, cpus / 2, cpus }) {
+    auto mpmc = contention<xrt_xocl::task::mpmcqueue<task_type>>(threads, threads, tasks);
+    auto steal = contention<xrt_xocl::task::queue>(threads, threads, tasks);
+    std::cout << "producers/consumers: " << threads
+              << " mpmcqueue (ms): " << mpmc
+              << " stealing_queue (ms): " << steal
+              << "\n";
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,7 @@ int32_t get_cu_index(int32_t dev_index, char* cu_name);
 int32_t get_default_ddr_index(int32_t dev_index, int32_t cu_index);
 
 int32_t check_all_execbo(XmaSession s_handle);
+void notify_cmd_submitted(XmaSession s_handle);
 void logmsg(XmaLogLevelType level, const std::string& tag, const std::string& msg);
 
 } // namespace utils
@@ -37,6 +37,7 @@
 #include <chrono>
 #include <list>
 #include <condition_variable>
+#include <mutex>
 
 #define MAX_EXECBO_BUFF_SIZE      4096// 4KB
 #define MAX_KERNEL_REGMAP_SIZE    4032//Some space used by ert pkt
@@ -183,6 +184,7 @@ typedef struct XmaHwSessionPrivate
     std::condition_variable work_item_done_1plus;//Use with xma_plg_work_item_done
     std::condition_variable execbo_is_free; //Use with xma_plg_schedule_work_item and xma_plg_schedule_cu_cmd
     std::condition_variable kernel_done_or_free;//Use with xma_plg_cu_cmd_status; CU completion is must every outstanding cmd;
+    std::atomic<uint64_t> cmd_complete_seq;//Incremented on every cu cmd completion; Wait predicate for above condition variables
     xclBufferHandle  last_execbo_handle;
 
     std::vector<uint32_t> execbo_lru;
@@ -190,6 +192,7 @@ typedef struct XmaHwSessionPrivate
     bool     using_work_item_done;
     bool     using_cu_cmd_status;
     std::atomic<bool> execbo_locked;
+    bool     cmd_pending_listed;//In sessions_pending of the device; Use device cmd_notify lock
     std::vector<XmaHwExecBO> kernel_execbos;
     int32_t    num_execbo_allocated;
     std::list<XmaBufferPool>   buffer_pools;
@@ -201,6 +204,7 @@ typedef struct XmaHwSessionPrivate
     kernel_info = NULL;
     kernel_complete_count = 0;
     kernel_complete_total = 0;
+    cmd_complete_seq = 0;
     device = NULL;
     num_cu_cmds = 0;
     num_cu_cmds_avg = 0;
@@ -213,6 +217,7 @@ typedef struct XmaHwSessionPrivate
     cmd_busy_ticks_tmp = 0;
     cmd_idle_ticks_tmp = 0;
     execbo_locked = false;
+    cmd_pending_listed = false;
     num_execbo_allocated = -1;
     using_work_item_done = false;
     using_cu_cmd_status = false;
@@ -333,6 +338,13 @@ typedef struct XmaHwMem
   }
 } XmaHwMem;
 
+typedef struct XmaHwCmdNotify
+{
+    std::mutex m_mutex;
+    std::condition_variable cmd_submitted;//xma_thread2 sleeps on this while device has no outstanding cu cmd
+    std::vector<XmaSession> sessions_pending;//Sessions of this device with cu cmds in-progress; Only these are checked on cu completion
+} XmaHwCmdNotify;
+
 typedef struct XmaHwDevice
 {
     //char        dsa[MAX_DSA_NAME];
@@ -350,10 +362,11 @@ typedef struct XmaHwDevice
     uint32_t    cu_cmd_id2;//Counter
     std::mt19937 mt_gen;
     std::uniform_int_distribution<int32_t> rnd_dis;
+    std::shared_ptr<XmaHwCmdNotify> cmd_notify;//Shared as XmaHwDevice must stay copyable
 
     uint32_t    reserved[16];
 
-  XmaHwDevice(): rnd_dis(-97986387, 97986387) {
+  XmaHwDevice(): rnd_dis(-97986387, 97986387), cmd_notify(std::make_shared<XmaHwCmdNotify>()) {
     dev_index = -1;
     number_of_cus = 0;
     number_of_hardware_kernels = 0;
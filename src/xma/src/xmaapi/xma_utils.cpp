@@ -560,6 +560,7 @@ int32_t check_all_execbo(XmaSession s_handle) {
                             priv1->kernel_complete_count++;
                             priv1->kernel_complete_total++;
                         }
+                        priv1->cmd_complete_seq++;
                         notify_execbo_is_free = true;
                         ebo.in_use = false;
                         cu_cmd->state = ERT_CMD_STATE_MAX;
@@ -572,6 +573,7 @@ int32_t check_all_execbo(XmaSession s_handle) {
                             priv1->kernel_complete_count++;
                             priv1->kernel_complete_total++;
                         }
+                        priv1->cmd_complete_seq++;
                         notify_execbo_is_free = true;
                         ebo.in_use = false;
                         cu_cmd->state = ERT_CMD_STATE_MAX;
@@ -602,7 +604,11 @@ int32_t check_all_execbo(XmaSession s_handle) {
         }
         //In this mode schedule_work_item still waits for this
         if (notify_execbo_is_free) {
+            //Waiters check their predicate under m_mutex; Taking it here ensures the wakeup is not lost
+            std::lock_guard<std::mutex> lk(priv1->m_mutex);
             priv1->execbo_is_free.notify_all();
+            priv1->work_item_done_1plus.notify_one();
+            priv1->kernel_done_or_free.notify_all();
         }
     } else {
         if (priv1->num_cu_cmds != 0) {
@@ -620,6 +626,7 @@ int32_t check_all_execbo(XmaSession s_handle) {
                             priv1->kernel_complete_count++;
                             priv1->kernel_complete_total++;
                         }
+                        priv1->cmd_complete_seq++;
                         ebo.in_use = false;
                         cu_cmd->state = ERT_CMD_STATE_MAX;
                         notify_work_item_done_1plus = true;
@@ -635,6 +642,7 @@ int32_t check_all_execbo(XmaSession s_handle) {
                             priv1->kernel_complete_count++;
                             priv1->kernel_complete_total++;
                         }
+                        priv1->cmd_complete_seq++;
                         notify_execbo_is_free = true;
                         notify_work_item_done_1plus = true;
                         ebo.in_use = false;
@@ -668,22 +676,27 @@ int32_t check_all_execbo(XmaSession s_handle) {
                 }
             }
 
+            //Waiters check their predicate under m_mutex; Taking it here ensures the wakeup is not lost
+            std::unique_lock<std::mutex> lk(priv1->m_mutex);
             if (notify_execbo_is_free) {
                 priv1->execbo_is_free.notify_all();
             }
             if (notify_work_item_done_1plus) {
                 priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
                 priv1->kernel_done_or_free.notify_all();
+                lk.unlock();
                 if (priv1->slowest_element) {
                     std::this_thread::yield();
                 }
             } else if (priv1->kernel_complete_count != 0) {
                 priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
+                lk.unlock();
                 if (priv1->slowest_element) {
                     std::this_thread::yield();
                 }
             }
         } else {
+            std::lock_guard<std::mutex> lk(priv1->m_mutex);
             priv1->work_item_done_1plus.notify_one();//Unblock one thread;Though only one is used anyway
             priv1->kernel_done_or_free.notify_all();
             priv1->execbo_is_free.notify_all();
@@ -693,6 +706,20 @@ int32_t check_all_execbo(XmaSession s_handle) {
     return XMA_SUCCESS;
 }
 
+void notify_cmd_submitted(XmaSession s_handle) {
+    //Route cu completions of the device to this session; Wake up xma_thread2 of the device if it is waiting for a cu cmd
+    XmaHwSessionPrivate *priv1 = (XmaHwSessionPrivate*) s_handle.hw_session.private_do_not_use;
+    auto notify = priv1->device->cmd_notify;
+    {
+        std::lock_guard<std::mutex> lk(notify->m_mutex);
+        if (!priv1->cmd_pending_listed) {
+            priv1->cmd_pending_listed = true;
+            notify->sessions_pending.emplace_back(s_handle);
+        }
+    }
+    notify->cmd_submitted.notify_one();
+}
+
 void logmsg(XmaLogLevelType level, const std::string& tag, const std::string& msg) {
     //TODO
     return;
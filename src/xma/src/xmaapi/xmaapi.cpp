@@ -258,41 +258,62 @@ void xma_thread2(uint32_t hw_dev_index) {
 
     bool expected = false;
     bool desired = true;
-    xclDeviceHandle dev_handle = g_xma_singleton->hwcfg.devices[hw_dev_index].handle;
+    XmaHwDevice *device = &g_xma_singleton->hwcfg.devices[hw_dev_index];
+    xclDeviceHandle dev_handle = device->handle;
+    auto cmd_notify = device->cmd_notify;
+    std::vector<XmaSession> sessions;
     while (!g_xma_singleton->xma_exit) {
-        if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(3));
-        } else {
-            xclExecWait(dev_handle, 100);
+        {
+            //Sleep until a session of this device submits a cu cmd
+            std::unique_lock<std::mutex> lk(cmd_notify->m_mutex);
+            cmd_notify->cmd_submitted.wait(lk, [cmd_notify] {
+                return !cmd_notify->sessions_pending.empty() || g_xma_singleton->xma_exit;
+            });
         }
+        if (g_xma_singleton->xma_exit) {
+            break;
+        }
+
+        //Block until a cu cmd of this device completes; Timeout only as safety net if cu is hung
+        xclExecWait(dev_handle, 100);
 
-        for (auto& itr1: g_xma_singleton->all_sessions_vec) {
+        //Completion is routed to the sessions with cu cmds in-progress; Other sessions are not checked
+        {
+            std::lock_guard<std::mutex> lk(cmd_notify->m_mutex);
+            sessions = cmd_notify->sessions_pending;
+        }
+        for (auto& itr1: sessions) {
             if (g_xma_singleton->xma_exit) {
                 break;
             }
             XmaHwSessionPrivate *priv1 = (XmaHwSessionPrivate*) itr1.hw_session.private_do_not_use;
+            //execbo lock is only held briefly by the session; Wait for it so that completion is not missed
             expected = false;
-/*
             while (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
                 std::this_thread::yield();
                 expected = false;
             }
-*/
-            if (!priv1->execbo_locked.compare_exchange_weak(expected, desired)) {
-                continue;
-            }
             //execbo lock acquired
 
             if (xma_core::utils::check_all_execbo(itr1) != XMA_SUCCESS) {
                 xma_logmsg(XMA_ERROR_LOG, XMAAPI_MOD, "XMA thread2 failed-4. Unexpected error\n");
-                //Release execbo lock
-                priv1->execbo_locked = false;
-                continue;
             }
 
             //Release execbo lock
             priv1->execbo_locked = false;
         }
+
+        //A session is listed again by its next cu cmd submission
+        std::lock_guard<std::mutex> lk(cmd_notify->m_mutex);
+        auto& pending = cmd_notify->sessions_pending;
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [](const XmaSession& s) {
+            XmaHwSessionPrivate *priv1 = (XmaHwSessionPrivate*) s.hw_session.private_do_not_use;
+            if (priv1->num_cu_cmds != 0) {
+                return false;
+            }
+            priv1->cmd_pending_listed = false;
+            return true;
+        }), pending.end());
     }
 }
 
@@ -447,6 +468,11 @@ void xma_exit(void)
     if (!g_xma_singleton->xma_initialized) {
         return;
     }
+    //Wake up xma_thread2 sleeping for a cu cmd
+    for (auto& hw_device: g_xma_singleton->hwcfg.devices) {
+        std::lock_guard<std::mutex> lk(hw_device.cmd_notify->m_mutex);
+        hw_device.cmd_notify->cmd_submitted.notify_all();
+    }
     try {
         if (g_xma_singleton->thread1_future.valid())
             g_xma_singleton->thread1_future.wait();
@@ -544,9 +544,9 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
     bool desired = true;
     int32_t bo_idx = -1;
     //With KDS2.0 ensure no outstanding command
-    while (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
+    if (!g_xma_singleton->kds_old) {
         std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->kernel_done_or_free.wait_for(lk, std::chrono::milliseconds(1));
+        priv1->kernel_done_or_free.wait(lk, [priv1] { return priv1->num_cu_cmds == 0; });
     }
 
     // Find an available execBO buffer
@@ -557,6 +557,8 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
             std::this_thread::yield();
             expected = false;
         }
+        //execbo is freed only by a cu cmd completion
+        uint64_t complete_seq = priv1->cmd_complete_seq;
 
         if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
             bo_idx = xma_plg_execbo_avail_get2(s_handle);
@@ -574,7 +576,7 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
             return cmd_obj_error;
         }
         std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->execbo_is_free.wait(lk);
+        priv1->execbo_is_free.wait(lk, [priv1, complete_seq] { return priv1->cmd_complete_seq != complete_seq; });
         lk.unlock();
         itr++;
     }
@@ -697,6 +699,7 @@ XmaCUCmdObj xma_plg_schedule_work_item(XmaSession s_handle,
     //xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "2. Num of cmds in-progress = %lu", priv1->CU_cmds.size());
     //Release execbo lock only after the command is fully populated and inserted in the command list
     priv1->execbo_locked = false;
+    xma_core::utils::notify_cmd_submitted(s_handle);
     if (return_code) *return_code = XMA_SUCCESS;
     return cmd_obj;
 }
@@ -786,9 +789,9 @@ XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
     bool desired = true;
     int32_t bo_idx = -1;
     //With KDS2.0 ensure no outstanding command
-    while (priv1->num_cu_cmds != 0 && !g_xma_singleton->kds_old) {
+    if (!g_xma_singleton->kds_old) {
         std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->kernel_done_or_free.wait_for(lk, std::chrono::milliseconds(1));
+        priv1->kernel_done_or_free.wait(lk, [priv1] { return priv1->num_cu_cmds == 0; });
     }
 
     // Find an available execBO buffer
@@ -799,6 +802,8 @@ XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
             std::this_thread::yield();
             expected = false;
         }
+        //execbo is freed only by a cu cmd completion
+        uint64_t complete_seq = priv1->cmd_complete_seq;
 
         if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
             bo_idx = xma_plg_execbo_avail_get2(s_handle);
@@ -816,7 +821,7 @@ XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
             return cmd_obj_error;
         }
         std::unique_lock<std::mutex> lk(priv1->m_mutex);
-        priv1->execbo_is_free.wait(lk);
+        priv1->execbo_is_free.wait(lk, [priv1, complete_seq] { return priv1->cmd_complete_seq != complete_seq; });
         lk.unlock();
         itr++;
     }
@@ -935,6 +940,7 @@ XmaCUCmdObj xma_plg_schedule_cu_cmd(XmaSession s_handle,
     //xma_logmsg(XMA_DEBUG_LOG, XMAPLUGIN_MOD, "2. Num of cmds in-progress = %lu", priv1->CU_cmds.size());
     //Release execbo lock only after the command is fully populated and inserted in the command list
     priv1->execbo_locked = false;
+    xma_core::utils::notify_cmd_submitted(s_handle);
     if (return_code) *return_code = XMA_SUCCESS;
     return cmd_obj;
 }
@@ -997,6 +1003,8 @@ int32_t xma_plg_cu_cmd_status(XmaSession s_handle, XmaCUCmdObj* cmd_obj_array, i
     std::vector<XmaCUCmdObj> cmd_vector(cmd_obj_array, cmd_obj_array+num_cu_objs);
     do {
         all_done = true;
+        //Completions after this point wake up the wait below
+        uint64_t complete_seq = priv1->cmd_complete_seq;
         for (auto& cmd: cmd_vector) {
             if (s_handle.session_type < XMA_ADMIN && cmd.cu_index != kernel_tmp1->cu_index) {
                 xma_logmsg(XMA_ERROR_LOG, XMAPLUGIN_MOD, "cmd_obj_array is corrupted-1");
@@ -1025,7 +1033,7 @@ int32_t xma_plg_cu_cmd_status(XmaSession s_handle, XmaCUCmdObj* cmd_obj_array, i
         } else if (!all_done) {
             if (g_xma_singleton->cpu_mode == XMA_CPU_MODE1) {
                 std::unique_lock<std::mutex> lk(priv1->m_mutex);
-                priv1->kernel_done_or_free.wait(lk);
+                priv1->kernel_done_or_free.wait(lk, [priv1, complete_seq] { return priv1->cmd_complete_seq != complete_seq; });
             } else if (g_xma_singleton->cpu_mode == XMA_CPU_MODE2) {
                 std::this_thread::yield();
             } else {
@@ -1119,7 +1127,7 @@ int32_t xma_plg_is_work_item_done(XmaSession s_handle, uint32_t timeout_ms)
             std::unique_lock<std::mutex> lk(priv1->m_mutex);
             //priv1->work_item_done_1plus.wait(lk);
 	    //Timeout required if cu is hung; Unblock and check status again
-            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(timeout1));
+            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(timeout1), [priv1] { return priv1->kernel_complete_count != 0; });
             lk.unlock();
 
             tmp_num_cmds = priv1->num_cu_cmds;
@@ -1176,7 +1184,7 @@ int32_t xma_plg_is_work_item_done(XmaSession s_handle, uint32_t timeout_ms)
             //std::this_thread::yield();
 	    //Debug mode: Use small timeout
 	    std::unique_lock<std::mutex> lk(priv1->m_mutex);
-            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(1));
+            priv1->work_item_done_1plus.wait_for(lk, std::chrono::milliseconds(1), [priv1] { return priv1->kernel_complete_count != 0; });
 
         }
         xma_logmsg(XMA_WARNING_LOG, XMAPLUGIN_MOD, "Session id: %d, type: %s. CU cmd is still pending. Cu might be stuck", s_handle.session_id, xma_core::get_session_name(s_handle.session_type).c_str());
@@ -0,0 +1,91 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Allocation churn benchmark for emulation MemoryManager
+//
+// Keeps a working set of live buffers of random sizes and replaces
+// random buffers with new allocations.  Reports allocation and free
+// throughput for increasing working set sizes and verifies that the
+// memory coalesces back into a single free block when all buffers
+// are released.
+#include "memorymanager.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+static const uint64_t bank_size = 0x400000000; // 16GB
+static const unsigned alignment = 4096;
+
+static double
+churn(xclemulation::MemoryManager& mm, size_t live, size_t iterations, std::mt19937_64& rng)
+{
+  std::uniform_int_distribution<size_t> size_dist(1, 0x10000);
+  std::uniform_int_distribution<size_t> idx_dist(0, live - 1);
+
+  std::vector<uint64_t> bufs;
+  bufs.reserve(live);
+  for (size_t i = 0; i < live; ++i) {
+    size_t size = size_dist(rng);
+    auto addr = mm.alloc(size);
+    if (addr == xclemulation::MemoryManager::mNull)
+      throw std::runtime_error("initial allocation failed");
+    bufs.push_back(addr);
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    auto idx = idx_dist(rng);
+    mm.free(bufs[idx]);
+    size_t size = size_dist(rng);
+    bufs[idx] = mm.alloc(size);
+    if (bufs[idx] == xclemulation::MemoryManager::mNull)
+      throw std::runtime_error("churn allocation failed");
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  for (auto addr : bufs)
+    mm.free(addr);
+
+  if (mm.freeSize() != mm.size())
+    throw std::runtime_error("free size mismatch after releasing all buffers");
+
+  // All memory must have coalesced into one block
+  size_t all = static_cast<size_t>(mm.size());
+  auto addr = mm.alloc(all);
+  if (addr != mm.start())
+    throw std::runtime_error("memory did not coalesce");
+  mm.free(addr);
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    size_t iterations = (argc > 1) ? std::stoul(argv[1]) : 100000;
+    std::mt19937_64 rng(42);
+    xclemulation::MemoryManager mm(bank_size, 0, alignment);
+
+    for (size_t live : {10, 100, 1000, 10000, 50000}) {
+      auto ns = churn(mm, live, iterations, rng);
+      std::cout << "Live buffers: " << std::setw(6) << live
+                << " ns per free+alloc: " << std::setw(10) << (ns / iterations)
+                << std::endl;
+    }
+
+    std::cout << "PASSED TEST" << std::endl;
+    return 0;
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+
+  return 1;
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2021, Xilinx Inc - All rights reserved
+ * Xilinx SDAccel Media Accelerator API
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"). You may
+ * not use this file except in compliance with the License. A copy of the
+ * License is located at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ */
+
+// Measure latency of XMA cu cmd completion and CPU load of XMA while
+// sessions wait for their cu cmds.  Each session runs in its own
+// thread and schedules one cu cmd at a time through the
+// xma_kernel_cmd_tst_plg plugin, then waits for it to complete.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xma.h"
+
+static void
+usage()
+{
+  std::cout << "usage: perf_xmalatency [options]\n\n"
+            << "  -x <xclbin>\n"
+            << "  -k <cu name>, e.g. addone:{addone_0}\n"
+            << "  -p <plugin>, path to xma_kernel_cmd_tst_plg.so\n"
+            << "  [-d <device index>] (default: 0)\n"
+            << "  [-s <sessions>] (default: 1)\n"
+            << "  [-n <cu cmds per session>] (default: 10000)\n"
+            << "  [-r <regmap bytes>] (default: 64)\n\n"
+            << "The cu is started with a zeroed regmap of the given size, so it\n"
+            << "must complete without touching memory, e.g. addone with 0 elements\n";
+}
+
+static double
+cpu_seconds()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+    + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static void
+run_session(XmaKernelSession* session, size_t cmds, size_t regmap_size, std::vector<double>& latency)
+{
+  std::vector<char> regmap(regmap_size, 0);
+  XmaParameter param;
+  std::memset(&param, 0, sizeof(param));
+  param.name = const_cast<char*>("regmap");
+  param.type = XMA_STRING;
+  param.length = regmap.size();
+  param.value = regmap.data();
+
+  latency.reserve(cmds);
+  for (size_t i = 0; i < cmds; ++i) {
+    auto start = std::chrono::high_resolution_clock::now();
+    if (xma_kernel_session_write(session, &param, 1) != XMA_SUCCESS)
+      throw std::runtime_error("failed to schedule cu cmd");
+    int32_t cnt = 0;
+    if (xma_kernel_session_read(session, nullptr, &cnt) != XMA_SUCCESS)
+      throw std::runtime_error("cu cmd did not complete");
+    auto end = std::chrono::high_resolution_clock::now();
+    latency.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+}
+
+static int
+run(int argc, char** argv)
+{
+  std::string xclbin;
+  std::string cu_name;
+  std::string plugin;
+  int32_t device_index = 0;
+  size_t sessions = 1;
+  size_t cmds = 10000;
+  size_t regmap_size = 64;
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string cur;
+  for (auto& arg : args) {
+    if (arg == "-h") {
+      usage();
+      return 1;
+    }
+
+    if (arg[0] == '-') {
+      cur = arg;
+      continue;
+    }
+
+    if (cur == "-x")
+      xclbin = arg;
+    else if (cur == "-k")
+      cu_name = arg;
+    else if (cur == "-p")
+      plugin = arg;
+    else if (cur == "-d")
+      device_index = std::stoi(arg);
+    else if (cur == "-s")
+      sessions = std::stoul(arg);
+    else if (cur == "-n")
+      cmds = std::stoul(arg);
+    else if (cur == "-r")
+      regmap_size = std::stoul(arg);
+    else
+      throw std::runtime_error("bad argument '" + cur + " " + arg + "'");
+  }
+
+  if (xclbin.empty() || cu_name.empty() || plugin.empty()) {
+    usage();
+    return 1;
+  }
+
+  XmaXclbinParameter xclbin_param;
+  xclbin_param.xclbin_name = const_cast<char*>(xclbin.c_str());
+  xclbin_param.device_id = device_index;
+  if (xma_initialize(&xclbin_param, 1) != XMA_SUCCESS)
+    throw std::runtime_error("xma_initialize failed");
+
+  std::vector<XmaKernelSession*> all_sessions;
+  for (size_t i = 0; i < sessions; ++i) {
+    XmaKernelProperties props;
+    std::memset(&props, 0, sizeof(props));
+    props.hwkernel_type = XMA_KERNEL_TYPE;
+    std::strcpy(props.hwvendor_string, "Xilinx");
+    props.dev_index = device_index;
+    props.cu_index = -1;
+    props.cu_name = const_cast<char*>(cu_name.c_str());
+    props.ddr_bank_index = -1;
+    props.channel_id = i;
+    props.plugin_lib = const_cast<char*>(plugin.c_str());
+    auto session = xma_kernel_session_create(&props);
+    if (!session)
+      throw std::runtime_error("xma_kernel_session_create failed");
+    all_sessions.push_back(session);
+  }
+
+  std::vector<std::vector<double>> latency(sessions);
+  std::vector<std::thread> threads;
+  auto cpu_start = cpu_seconds();
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t i = 0; i < sessions; ++i)
+    threads.emplace_back(run_session, all_sessions[i], cmds, regmap_size, std::ref(latency[i]));
+  for (auto& t : threads)
+    t.join();
+  auto end = std::chrono::high_resolution_clock::now();
+  auto cpu_end = cpu_seconds();
+
+  for (auto session : all_sessions)
+    xma_kernel_session_destroy(session);
+
+  std::vector<double> all;
+  for (auto& l : latency)
+    all.insert(all.end(), l.begin(), l.end());
+  std::sort(all.begin(), all.end());
+  double sum = 0;
+  for (auto l : all)
+    sum += l;
+
+  double wall = std::chrono::duration<double>(end - start).count();
+  size_t total = all.size();
+  std::cout << "sessions: " << sessions << ", cu cmds: " << total << "\n"
+            << "latency us (min/avg/p50/p99/max): "
+            << all.front() << " / " << sum / total << " / "
+            << all[total / 2] << " / " << all[total * 99 / 100] << " / "
+            << all.back() << "\n"
+            << "cu cmds/s: " << total / wall << "\n"
+            << "cpu us per cu cmd: " << (cpu_end - cpu_start) * 1e6 / total << "\n"
+            << "cpu load: " << (cpu_end - cpu_start) / wall * 100 << "%\n";
+
+  xma_exit();
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    return run(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << "\n";
+  }
+  catch (...) {
+    std::cout << "TEST FAILED\n";
+  }
+  return 1;
+}
@@ -0,0 +1,55 @@
+#include <string.h>
+#include <xmaplugin.h>
+#include "xma_test_plg.h"
+
+/* Kernel plugin that schedules one cu cmd per write and waits for one
+ * cu cmd completion per read.  The regmap is passed as first write
+ * parameter.  Used by perf_xmalatency.
+ */
+
+static int32_t xma_kernel_cmd_init(XmaKernelSession *sess)
+{
+    return 0;
+}
+
+static int32_t xma_kernel_cmd_write(XmaKernelSession *sess, XmaParameter *params,
+                                    int32_t param_cnt)
+{
+    int32_t rc = XMA_ERROR;
+    if (param_cnt < 1 || params[0].value == NULL)
+    {
+        return XMA_ERROR;
+    }
+    xma_plg_schedule_work_item(sess->base, params[0].value,
+                               (int32_t)params[0].length, &rc);
+    return rc;
+}
+
+static int32_t xma_kernel_cmd_read(XmaKernelSession *sess, XmaParameter *params,
+                                   int32_t *param_cnt)
+{
+    return xma_plg_is_work_item_done(sess->base, 1000);
+}
+
+static int32_t xma_kernel_cmd_close(XmaKernelSession *sess)
+{
+    return 0;
+}
+
+static int32_t xma_kernel_cmd_version(int32_t *main_version, int32_t *sub_version)
+{
+    *main_version = 2020;
+    *sub_version = 1;
+    return 0;
+}
+
+XmaKernelPlugin kernel_plugin = {
+    .hwkernel_type = XMA_KERNEL_TYPE,
+    .hwvendor_string = "Xilinx",
+    .plugin_data_size = 1,
+    .init = xma_kernel_cmd_init,
+    .write = xma_kernel_cmd_write,
+    .read = xma_kernel_cmd_read,
+    .close = xma_kernel_cmd_close,
+    .xma_version = xma_kernel_cmd_version,
+};
@@ -23,6 +23,7 @@
 #include "xrt/xrt_device.h"
 #include "xrt/xrt_kernel.h"
 #include "xrt/xrt_bo.h"
+#include "experimental/xrt_enqueue.h"
 
 // This value is shared with worgroup size in kernel.cl
 static const int COUNT = 1024;
@@ -75,6 +76,50 @@ static int run(const xrt::device& device, const xrt::uuid& uuid, bool verbose)
   return 0;
 }
 
+// Same as run() but with asynchronous buffer syncs.  The input
+// syncs are waited on explicitly, the output sync is enqueued in
+// an event queue with the kernel run as dependency.
+static int run_async(const xrt::device& device, const xrt::uuid& uuid, bool verbose)
+{
+  const size_t DATA_SIZE = COUNT * sizeof(int);
+
+  auto simple = xrt::kernel(device, uuid.get(), "simple");
+  auto bo0 = xrt::bo(device, DATA_SIZE, simple.group_id(0));
+  auto bo1 = xrt::bo(device, DATA_SIZE, simple.group_id(1));
+  auto bo0_map = bo0.map<int*>();
+  auto bo1_map = bo1.map<int*>();
+
+  int foo = 0x10;
+  int bufReference[COUNT];
+  for (int i = 0; i < COUNT; ++i) {
+    bo0_map[i] = 0;
+    bo1_map[i] = i;
+    bufReference[i] = i + i * foo;
+  }
+
+  // Both input syncs are in flight at the same time
+  auto sync0 = bo0.async(XCL_BO_SYNC_BO_TO_DEVICE);
+  auto sync1 = bo1.async(XCL_BO_SYNC_BO_TO_DEVICE);
+  sync0.wait();
+  sync1.wait();
+
+  xrt::event_queue queue;
+  xrt::event_handler handler(queue);
+  auto run = xrt::run(simple);
+  run.set_arg(0, bo0);
+  run.set_arg(1, bo1);
+  run.set_arg(2, foo);
+  auto run_event = queue.enqueue([&run] { run.start(); return run; });
+  auto sync_event = queue.enqueue_with_waitlist
+    ([&bo0] { return bo0.async(XCL_BO_SYNC_BO_FROM_DEVICE); }, {run_event});
+  sync_event.wait();
+
+  if (std::memcmp(bo0_map, bufReference, DATA_SIZE))
+    throw std::runtime_error("Value read back does not match reference (async)");
+
+  return 0;
+}
+
 int
 run(int argc, char** argv)
 {
@@ -118,6 +163,7 @@ run(int argc, char** argv)
   auto device = xrt::device(device_index);
   auto uuid = device.load_xclbin(xclbin_fnm);
   run(device, uuid, verbose);
+  run_async(device, uuid, verbose);
   return 0;
 }
 
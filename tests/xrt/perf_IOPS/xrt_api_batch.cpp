@@ -0,0 +1,122 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Compare IOPS of individually started runs with runs started
+// in batches using xrt::run_batch.
+//
+// For each batch size, the same number of commands is executed
+// 'batch size' commands at a time, waiting for all commands of a
+// batch to complete before starting the next.  Run against the noop
+// shim to isolate host side submission cost:
+//
+//  % XCL_EMULATION_MODE=noop ./xrt_api_batch -k verify.xclbin
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-n <commands per batch size>]\n";
+}
+
+double runSingle(std::vector<xrt::run>& cmds, unsigned int batch_size, unsigned int total)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int issued = 0; issued < total; issued += batch_size) {
+    for (unsigned int i = 0; i < batch_size; ++i)
+      cmds[i].start();
+    for (unsigned int i = 0; i < batch_size; ++i)
+      cmds[i].wait();
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+}
+
+double runBatch(std::vector<xrt::run>& cmds, unsigned int batch_size, unsigned int total)
+{
+  xrt::run_batch batch;
+  for (unsigned int i = 0; i < batch_size; ++i)
+    batch.add(cmds[i]);
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int issued = 0; issued < total; issued += batch_size) {
+    batch.start();
+    batch.wait();
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+}
+
+int testBatch(const xrt::device& device, const xrt::uuid& uuid, unsigned int total)
+{
+  std::vector<unsigned int> batch_sizes = { 1,2,4,8,16,32,64,128,256,512,1024 };
+
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  std::vector<xrt::run> cmds;
+  for (unsigned int i = 0; i < batch_sizes.back(); i++) {
+    auto run = xrt::run(hello);
+    run.set_arg(0, xrt::bo(device, 20, hello.group_id(0)));
+    cmds.push_back(std::move(run));
+  }
+
+  for (auto batch_size : batch_sizes) {
+    // round total down to multiple of batch size, at least one batch
+    auto num_cmds = std::max(total, batch_size) / batch_size * batch_size;
+    double single = runSingle(cmds, batch_size, num_cmds);
+    double batch = runBatch(cmds, batch_size, num_cmds);
+    std::cout << "Batch size: " << std::setw(5) << batch_size
+              << " single iops: " << std::setw(10) << (num_cmds * 1000.0 * 1000.0 / single)
+              << " batch iops: " << std::setw(10) << (num_cmds * 1000.0 * 1000.0 / batch)
+              << std::endl;
+  }
+
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int total = 100000;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    total = std::stoi(argv[4]);
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+
+  testBatch(device, uuid, total);
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
@@ -0,0 +1,111 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure command completion cost as function of queue depth.
+//
+// The test keeps 'depth' commands in flight and measures the average
+// time per completed command.  Run against the noop shim to isolate
+// the host side completion cost from actual kernel execution time:
+//
+//  % XCL_EMULATION_MODE=noop ./xrt_api_completion -k verify.xclbin
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-n <commands per depth>]\n";
+}
+
+double runTest(std::vector<xrt::run>& cmds, unsigned int depth, unsigned int total)
+{
+  unsigned int i = 0;
+  unsigned int issued = 0, completed = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int j = 0; j < depth && issued < total; ++j, ++issued)
+    cmds[j].start();
+
+  while (completed < total) {
+    cmds[i].wait();
+
+    completed++;
+    if (issued < total) {
+      cmds[i].start();
+      issued++;
+    }
+
+    if (++i == depth)
+      i = 0;
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return (std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)).count();
+}
+
+int testCompletion(const xrt::device& device, const xrt::uuid& uuid, unsigned int total)
+{
+  std::vector<unsigned int> depths = { 1,2,4,8,16,32,64,128,256,512,1024,2048,4096 };
+
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+
+  std::vector<xrt::run> cmds;
+  for (unsigned int i = 0; i < depths.back(); i++) {
+    auto run = xrt::run(hello);
+    run.set_arg(0, xrt::bo(device, 20, hello.group_id(0)));
+    cmds.push_back(std::move(run));
+  }
+
+  for (auto depth : depths) {
+    double duration = runTest(cmds, depth, std::max(total, depth));
+    std::cout << "Depth: " << std::setw(5) << depth
+              << " ns/completion: " << std::setw(10) << (duration / std::max(total, depth))
+              << " iops: " << (std::max(total, depth) * 1000.0 * 1000.0 * 1000.0 / duration)
+              << std::endl;
+  }
+
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int total = 100000;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    total = std::stoi(argv[4]);
+
+  auto device = xrt::device(0);
+  auto uuid = device.load_xclbin(xclbin_fn);
+
+  testCompletion(device, uuid, total);
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
@@ -3,8 +3,10 @@
  * Copyright (C) 2020-2021 Xilinx, Inc. All rights reserved.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include <vector>
 #include <chrono>
 
@@ -73,6 +75,58 @@ int testSingleThread(const xrt::device& device, const xrt::uuid& uuid)
   return 0;
 }
 
+// Start and wait one command at a time and report the distribution
+// of start to wait completion latency.  Compare runs with different
+// values of Runtime.cmd_wait_spin_us in xrt.ini.
+int testLatency(const xrt::device& device, const xrt::uuid& uuid)
+{
+  constexpr unsigned int iterations = 100000;
+
+  auto hello = xrt::kernel(device, uuid.get(), "hello");
+  auto run = xrt::run(hello);
+  run.set_arg(0, xrt::bo(device, 20, hello.group_id(0)));
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(iterations);
+  for (unsigned int i = 0; i < iterations; ++i) {
+    auto start = std::chrono::high_resolution_clock::now();
+    run.start();
+    run.wait();
+    auto end = std::chrono::high_resolution_clock::now();
+    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    return latencies[static_cast<size_t>(p * (latencies.size() - 1))] / 1000.0;
+  };
+
+  std::cout << "Latency us:"
+            << " p50: " << percentile(0.50)
+            << " p90: " << percentile(0.90)
+            << " p99: " << percentile(0.99)
+            << " p99.9: " << percentile(0.999)
+            << " max: " << latencies.back() / 1000.0
+            << std::endl;
+
+  // Histogram with power of 2 microsecond buckets
+  std::map<uint64_t, unsigned int> histogram;
+  for (auto ns : latencies) {
+    uint64_t bucket = 1;
+    while (bucket * 1000 < ns)
+      bucket <<= 1;
+    ++histogram[bucket];
+  }
+
+  for (auto& entry : histogram)
+    std::cout << "  <= " << std::setw(7) << entry.first << "us: "
+              << std::setw(7) << entry.second << " "
+              << std::string(entry.second * 50 / iterations, '#')
+              << std::endl;
+
+  return 0;
+}
+
 int _main(int argc, char* argv[])
 {
   if (argc < 3 || argv[1] != std::string("-k")) {
@@ -86,6 +140,7 @@ int _main(int argc, char* argv[])
   auto uuid = device.load_xclbin(xclbin_fn);
 
   testSingleThread(device, uuid);
+  testLatency(device, uuid);
 
   return 0;
 }
@@ -0,0 +1,133 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure software command scheduler throughput vs. number of CUs.
+//
+// The test picks the kernel with most CUs in the xclbin and keeps
+// commands in flight on the first 1, 2, 4, ... of its CUs.  Run
+// against the noop shim with kds disabled so that the software
+// scheduler (sws) is used and CUs complete as soon as they start:
+//
+//  % XCL_EMULATION_MODE=noop XRT_INI_PATH=sws.ini ./xrt_api_sws -k <xclbin>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_kernel.h"
+#include "experimental/xrt_xclbin.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-n <commands per cu count>]\n";
+}
+
+// Returns commands per second
+double runTest(std::vector<xrt::run>& cmds, unsigned int total)
+{
+  unsigned int i = 0;
+  unsigned int issued = 0, completed = 0;
+  auto depth = cmds.size();
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int j = 0; j < depth && issued < total; ++j, ++issued)
+    cmds[j].start();
+
+  while (completed < total) {
+    cmds[i].wait();
+
+    completed++;
+    if (issued < total) {
+      cmds[i].start();
+      issued++;
+    }
+
+    if (++i == depth)
+      i = 0;
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  double duration = (std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)).count();
+  return total * 1000.0 * 1000.0 * 1000.0 / duration;
+}
+
+int testScheduler(const xrt::device& device, const xrt::xclbin& xclbin, unsigned int total)
+{
+  auto kernels = xclbin.get_kernels();
+  auto kernel = std::max_element(kernels.begin(), kernels.end(),
+                                 [](const auto& k1, const auto& k2) {
+                                   return k1.get_cus().size() < k2.get_cus().size();
+                                 });
+  if (kernel == kernels.end())
+    throw std::runtime_error("no kernels in xclbin");
+
+  // CU names are "kernel:cu"
+  std::vector<std::string> cu_names;
+  for (auto& cu : kernel->get_cus()) {
+    auto name = cu.get_name();
+    cu_names.push_back(name.substr(name.find(':') + 1));
+  }
+
+  for (size_t num_cus = 1; ; num_cus = std::min(num_cus * 2, cu_names.size())) {
+    std::string kname = kernel->get_name() + ":{";
+    for (size_t idx = 0; idx < num_cus; ++idx)
+      kname.append(idx ? "," : "").append(cu_names[idx]);
+    kname += "}";
+
+    auto k = xrt::kernel(device, xclbin.get_uuid(), kname);
+
+    // Keep 16 commands per CU in flight
+    std::vector<xrt::run> cmds;
+    for (size_t i = 0; i < 16 * num_cus; ++i)
+      cmds.emplace_back(k);
+
+    auto cps = runTest(cmds, std::max<unsigned int>(total, cmds.size()));
+    std::cout << "CUs: " << std::setw(4) << num_cus
+              << " commands/s: " << std::setw(12) << cps
+              << std::endl;
+
+    if (num_cus == cu_names.size())
+      break;
+  }
+
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int total = 100000;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    total = std::stoi(argv[4]);
+
+  auto xclbin = xrt::xclbin(xclbin_fn);
+  auto device = xrt::device(0);
+  device.load_xclbin(xclbin);
+
+  return testScheduler(device, xclbin, total);
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
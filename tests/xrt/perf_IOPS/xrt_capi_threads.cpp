@@ -0,0 +1,219 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure C API throughput with multiple threads.
+//
+// Each thread allocates and frees its own buffer and run handles and
+// starts, waits, and syncs through the C API, which exercises handle
+// lookup for every call.  Run against the noop shim to isolate the
+// host side cost:
+//
+//  % XCL_EMULATION_MODE=noop ./xrt_capi_threads -k verify.xclbin
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+#include "xrt/xrt_kernel.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-n <iterations per thread>]\n";
+}
+
+static void
+check(int ret, const char* what)
+{
+  if (ret)
+    throw std::runtime_error(std::string(what) + " failed with " + std::to_string(ret));
+}
+
+// One iteration allocates a buffer and a run, executes the run
+// and syncs the buffer, then closes both handles.
+static void
+worker(xrtDeviceHandle dhdl, xrtKernelHandle khdl, unsigned int iterations, std::atomic<int>& errors)
+{
+  try {
+    auto grpid = xrtKernelArgGroupId(khdl, 0);
+    for (unsigned int i = 0; i < iterations; ++i) {
+      auto bhdl = xrtBOAlloc(dhdl, 20, 0, grpid);
+      if (!bhdl)
+        throw std::runtime_error("xrtBOAlloc failed");
+      auto rhdl = xrtRunOpen(khdl);
+      if (!rhdl)
+        throw std::runtime_error("xrtRunOpen failed");
+      check(xrtRunSetArg(rhdl, 0, bhdl), "xrtRunSetArg");
+      check(xrtRunStart(rhdl), "xrtRunStart");
+      if (xrtRunWait(rhdl) != ERT_CMD_STATE_COMPLETED)
+        throw std::runtime_error("xrtRunWait failed");
+      check(xrtBOSync(bhdl, XCL_BO_SYNC_BO_FROM_DEVICE, 20, 0), "xrtBOSync");
+      check(xrtRunClose(rhdl), "xrtRunClose");
+      check(xrtBOFree(bhdl), "xrtBOFree");
+    }
+  }
+  catch (const std::exception& ex) {
+    std::cout << "thread error: " << ex.what() << std::endl;
+    ++errors;
+  }
+}
+
+double runTest(xrtDeviceHandle dhdl, xrtKernelHandle khdl, unsigned int threads, unsigned int iterations)
+{
+  std::atomic<int> errors {0};
+  std::vector<std::thread> workers;
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int t = 0; t < threads; ++t)
+    workers.emplace_back(worker, dhdl, khdl, iterations, std::ref(errors));
+  for (auto& t : workers)
+    t.join();
+
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (errors)
+    throw std::runtime_error(std::to_string(errors) + " threads failed");
+
+  return (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+}
+
+// Handle bits that select the table shard and slot, the remaining
+// upper bits are the slot generation
+static bool
+same_slot(const void* a, const void* b)
+{
+  const uintptr_t slot_mask = (sizeof(uintptr_t) == 8) ? 0xffffffff : 0xfffff;
+  return (reinterpret_cast<uintptr_t>(a) & slot_mask) == (reinterpret_cast<uintptr_t>(b) & slot_mask);
+}
+
+// Allocate handles until one reuses the slot of the closed handle.
+// Handles are spread round robin over the table shards, the closed
+// slot is the first to be reused in its shard.
+template <typename Alloc, typename Free>
+static void*
+reuse_slot(const void* closed, Alloc alloc, Free release)
+{
+  std::vector<void*> others;
+  void* reused = nullptr;
+  for (int i = 0; i < 256 && !reused; ++i) {
+    auto hdl = alloc();
+    if (!hdl)
+      throw std::runtime_error("handle allocation failed");
+    if (same_slot(hdl, closed))
+      reused = hdl;
+    else
+      others.push_back(hdl);
+  }
+  for (auto hdl : others)
+    release(hdl);
+  if (!reused)
+    throw std::runtime_error("closed handle slot was not reused");
+  if (reused == closed)
+    throw std::runtime_error("reused slot has same handle as closed handle");
+  return reused;
+}
+
+// Closed handles must be rejected, also after their slot is reused
+int testStaleHandle(xrtDeviceHandle dhdl, xrtKernelHandle khdl)
+{
+  auto grpid = xrtKernelArgGroupId(khdl, 0);
+  auto bhdl = xrtBOAlloc(dhdl, 20, 0, grpid);
+  check(xrtBOFree(bhdl), "xrtBOFree");
+
+  auto reused = reuse_slot(bhdl,
+    [dhdl, grpid] { return xrtBOAlloc(dhdl, 20, 0, grpid); },
+    [](void* hdl) { check(xrtBOFree(hdl), "xrtBOFree"); });
+  if (xrtBOSync(bhdl, XCL_BO_SYNC_BO_TO_DEVICE, 20, 0) == 0)
+    throw std::runtime_error("stale buffer handle was accepted");
+  if (xrtBOFree(bhdl) == 0)
+    throw std::runtime_error("stale buffer handle was freed");
+  check(xrtBOSync(reused, XCL_BO_SYNC_BO_TO_DEVICE, 20, 0), "xrtBOSync");
+  check(xrtBOFree(reused), "xrtBOFree");
+
+  auto rhdl = xrtRunOpen(khdl);
+  check(xrtRunClose(rhdl), "xrtRunClose");
+
+  auto rreused = reuse_slot(rhdl,
+    [khdl] { return xrtRunOpen(khdl); },
+    [](void* hdl) { check(xrtRunClose(hdl), "xrtRunClose"); });
+  if (xrtRunStart(rhdl) == 0)
+    throw std::runtime_error("stale run handle was accepted");
+  if (xrtRunClose(rhdl) == 0)
+    throw std::runtime_error("stale run handle was closed");
+  check(xrtRunClose(rreused), "xrtRunClose");
+
+  return 0;
+}
+
+int testThreads(xrtDeviceHandle dhdl, const xuid_t uuid, unsigned int iterations)
+{
+  auto khdl = xrtPLKernelOpen(dhdl, uuid, "hello");
+  if (!khdl)
+    throw std::runtime_error("xrtPLKernelOpen failed");
+
+  testStaleHandle(dhdl, khdl);
+
+  unsigned int cpus = std::max(2u, std::thread::hardware_concurrency());
+  std::vector<unsigned int> thread_counts = { 1, 2, 4, 8, 16 };
+  if (cpus > thread_counts.back())
+    thread_counts.push_back(cpus);
+
+  for (auto threads : thread_counts) {
+    double duration = runTest(dhdl, khdl, threads, iterations);
+    std::cout << "Threads: " << std::setw(3) << threads
+              << " iterations/s: " << std::setw(10) << (threads * iterations * 1000.0 * 1000.0 / duration)
+              << std::endl;
+  }
+
+  check(xrtKernelClose(khdl), "xrtKernelClose");
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int iterations = 10000;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    iterations = std::stoi(argv[4]);
+
+  auto dhdl = xrtDeviceOpen(0);
+  if (!dhdl)
+    throw std::runtime_error("xrtDeviceOpen failed");
+
+  check(xrtDeviceLoadXclbinFile(dhdl, xclbin_fn.c_str()), "xrtDeviceLoadXclbinFile");
+  xuid_t uuid;
+  check(xrtDeviceGetXclbinUUID(dhdl, uuid), "xrtDeviceGetXclbinUUID");
+
+  testThreads(dhdl, uuid, iterations);
+
+  check(xrtDeviceClose(dhdl), "xrtDeviceClose");
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
@@ -0,0 +1,218 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Compare rect reads and writes of small tiles with full buffer transfers
+#include <CL/cl.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static void
+throw_if_error(cl_int errcode, const char* msg)
+{
+  if (!errcode)
+    return;
+  throw std::runtime_error(std::string(msg) + " errcode '" + std::to_string(errcode) + "'");
+}
+
+void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-m <buffer MB>]\n";
+}
+
+struct tile
+{
+  size_t width;      // bytes per row
+  size_t height;     // rows
+  size_t row_pitch;  // bytes between rows in the buffer
+};
+
+using clock_type = std::chrono::high_resolution_clock;
+
+// Bytes synced with the device for a 2D rect as done by XRT.  Rows
+// at most max_gap bytes apart are synced together with the gap,
+// XRT uses 4096 for reads and 0 for writes
+static size_t
+synced_bytes(const tile& t, size_t offset, size_t max_gap)
+{
+  size_t synced = 0;
+  size_t span_begin = offset;
+  size_t span_end = offset + t.width;
+  for (size_t y = 1; y < t.height; ++y) {
+    auto row = offset + y * t.row_pitch;
+    if (row > span_end + max_gap) {
+      synced += span_end - span_begin;
+      span_begin = row;
+    }
+    span_end = std::max(span_end, row + t.width);
+  }
+  return synced + span_end - span_begin;
+}
+
+static double
+elapsed_us(clock_type::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+}
+
+int
+run(cl_context context, cl_command_queue queue, size_t buffer_size)
+{
+  cl_int err = CL_SUCCESS;
+  std::vector<char> host(buffer_size);
+  for (size_t i = 0; i < buffer_size; ++i)
+    host[i] = static_cast<char>(i * 7 + 3);
+
+  auto buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, buffer_size, nullptr, &err);
+  throw_if_error(err, "clCreateBuffer");
+
+  // Make the buffer resident so transfers go to the device
+  auto start = clock_type::now();
+  throw_if_error(clEnqueueWriteBuffer(queue, buffer, CL_TRUE, 0, buffer_size, host.data(), 0, nullptr, nullptr), "clEnqueueWriteBuffer");
+  throw_if_error(clEnqueueMigrateMemObjects(queue, 1, &buffer, 0, 0, nullptr, nullptr), "clEnqueueMigrateMemObjects");
+  throw_if_error(clFinish(queue), "clFinish");
+  auto full_write_us = elapsed_us(start);
+
+  std::vector<char> full(buffer_size);
+  start = clock_type::now();
+  throw_if_error(clEnqueueReadBuffer(queue, buffer, CL_TRUE, 0, buffer_size, full.data(), 0, nullptr, nullptr), "clEnqueueReadBuffer");
+  auto full_read_us = elapsed_us(start);
+
+  std::cout << "Buffer: " << buffer_size << " bytes, full read " << full_read_us
+            << " us, full write " << full_write_us << " us\n";
+
+  // Dense rows, rows with small gaps, sparse rows and a single row
+  std::vector<tile> tiles = {
+    { 64, 64, 64 },
+    { 64, 64, 1024 },
+    { 64, 64, 8192 },
+    { 4096, 64, 1024 * 1024 },
+    { 65536, 1, 65536 },
+  };
+
+  std::cout << std::setw(8) << "width" << std::setw(8) << "height" << std::setw(10) << "pitch"
+            << std::setw(12) << "region B" << std::setw(16) << "read synced B"
+            << std::setw(16) << "write synced B"
+            << std::setw(12) << "read us" << std::setw(12) << "write us" << "\n";
+
+  for (auto& t : tiles) {
+    size_t buffer_origin[3] = { 128, 3, 0 };
+    size_t host_origin[3] = { 0, 0, 0 };
+    size_t region[3] = { t.width, t.height, 1 };
+    size_t last = buffer_origin[0] + (buffer_origin[1] + t.height - 1) * t.row_pitch + t.width;
+    if (last > buffer_size)
+      continue;
+
+    size_t region_bytes = t.width * t.height;
+    size_t offset = buffer_origin[0] + buffer_origin[1] * t.row_pitch;
+    size_t read_synced = synced_bytes(t, offset, 4096);
+    size_t write_synced = synced_bytes(t, offset, 0);
+
+    std::vector<char> tile_data(region_bytes);
+    start = clock_type::now();
+    throw_if_error(clEnqueueReadBufferRect(queue, buffer, CL_TRUE, buffer_origin, host_origin, region,
+                                           t.row_pitch, 0, t.width, 0, tile_data.data(),
+                                           0, nullptr, nullptr), "clEnqueueReadBufferRect");
+    auto read_us = elapsed_us(start);
+
+    for (size_t y = 0; y < t.height; ++y) {
+      auto offset = buffer_origin[0] + (buffer_origin[1] + y) * t.row_pitch;
+      if (std::memcmp(tile_data.data() + y * t.width, host.data() + offset, t.width))
+        throw std::runtime_error("rect read mismatch");
+    }
+
+    // Non-blocking write of the inverted tile, completed through its event
+    for (auto& c : tile_data)
+      c = ~c;
+    cl_event ev = nullptr;
+    start = clock_type::now();
+    throw_if_error(clEnqueueWriteBufferRect(queue, buffer, CL_FALSE, buffer_origin, host_origin, region,
+                                            t.row_pitch, 0, t.width, 0, tile_data.data(),
+                                            0, nullptr, &ev), "clEnqueueWriteBufferRect");
+    throw_if_error(clWaitForEvents(1, &ev), "clWaitForEvents");
+    auto write_us = elapsed_us(start);
+    clReleaseEvent(ev);
+
+    throw_if_error(clEnqueueReadBuffer(queue, buffer, CL_TRUE, 0, buffer_size, full.data(), 0, nullptr, nullptr), "clEnqueueReadBuffer");
+    for (size_t y = 0; y < t.height; ++y) {
+      auto offset = buffer_origin[0] + (buffer_origin[1] + y) * t.row_pitch;
+      for (size_t x = 0; x < t.width; ++x)
+        host[offset + x] = ~host[offset + x];
+    }
+    if (full != host)
+      throw std::runtime_error("rect write mismatch");
+
+    std::cout << std::setw(8) << t.width << std::setw(8) << t.height << std::setw(10) << t.row_pitch
+              << std::setw(12) << region_bytes << std::setw(16) << read_synced
+              << std::setw(16) << write_synced
+              << std::setw(12) << read_us << std::setw(12) << write_us << "\n";
+  }
+
+  clReleaseMemObject(buffer);
+  return 0;
+}
+
+int
+_main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  size_t buffer_mb = 256;
+  if (argc == 5 && argv[3] == std::string("-m"))
+    buffer_mb = std::stoul(argv[4]);
+
+  cl_platform_id platform = nullptr;
+  throw_if_error(clGetPlatformIDs(1, &platform, nullptr), "clGetPlatformIDs");
+  cl_device_id device = nullptr;
+  throw_if_error(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ACCELERATOR, 1, &device, nullptr), "clGetDeviceIDs");
+
+  cl_int err = CL_SUCCESS;
+  auto context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+  throw_if_error(err, "clCreateContext");
+  auto queue = clCreateCommandQueue(context, device, 0, &err);
+  throw_if_error(err, "clCreateCommandQueue");
+
+  std::ifstream stream(xclbin_fn, std::ios::binary);
+  std::vector<unsigned char> xclbin((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  const unsigned char* data = xclbin.data();
+  size_t size = xclbin.size();
+  auto program = clCreateProgramWithBinary(context, 1, &device, &size, &data, nullptr, &err);
+  throw_if_error(err, "clCreateProgramWithBinary");
+
+  auto ret = run(context, queue, buffer_mb * 1024 * 1024);
+
+  clReleaseProgram(program);
+  clReleaseCommandQueue(queue);
+  clReleaseContext(context);
+  return ret;
+}
+
+int
+main(int argc, char* argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
@@ -0,0 +1,94 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure buffer transfer throughput in software emulation.
+//
+// Run once with default xrt.ini and once with enable_shm_transfer
+// set to compare socket transfer with shared memory transfer.
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-m <memory group>]\n";
+}
+
+// Returns throughput in MB/s
+double runTest(xrt::bo& bo, xclBOSyncDirection dir, size_t size, unsigned int iterations)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int i = 0; i < iterations; ++i)
+    bo.sync(dir, size, 0);
+
+  auto end = std::chrono::high_resolution_clock::now();
+  double duration = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+  return (static_cast<double>(size) * iterations) / duration;
+}
+
+int testTransfer(const xrt::device& device, int grpidx)
+{
+  std::vector<size_t> sizes = { 0x1000, 0x10000, 0x100000, 0x800000, 0x1000000, 0x4000000, 0x10000000 };
+
+  for (auto size : sizes) {
+    auto bo = xrt::bo(device, size, grpidx);
+    auto bo_map = bo.map<char*>();
+    std::memset(bo_map, 0xa5, size);
+
+    // Fewer iterations for larger buffers, at least 64MB total or 16 iterations
+    auto iterations = std::max<unsigned int>(16, static_cast<unsigned int>(0x4000000 / size));
+
+    auto h2d = runTest(bo, XCL_BO_SYNC_BO_TO_DEVICE, size, iterations);
+    auto d2h = runTest(bo, XCL_BO_SYNC_BO_FROM_DEVICE, size, iterations);
+
+    std::cout << "Size: " << std::setw(10) << size
+              << " iterations: " << std::setw(5) << iterations
+              << " host2device MB/s: " << std::setw(10) << h2d
+              << " device2host MB/s: " << std::setw(10) << d2h
+              << std::endl;
+  }
+
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  int grpidx = 0;
+  if (argc == 5 && argv[3] == std::string("-m"))
+    grpidx = std::stoi(argv[4]);
+
+  auto device = xrt::device(0);
+  device.load_xclbin(xclbin_fn);
+
+  return testTransfer(device, grpidx);
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
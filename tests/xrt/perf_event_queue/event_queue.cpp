@@ -0,0 +1,118 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure event queue throughput with pipelines of small stages.
+// No device is needed, stages are empty host functions.
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "experimental/xrt_enqueue.h"
+#include "experimental/xrt_pipeline.h"
+
+void usage()
+{
+  std::cout << "Usage: test [-n <pipeline executions>] [-s <stages>]\n";
+}
+
+static std::atomic<unsigned long> work {0};
+
+static void
+stage()
+{
+  work.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Returns events per second
+static double
+run_pipelines(unsigned int handlers, unsigned int producers,
+              unsigned int executions, unsigned int stages)
+{
+  xrt::event_queue queue;
+  std::vector<xrt::event_handler> event_handlers;
+  for (unsigned int h = 0; h < handlers; ++h)
+    event_handlers.emplace_back(queue);
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  std::vector<std::thread> threads;
+  for (unsigned int p = 0; p < producers; ++p) {
+    threads.emplace_back([&queue, executions, stages, producers] {
+      xrt::pipeline pipeline(queue);
+      for (unsigned int s = 0; s < stages; ++s)
+        pipeline.emplace(stage);
+
+      // Keep a window of pipeline executions in flight
+      std::vector<xrt::event> inflight;
+      for (unsigned int i = 0; i < executions / producers; ++i) {
+        inflight.push_back(pipeline.execute());
+        if (inflight.size() == 64) {
+          for (auto& ev : inflight)
+            ev.wait();
+          inflight.clear();
+        }
+      }
+      for (auto& ev : inflight)
+        ev.wait();
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  double duration = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+  double events = static_cast<double>(executions / producers) * producers * stages;
+  return events * 1000.0 * 1000.0 / duration;
+}
+
+int _main(int argc, char* argv[])
+{
+  unsigned int executions = 100000;
+  unsigned int stages = 8;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string arg = argv[i];
+    if (arg == "-n")
+      executions = std::stoi(argv[i + 1]);
+    else if (arg == "-s")
+      stages = std::stoi(argv[i + 1]);
+    else {
+      usage();
+      return 1;
+    }
+  }
+
+  unsigned int cpus = std::max(2u, std::thread::hardware_concurrency());
+  for (auto handlers : { 1u, 2u, 4u, cpus }) {
+    for (auto producers : { 1u, 4u }) {
+      auto eps = run_pipelines(handlers, producers, executions, stages);
+      std::cout << "Handlers: " << std::setw(3) << handlers
+                << " Producers: " << std::setw(3) << producers
+                << " Stages: " << stages
+                << " events/s: " << std::setw(12) << static_cast<unsigned long>(eps)
+                << std::endl;
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
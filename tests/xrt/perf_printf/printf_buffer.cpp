@@ -0,0 +1,169 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure host side formatting of OpenCL kernel printf buffers.
+//
+// Builds a synthetic printf buffer laid out as the device writes it,
+// one segment per work item with a few records each, and formats it
+// with XCL::Printf::BufferPrintf.
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rt_printf_impl.h"
+
+using XCL::Printf::BufferPrintf;
+
+void usage()
+{
+  std::cout << "Usage: test [-n <work items>] [-r <records per work item>] [-p]\n"
+            << "  -p  print the formatted text instead of timing\n";
+}
+
+static void
+put64(std::vector<uint8_t>& buf, size_t& offset, uint64_t val)
+{
+  std::memcpy(buf.data() + offset, &val, sizeof(val));
+  offset += sizeof(val);
+}
+
+static void
+putFloat(std::vector<uint8_t>& buf, size_t& offset, float val)
+{
+  std::memcpy(buf.data() + offset, &val, sizeof(val));
+  offset += sizeof(val);
+}
+
+static BufferPrintf::StringTable
+makeStringTable()
+{
+  BufferPrintf::StringTable table;
+  table[1] = "work item %d: value = %f\n";
+  table[2] = "gid=%u lid=%u sum=0x%08x %s\n";
+  table[3] = "vec=%v4hlf ivec=%v3d 100%%\n";
+  table[4] = "%-6d|%+.3e|%5c|\n";
+  return table;
+}
+
+static std::vector<uint8_t>
+makeBuffer(unsigned int workItems, unsigned int records)
+{
+  size_t segment = XCL::Printf::getWorkItemPrintfBufferSize();
+  std::vector<uint8_t> buf(workItems * segment, 0xFF);
+
+  for (unsigned int wi = 0; wi < workItems; ++wi) {
+    size_t offset = wi * segment;
+    for (unsigned int r = 0; r < records; ++r) {
+      switch (r % 4) {
+      case 0:
+        put64(buf, offset, 1);
+        put64(buf, offset, wi);
+        {
+          double val = wi * 0.5 + r;
+          uint64_t bits;
+          std::memcpy(&bits, &val, sizeof(bits));
+          put64(buf, offset, bits);
+        }
+        break;
+      case 1:
+        // %s is not supported on the device, keep it out of the data
+        put64(buf, offset, 4);
+        put64(buf, offset, -static_cast<int64_t>(wi));
+        {
+          double val = wi * 1e-3;
+          uint64_t bits;
+          std::memcpy(&bits, &val, sizeof(bits));
+          put64(buf, offset, bits);
+        }
+        put64(buf, offset, 'a' + (wi % 26));
+        break;
+      case 2:
+        put64(buf, offset, 3);
+        for (int i = 0; i < 4; ++i)
+          putFloat(buf, offset, wi + i * 0.25f);
+        for (int i = 0; i < 3; ++i)
+          put64(buf, offset, wi * i);
+        put64(buf, offset, 0); // vec3 padding
+        break;
+      case 3:
+        put64(buf, offset, 1);
+        put64(buf, offset, r);
+        {
+          double val = -1.0 * r;
+          uint64_t bits;
+          std::memcpy(&bits, &val, sizeof(bits));
+          put64(buf, offset, bits);
+        }
+        break;
+      }
+    }
+  }
+  return buf;
+}
+
+int _main(int argc, char* argv[])
+{
+  unsigned int workItems = 100000;
+  unsigned int records = 8;
+  bool printText = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc)
+      workItems = std::stoi(argv[++i]);
+    else if (arg == "-r" && i + 1 < argc)
+      records = std::stoi(argv[++i]);
+    else if (arg == "-p")
+      printText = true;
+    else {
+      usage();
+      return 1;
+    }
+  }
+
+  // Records must fit in the work item segment
+  if (records * 64 > XCL::Printf::getWorkItemPrintfBufferSize())
+    throw std::runtime_error("too many records per work item");
+
+  auto buf = makeBuffer(workItems, records);
+  BufferPrintf bp(buf, makeStringTable());
+
+  if (printText) {
+    bp.print(std::cout);
+    return 0;
+  }
+
+  std::ostringstream oss;
+  auto start = std::chrono::high_resolution_clock::now();
+  bp.print(oss);
+  auto end = std::chrono::high_resolution_clock::now();
+  double duration = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+
+  double numRecords = static_cast<double>(workItems) * records;
+  std::cout << "Records: " << numRecords
+            << " records/s: " << std::setw(12) << (numRecords * 1e6 / duration)
+            << " MB/s: " << std::setw(8) << (oss.str().size() / duration)
+            << std::endl;
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
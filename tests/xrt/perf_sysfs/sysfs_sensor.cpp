@@ -0,0 +1,195 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Sensor read benchmark for the pcie scan layer
+//
+// Builds a fake sysfs tree with one user function that has a number
+// of subdevices, one of which carries the board sensors, and reads
+// all sensors repeatedly with and without the sysfs sensor cache.
+#include "scan.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+
+static const std::string bdf = "0000:01:00.1";
+static const int num_subdevs = 32;
+static const int num_sensors = 56;
+
+static void
+make_dir(const std::string& path)
+{
+  if (::mkdir(path.c_str(), 0755) && errno != EEXIST)
+    throw std::runtime_error("failed to create " + path);
+}
+
+static void
+write_file(const std::string& path, const std::string& value)
+{
+  std::ofstream ofs(path);
+  if (!ofs)
+    throw std::runtime_error("failed to create " + path);
+  ofs << value << "\n";
+}
+
+static std::string
+sensor_name(int i)
+{
+  return "xmc_sensor" + std::to_string(i);
+}
+
+static std::string
+make_tree()
+{
+  char tmpl[] = "/tmp/sysfsXXXXXX";
+  if (!::mkdtemp(tmpl))
+    throw std::runtime_error("failed to create tree");
+  std::string root = tmpl;
+
+  std::string dir = root;
+  for (auto d : {"/bus", "/pci", "/devices", ("/" + bdf).c_str()}) {
+    dir += d;
+    make_dir(dir);
+  }
+
+  write_file(dir + "/vendor", "0x10ee");
+  write_file(dir + "/device", "0x5001");
+  write_file(dir + "/userbar", "0");
+  write_file(dir + "/ready", "0x1");
+  make_dir(dir + "/drm");
+  make_dir(dir + "/drm/renderD128");
+
+  // Subdevices are found by scanning the device directory, the
+  // sensor subdevice is the last one
+  for (int i = 0; i < num_subdevs; ++i) {
+    auto subdev = dir + "/subdev" + std::to_string(i) + ".u.4194305";
+    make_dir(subdev);
+    write_file(subdev + "/status", "0");
+  }
+  auto xmc = dir + "/xmc.u.4194305";
+  make_dir(xmc);
+  for (int i = 0; i < num_sensors; ++i)
+    write_file(xmc + "/" + sensor_name(i), std::to_string(1000 + i));
+
+  return root;
+}
+
+template <typename ReadFunc>
+static double
+run(const char* label, int passes, ReadFunc read)
+{
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int p = 0; p < passes; ++p) {
+    for (int i = 0; i < num_sensors; ++i) {
+      auto value = read(sensor_name(i));
+      if (value != static_cast<uint64_t>(1000 + i))
+        throw std::runtime_error("bad value for " + sensor_name(i));
+    }
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  double sec = std::chrono::duration<double>(end - start).count();
+  double rate = passes * num_sensors / sec;
+  std::cout << std::left << std::setw(10) << label
+            << std::right << std::setw(12) << std::fixed << std::setprecision(0)
+            << rate << " reads/s" << std::endl;
+  return rate;
+}
+
+static void
+check_refresh(pcidev::pci_device& dev, const std::string& root, std::chrono::milliseconds ttl)
+{
+  auto path = root + "/bus/pci/devices/" + bdf + "/xmc.u.4194305/" + sensor_name(0);
+  std::string err;
+  uint64_t value = 0;
+
+  write_file(path, "77");
+  dev.sysfs_get_cached("xmc", sensor_name(0), ttl, err, value, uint64_t(0));
+  if (value != 1000)
+    throw std::runtime_error("cached value not used");
+
+  // The sampler or the next read picks up the new value
+  std::this_thread::sleep_for(ttl * 2);
+  dev.sysfs_get_cached("xmc", sensor_name(0), ttl, err, value, uint64_t(0));
+  if (!err.empty() || value != 77)
+    throw std::runtime_error("cached value not refreshed");
+
+  // Missing entries report the same error as uncached reads
+  dev.sysfs_get_cached("xmc", "no_such_sensor", ttl, err, value, uint64_t(0));
+  if (err.empty())
+    throw std::runtime_error("missing entry not reported");
+}
+
+static int
+run(int argc, char** argv)
+{
+  int passes = 2000;
+  std::chrono::milliseconds ttl(100);
+
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (size_t i = 0; i + 1 < args.size(); i += 2) {
+    if (args[i] == "-n")
+      passes = std::stoi(args[i + 1]);
+    else if (args[i] == "-t")
+      ttl = std::chrono::milliseconds(std::stoi(args[i + 1]));
+    else
+      throw std::runtime_error("usage: sysfs_sensor.exe [-n <passes>] [-t <ttl ms>]");
+  }
+
+  auto root = make_tree();
+  ::setenv("XRT_SYSFS_ROOT", root.c_str(), 1);
+
+  pcidev::pci_device dev("xocl", bdf);
+  if (dev.vendor_id != XILINX_ID)
+    throw std::runtime_error("fake device not found");
+
+  std::cout << num_sensors << " sensors, " << passes << " passes, ttl "
+            << ttl.count() << "ms" << std::endl;
+
+  run("uncached", passes, [&](const std::string& entry) {
+    std::string err;
+    uint64_t value = 0;
+    dev.sysfs_get<uint64_t>("xmc", entry, err, value, 0);
+    return value;
+  });
+
+  run("cached", passes, [&](const std::string& entry) {
+    std::string err;
+    uint64_t value = 0;
+    dev.sysfs_get_cached<uint64_t>("xmc", entry, ttl, err, value, 0);
+    return value;
+  });
+
+  check_refresh(dev, root, ttl);
+
+  std::string cmd = "rm -rf " + root;
+  if (std::system(cmd.c_str()))
+    std::cout << "failed to remove " << root << std::endl;
+
+  std::cout << "PASSED" << std::endl;
+  return 0;
+}
+
+int
+main(int argc, char** argv)
+{
+  try {
+    return run(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}
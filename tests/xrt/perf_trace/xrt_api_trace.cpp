@@ -0,0 +1,97 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure trace event logging overhead vs. number of threads.
+//
+// Run once with default xrt.ini and once with native_xrt_trace set
+// to compare the cost of API calls with and without trace events.
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include "xrt/xrt_device.h"
+#include "xrt/xrt_bo.h"
+
+void usage()
+{
+  std::cout  << "Usage: test -k <xclbin> [-n <calls per thread>]\n";
+}
+
+// Returns calls per second over all threads
+double runTest(const xrt::device& device, unsigned int threads, unsigned int calls)
+{
+  std::vector<xrt::bo> bos;
+  for (unsigned int t = 0; t < threads; ++t)
+    bos.emplace_back(device, 64, 0);
+
+  std::vector<std::thread> workers;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (unsigned int t = 0; t < threads; ++t)
+    workers.emplace_back([&bos, t, calls] {
+      for (unsigned int i = 0; i < calls; ++i)
+        bos[t].sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    });
+  for (auto& w : workers)
+    w.join();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  double duration = (std::chrono::duration_cast<std::chrono::microseconds>(end - start)).count();
+  return threads * calls * 1000.0 * 1000.0 / duration;
+}
+
+int testTrace(const xrt::device& device, unsigned int calls)
+{
+  unsigned int cpus = std::max(2u, std::thread::hardware_concurrency());
+  std::vector<unsigned int> thread_counts = { 1, 2, 4, 8, 16, 32 };
+  if (cpus > thread_counts.back())
+    thread_counts.push_back(cpus);
+
+  for (auto threads : thread_counts) {
+    auto cps = runTest(device, threads, calls);
+    std::cout << "Threads: " << std::setw(3) << threads
+              << " calls/s: " << std::setw(12) << cps
+              << " events/s (if traced): " << std::setw(12) << (2 * cps)
+              << std::endl;
+  }
+
+  return 0;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int calls = 100000;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    calls = std::stoi(argv[4]);
+
+  auto device = xrt::device(0);
+  device.load_xclbin(xclbin_fn);
+
+  return testTrace(device, calls);
+}
+
+int main(int argc, char *argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+};
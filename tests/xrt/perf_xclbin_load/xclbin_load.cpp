@@ -0,0 +1,112 @@
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * Copyright (C) 2021 Xilinx, Inc. All rights reserved.
+ */
+
+// Measure xclbin loading for meta data only use
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "experimental/xrt_xclbin.h"
+
+void usage()
+{
+  std::cout << "Usage: test -k <xclbin> [-n <iterations>]\n";
+}
+
+using clock_type = std::chrono::high_resolution_clock;
+
+static double
+elapsed_us(clock_type::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+}
+
+// Baseline, read the complete file as xrt::xclbin used to
+static size_t
+read_file(const std::string& fnm)
+{
+  std::ifstream stream(fnm, std::ios::binary);
+  stream.seekg(0, stream.end);
+  size_t size = stream.tellg();
+  stream.seekg(0, stream.beg);
+  std::vector<char> data(size);
+  stream.read(data.data(), size);
+  return data.size();
+}
+
+// Construct xclbin and access meta data only
+static size_t
+load_meta_data(const std::string& fnm)
+{
+  xrt::xclbin xclbin{fnm};
+  size_t count = xclbin.get_xsa_name().size();
+  for (auto& kernel : xclbin.get_kernels())
+    count += kernel.get_name().size() + kernel.get_cus().size();
+  count += xclbin.get_ips().size();
+  return count;
+}
+
+int _main(int argc, char* argv[])
+{
+  if (argc < 3 || argv[1] != std::string("-k")) {
+    usage();
+    return 1;
+  }
+
+  std::string xclbin_fn = argv[2];
+  unsigned int iterations = 100;
+  if (argc == 5 && argv[3] == std::string("-n"))
+    iterations = std::stoi(argv[4]);
+
+  // First construction includes reading meta data pages from disk
+  auto start = clock_type::now();
+  auto count = load_meta_data(xclbin_fn);
+  auto first_us = elapsed_us(start);
+
+  start = clock_type::now();
+  size_t bytes = 0;
+  for (unsigned int i = 0; i < iterations; ++i)
+    bytes = read_file(xclbin_fn);
+  auto read_us = elapsed_us(start) / iterations;
+
+  start = clock_type::now();
+  for (unsigned int i = 0; i < iterations; ++i)
+    count += load_meta_data(xclbin_fn);
+  auto meta_us = elapsed_us(start) / iterations;
+
+  // Copies of an xclbin share the file image
+  start = clock_type::now();
+  xrt::xclbin xclbin{xclbin_fn};
+  std::vector<xrt::xclbin> copies(iterations, xclbin);
+  for (auto& copy : copies)
+    count += copy.get_kernels().size();
+  auto copy_us = elapsed_us(start) / iterations;
+
+  std::cout << "xclbin size: " << bytes << " bytes\n"
+            << "first xclbin with meta data: " << first_us << " us\n"
+            << "read complete file: " << read_us << " us\n"
+            << "xclbin with meta data: " << meta_us << " us\n"
+            << "xclbin copy with meta data: " << copy_us << " us\n"
+            << "(" << count << ")\n";
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    return _main(argc, argv);
+  }
+  catch (const std::exception& ex) {
+    std::cout << "TEST FAILED: " << ex.what() << std::endl;
+  }
+  catch (...) {
+    std::cout << "TEST FAILED" << std::endl;
+  }
+
+  return 1;
+}